@@ -0,0 +1,274 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "AccumulationTable.hpp"
+#include "ProcessManager.hpp"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    // the number of slots in each staging buffer is 2^numStagingBits; the buffer is flushed when it is half full
+    // so that the open-addressing probe sequences remain short
+    const int numStagingBits = 12;
+    const size_t numStagingSlots = size_t(1) << numStagingBits;
+    const size_t maxStagedItems = numStagingSlots / 2;
+
+    // the index value marking an empty slot in a staging buffer
+    const size_t emptySlot = SIZE_MAX;
+
+    // the source of the unique identifiers for the staging state of each table
+    std::atomic<uint64_t> nextStagingId{1};
+
+    // the maximum number of single precision values converted to double precision at a time for communication
+    const size_t maxBufferSize = 1 << 24;
+
+    // communicates the specified single precision values in chunks using the specified communication function,
+    // which receives a double precision array and a flag indicating whether this is the last chunk
+    template<class F> void communicate(vector<float>& values, F sum)
+    {
+        size_t numValues = values.size();
+        Array buffer(min(numValues, maxBufferSize));
+        for (size_t first = 0; first < numValues; first += maxBufferSize)
+        {
+            size_t num = min(maxBufferSize, numValues - first);
+            if (num != buffer.size()) buffer.resize(num);
+            for (size_t i = 0; i != num; ++i) buffer[i] = values[first + i];
+            sum(buffer, first + num == numValues);
+            for (size_t i = 0; i != num; ++i) values[first + i] = buffer[i];
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+// a staging buffer holds the double precision sums of the contributions to a limited number of table items
+// by a single thread, using an open-addressing hash table with linear probing
+class AccumulationTable::StagingBuffer
+{
+public:
+    StagingBuffer(uint64_t seed) : _indices(numStagingSlots, emptySlot), _values(numStagingSlots), _state(seed) {}
+
+    // adds the value to the staged sum for the item with the specified index and returns true,
+    // or returns false if the buffer is full and the item is not yet in the buffer
+    bool add(size_t index, double value)
+    {
+        size_t slot = (index * 0x9E3779B97F4A7C15ULL) >> (64 - numStagingBits);
+        while (true)
+        {
+            if (_indices[slot] == index)
+            {
+                _values[slot] += value;
+                return true;
+            }
+            if (_indices[slot] == emptySlot)
+            {
+                if (_numItems == maxStagedItems) return false;
+                _indices[slot] = index;
+                _values[slot] = value;
+                _numItems++;
+                return true;
+            }
+            slot = (slot + 1) & (numStagingSlots - 1);
+        }
+    }
+
+    // adds the staged sums to the specified single precision values and empties the buffer
+    void flush(vector<float>& floats)
+    {
+        if (!_numItems) return;
+        for (size_t slot = 0; slot != numStagingSlots; ++slot)
+        {
+            if (_indices[slot] != emptySlot)
+            {
+                LockFree::add(floats[_indices[slot]], _values[slot], uniform());
+                _indices[slot] = emptySlot;
+            }
+        }
+        _numItems = 0;
+    }
+
+    // empties the buffer, discarding the staged sums
+    void clear()
+    {
+        std::fill(_indices.begin(), _indices.end(), emptySlot);
+        _numItems = 0;
+    }
+
+private:
+    // returns a uniform deviate in the range [0,1) using a xorshift* generator
+    double uniform()
+    {
+        _state ^= _state >> 12;
+        _state ^= _state << 25;
+        _state ^= _state >> 27;
+        return ((_state * 0x2545F4914F6CDD1DULL) >> 11) * 0x1.0p-53;
+    }
+
+    vector<size_t> _indices;  // the table index for each slot, or emptySlot
+    vector<double> _values;   // the staged sum for each slot
+    size_t _numItems{0};      // the number of nonempty slots
+    uint64_t _state;          // the state of the random generator used for stochastic rounding
+};
+
+////////////////////////////////////////////////////////////////////
+
+// the staging state of a table holds a unique identifier and the staging buffers for all threads
+class AccumulationTable::Staging
+{
+public:
+    uint64_t id{nextStagingId++};
+    std::mutex mutex;
+    vector<std::unique_ptr<StagingBuffer>> buffers;
+};
+
+////////////////////////////////////////////////////////////////////
+
+AccumulationTable::AccumulationTable() : _staging(new Staging) {}
+
+////////////////////////////////////////////////////////////////////
+
+AccumulationTable::AccumulationTable(const AccumulationTable& other)
+    : _numRows(other._numRows), _numColumns(other._numColumns), _singlePrecision(other._singlePrecision),
+      _scale(other._scale), _inverseScale(other._inverseScale), _doubles(other._doubles), _floats(other._floats),
+      _staging(new Staging)
+{}
+
+////////////////////////////////////////////////////////////////////
+
+AccumulationTable& AccumulationTable::operator=(const AccumulationTable& other)
+{
+    if (this != &other)
+    {
+        _numRows = other._numRows;
+        _numColumns = other._numColumns;
+        _singlePrecision = other._singlePrecision;
+        _scale = other._scale;
+        _inverseScale = other._inverseScale;
+        _doubles = other._doubles;
+        _floats = other._floats;
+        _staging.reset(new Staging);
+    }
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////
+
+AccumulationTable::~AccumulationTable() {}
+
+////////////////////////////////////////////////////////////////////
+
+void AccumulationTable::resize(size_t numRows, size_t numColumns, bool singlePrecision, double scale)
+{
+    _numRows = numRows;
+    _numColumns = numColumns;
+    _singlePrecision = singlePrecision;
+    _scale = singlePrecision && scale > 0. ? scale : 1.;
+    _inverseScale = 1. / _scale;
+    _staging.reset(new Staging);
+    if (_singlePrecision)
+    {
+        _doubles.resize(0);
+        _floats.assign(size(), 0.f);
+    }
+    else
+    {
+        _floats.clear();
+        _floats.shrink_to_fit();
+        _doubles.resize(size());
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+void AccumulationTable::setToZero()
+{
+    if (_singlePrecision)
+    {
+        std::fill(_floats.begin(), _floats.end(), 0.f);
+        for (auto& buffer : _staging->buffers) buffer->clear();
+    }
+    else
+        std::fill(begin(_doubles), end(_doubles), 0.);
+}
+
+////////////////////////////////////////////////////////////////////
+
+double AccumulationTable::max() const
+{
+    if (!size()) return 0.;
+    if (_singlePrecision) return *std::max_element(_floats.begin(), _floats.end()) * _inverseScale;
+    return _doubles.max();
+}
+
+////////////////////////////////////////////////////////////////////
+
+void AccumulationTable::stage(size_t index, double value)
+{
+    // find the staging buffer for the calling thread, creating it if needed;
+    // the buffers are looked up by the unique identifier of the staging state, which is never reused
+    thread_local std::unordered_map<uint64_t, StagingBuffer*> threadBuffers;
+    thread_local uint64_t lastId = 0;
+    thread_local StagingBuffer* lastBuffer = nullptr;
+    if (lastId != _staging->id)
+    {
+        StagingBuffer*& buffer = threadBuffers[_staging->id];
+        if (!buffer)
+        {
+            std::unique_lock<std::mutex> lock(_staging->mutex);
+            _staging->buffers.emplace_back(new StagingBuffer(_staging->buffers.size() + 1));
+            buffer = _staging->buffers.back().get();
+        }
+        lastId = _staging->id;
+        lastBuffer = buffer;
+    }
+
+    // add the value to the buffer, flushing the buffer first if it is full
+    if (!lastBuffer->add(index, value))
+    {
+        lastBuffer->flush(_floats);
+        lastBuffer->add(index, value);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+void AccumulationTable::flush()
+{
+    for (auto& buffer : _staging->buffers) buffer->flush(_floats);
+}
+
+////////////////////////////////////////////////////////////////////
+
+void AccumulationTable::sumToAll()
+{
+    if (_singlePrecision)
+    {
+        flush();
+        if (ProcessManager::isMultiProc())
+            communicate(_floats, [](Array& buffer, bool /*last*/) { ProcessManager::sumToAll(buffer); });
+    }
+    else
+        ProcessManager::sumToAll(_doubles);
+}
+
+////////////////////////////////////////////////////////////////////
+
+void AccumulationTable::sumToRoot(bool wait)
+{
+    if (_singlePrecision)
+    {
+        flush();
+        if (ProcessManager::isMultiProc())
+            communicate(_floats, [wait](Array& buffer, bool last) { ProcessManager::sumToRoot(buffer, wait && last); });
+    }
+    else
+        ProcessManager::sumToRoot(_doubles, wait);
+}
+
+////////////////////////////////////////////////////////////////////
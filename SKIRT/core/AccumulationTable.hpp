@@ -0,0 +1,179 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#ifndef ACCUMULATIONTABLE_HPP
+#define ACCUMULATIONTABLE_HPP
+
+#include "Array.hpp"
+#include "LockFree.hpp"
+
+////////////////////////////////////////////////////////////////////
+
+/** An instance of the AccumulationTable class holds a two-dimensional table of floating point
+    values that are accumulated concurrently by multiple execution threads, such as the radiation
+    field in each spatial cell or the surface brightness in each pixel of an instrument data cube.
+    Values with adjacent column indices are stored next to each other, so that the flattened index
+    of the item at row \f$i\f$ and column \f$j\f$ is \f$i\,N_\mathrm{cols}+j\f$.
+
+    Depending on a flag passed to the resize() function, the values are stored in double precision
+    (8 bytes per value) or in single precision (4 bytes per value). Single precision storage halves
+    the memory requirements for very large tables at the cost of some accuracy.
+
+    Simply rounding each new sum to single precision would cause contributions to stagnate: once
+    the stored value exceeds about \f$2^{24}\f$ times a contribution, the contribution would be
+    lost entirely, leading to a systematic underestimate. Therefore, in single precision mode,
+    each execution thread first accumulates its contributions in a private double precision
+    staging buffer that holds a limited number of table items. When the buffer is full, and when
+    the values are communicated between processes, the staged sums are flushed into the table.
+    Each flush adds the staged sum in double precision and rounds the result stochastically to one
+    of the two nearest single precision values (see the LockFree namespace). The expected value of
+    the stored sum thus equals the exact sum, and the standard deviation of the round-off error on
+    an item after \f$n\f$ flushes into that item is at most of the order of \f$\sqrt{n}\times
+    6\times 10^{-8}\f$ times its value. Because the staging buffer combines contributions to the
+    same item, \f$n\f$ is usually much smaller than the number of contributions.
+
+    The range of single precision values is limited to about \f$10^{\pm38}\f$.
+    Because the accumulated quantities are usually expressed in SI units, they can easily exceed
+    this range. Therefore, when storing values in single precision, the table multiplies all
+    values by a scale factor specified by the client before storing them, and divides them by the
+    same factor when retrieving them. The client should select this factor so that the scaled
+    values are of order unity or smaller.
+
+    The staged contributions are not included in the values retrieved from the table until they
+    are flushed. Clients should therefore call sumToAll() or sumToRoot() after accumulation has
+    completed and before retrieving the values, even in a single-process environment.
+
+    Regardless of the storage precision, the values are retrieved as double precision values, and
+    the communication between processes in a multi-processing environment is performed in double
+    precision. */
+class AccumulationTable
+{
+    // ================== Constructing ==================
+
+public:
+    /** The default constructor constructs an empty table. */
+    AccumulationTable();
+
+    /** The copy constructor copies the values in the specified table. Any contributions staged in
+        the other table are not copied. */
+    AccumulationTable(const AccumulationTable& other);
+
+    /** The copy assignment operator copies the values in the specified table. Any contributions
+        staged in this table are discarded, and any contributions staged in the other table are not
+        copied. */
+    AccumulationTable& operator=(const AccumulationTable& other);
+
+    /** The destructor releases the staging buffers, if any. */
+    ~AccumulationTable();
+
+    /** This function resizes the table so that it holds the specified number of rows and columns,
+        stored in single precision if the \em singlePrecision flag is true and in double precision
+        otherwise. For single precision storage, the \em scale argument specifies the factor by
+        which values are multiplied before they are stored; it is ignored for double precision
+        storage. All values are set to zero, i.e. any values that were previously in the table are
+        lost. */
+    void resize(size_t numRows, size_t numColumns, bool singlePrecision = false, double scale = 1.);
+
+    /** This function sets all values in the table to zero, without changing the number of items.
+        Any staged contributions are discarded. */
+    void setToZero();
+
+    // ================== Accessing sizes and values ==================
+
+public:
+    /** This function returns the total number of items in the table. */
+    size_t size() const { return _numRows * _numColumns; }
+
+    /** This function returns the number of items in the dimension indicated by the specified
+        zero-based index. */
+    size_t size(size_t dim) const { return dim ? _numColumns : _numRows; }
+
+    /** This function returns true if the values in the table are stored in single precision, and
+        false if they are stored in double precision. */
+    bool isSinglePrecision() const { return _singlePrecision; }
+
+    /** This function returns the number of bytes occupied by the values in the table. */
+    size_t numBytes() const { return size() * (_singlePrecision ? sizeof(float) : sizeof(double)); }
+
+    /** This function returns the value at the specified flattened index. There is no range
+        checking. Out-of-range index values cause unpredictable behavior. */
+    double operator[](size_t index) const
+    {
+        return _singlePrecision ? _floats[index] * _inverseScale : _doubles[index];
+    }
+
+    /** This function returns the value at the specified row and column indices. There is no range
+        checking. Out-of-range index values cause unpredictable behavior. */
+    double operator()(size_t i, size_t j) const { return (*this)[i * _numColumns + j]; }
+
+    /** This function returns the largest value in the table, or zero if the table is empty. */
+    double max() const;
+
+    // ================== Accumulating values ==================
+
+public:
+    /** This function adds the specified value to the item at the specified flattened index in a
+        thread-safe manner. There is no range checking. Out-of-range index values cause
+        unpredictable behavior. */
+    void add(size_t index, double value)
+    {
+        if (_singlePrecision)
+            stage(index, value * _scale);
+        else
+            LockFree::add(_doubles[index], value);
+    }
+
+    /** This function adds the specified value to the item at the specified row and column indices
+        in a thread-safe manner. There is no range checking. Out-of-range index values cause
+        unpredictable behavior. */
+    void add(size_t i, size_t j, double value) { add(i * _numColumns + j, value); }
+
+    // ================== Communicating between processes ==================
+
+public:
+    /** This function flushes any staged contributions into the table, and then adds the values in
+        the table element-wise across the different processes and stores the resulting sums in the
+        table on each process, as described for the ProcessManager::sumToAll() function. It must
+        not be called while other threads are adding values to the table. */
+    void sumToAll();
+
+    /** This function flushes any staged contributions into the table, and then adds the values in
+        the table element-wise across the different processes and stores the resulting sums in the
+        table on the root process, as described for the ProcessManager::sumToRoot() function. It
+        must not be called while other threads are adding values to the table. */
+    void sumToRoot(bool wait = false);
+
+    // ================== Private helpers ==================
+
+private:
+    /** This function adds the specified scaled value to the item at the specified flattened index
+        in the staging buffer for the calling thread, creating the buffer if needed. If the buffer
+        is full, its contents are first flushed into the table. */
+    void stage(size_t index, double value);
+
+    /** This function flushes the staging buffers of all threads into the table and empties them.
+        It must not be called while other threads are adding values to the table. */
+    void flush();
+
+    // ================== Data members ==================
+
+private:
+    size_t _numRows{0};            // the number of rows
+    size_t _numColumns{0};         // the number of columns
+    bool _singlePrecision{false};  // true if values are stored in single precision
+    double _scale{1.};             // the factor applied to values stored in single precision
+    double _inverseScale{1.};      // the inverse of the scale factor
+    Array _doubles;                // the values if stored in double precision
+    vector<float> _floats;         // the values if stored in single precision
+
+    // staging buffers for single precision accumulation, one for each thread that added values
+    class StagingBuffer;
+    class Staging;
+    std::unique_ptr<Staging> _staging;
+};
+
+////////////////////////////////////////////////////////////////////
+
+#endif
@@ -316,9 +316,9 @@ int AdaptiveMeshSnapshot::cellIndex(Position bfr) const
 
 ////////////////////////////////////////////////////////////////////
 
-const Array& AdaptiveMeshSnapshot::properties(int m) const
+double AdaptiveMeshSnapshot::property(int m, int p) const
 {
-    return _cells[m]->properties();
+    return _cells[m]->properties()[p];
 }
 
 ////////////////////////////////////////////////////////////////////
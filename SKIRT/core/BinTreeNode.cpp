@@ -50,6 +50,13 @@ void BinTreeNode::createChildren(int id)
 
 ////////////////////////////////////////////////////////////////////
 
+int BinTreeNode::numChildren() const
+{
+    return 2;
+}
+
+////////////////////////////////////////////////////////////////////
+
 TreeNode* BinTreeNode::child(Vec r)
 {
     switch (level() % 3)
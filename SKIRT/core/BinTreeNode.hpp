@@ -37,6 +37,10 @@ public:
         */
     void createChildren(int id) override;
 
+    /** This function returns the number of children created by the createChildren() function,
+        i.e. two. */
+    int numChildren() const override;
+
     /** This function returns a pointer to the node's child that contains the specified point. More
         accurately, it returns the child corresponding to the half-space that contains the
         specified point relative to the node's central division plane. If the specified point is
@@ -0,0 +1,413 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "BinaryCache.hpp"
+#include "BoolPropertyHandler.hpp"
+#include "DoubleListPropertyHandler.hpp"
+#include "DoublePropertyHandler.hpp"
+#include "EnumPropertyHandler.hpp"
+#include "FatalError.hpp"
+#include "FilePaths.hpp"
+#include "IntPropertyHandler.hpp"
+#include "ItemListPropertyHandler.hpp"
+#include "ItemPropertyHandler.hpp"
+#include "Log.hpp"
+#include "ProcessManager.hpp"
+#include "PropertyHandlerVisitor.hpp"
+#include "SchemaDef.hpp"
+#include "SimulationItemRegistry.hpp"
+#include "StringPropertyHandler.hpp"
+#include "System.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    // the alternate interpretations for 8-byte items in the cache file format
+    union CacheItem
+    {
+        double doubleType;
+        size_t sizeType;
+        char stringType[8];
+    };
+    const size_t itemSize = sizeof(CacheItem);
+
+    static_assert((sizeof(size_t) == 8) & (sizeof(double) == 8) & (itemSize == 8),
+                  "Cannot properly declare union for items in cache file format");
+
+    // the number of items in the cache file in addition to the cached values
+    const size_t numOverheadItems = 5;
+
+    // the version of the cache file format and of the key construction, included in each key;
+    // increment this number when changing the file format or the way keys are constructed
+    const int formatVersion = 2;
+
+    // the constants for the 64-bit FNV-1a hash function
+    const size_t fnvOffsetBasis = 0xcbf29ce484222325;
+    const size_t fnvPrime = 0x100000001b3;
+
+    // returns a number that is unique across threads and, with high probability, across simulations;
+    // the number is limited to 52 bits so that it can be exactly communicated between processes as a double
+    size_t uniqueId()
+    {
+        static std::atomic<size_t> lastId{0};
+        size_t time = std::chrono::system_clock::now().time_since_epoch().count();
+        return ((time << 12) + (++lastId & 0xFFF)) & 0xFFFFFFFFFFFFF;
+    }
+
+    // returns the path of a temporary file with the specified unique identifier next to the specified cache file
+    string temporaryPath(string path, size_t id) { return path + ".tmp" + std::to_string(id); }
+
+    // writes the header for a cache file with the specified fingerprint and number of values to the stream
+    void writeHeader(std::ostream& out, size_t fingerprint, size_t numValues)
+    {
+        CacheItem header[numOverheadItems - 1];
+        memcpy(header[0].stringType, "SKIRT C\n", itemSize);
+        header[1].sizeType = 0x010203040A0BFEFF;
+        header[2].sizeType = fingerprint;
+        header[3].sizeType = numValues;
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    }
+
+    // the functions in this class are part of the visitor pattern initiated by the addKey(const Item*) function;
+    // they add the value of the specified property to the key
+    class PropertyHasher : public PropertyHandlerVisitor
+    {
+    private:
+        BinaryCache* _cache;
+        const FilePaths* _paths;
+
+    public:
+        PropertyHasher(BinaryCache* cache, const FilePaths* paths) : _cache(cache), _paths(paths) {}
+
+        void visitPropertyHandler(StringPropertyHandler* handler) override
+        {
+            string value = handler->value();
+            _cache->addKey(value);
+
+            // if the string refers to an input file, add the file contents to the key
+            if (!value.empty())
+            {
+                string path = _paths->input(value);
+                if (System::isFile(path))
+                {
+                    auto map = System::acquireMemoryMap(path);
+                    if (map.first)
+                    {
+                        _cache->addKey(map.first, map.second);
+                        System::releaseMemoryMap(path);
+                    }
+                }
+            }
+        }
+
+        void visitPropertyHandler(BoolPropertyHandler* handler) override { _cache->addKey(handler->value()); }
+
+        void visitPropertyHandler(IntPropertyHandler* handler) override { _cache->addKey(handler->value()); }
+
+        void visitPropertyHandler(EnumPropertyHandler* handler) override { _cache->addKey(handler->value()); }
+
+        void visitPropertyHandler(DoublePropertyHandler* handler) override { _cache->addKey(handler->value()); }
+
+        void visitPropertyHandler(DoubleListPropertyHandler* handler) override
+        {
+            auto values = handler->value();
+            _cache->addKey(values.size());
+            for (double value : values) _cache->addKey(value);
+        }
+
+        void visitPropertyHandler(ItemPropertyHandler* handler) override
+        {
+            if (handler->value())
+                _cache->addKey(handler->value());
+            else
+                _cache->addKey(string());
+        }
+
+        void visitPropertyHandler(ItemListPropertyHandler* handler) override
+        {
+            auto items = handler->value();
+            _cache->addKey(items.size());
+            for (Item* item : items) _cache->addKey(item);
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////
+
+BinaryCache::BinaryCache(const SimulationItem* item, string kind, int version)
+    : _item(item), _kind(kind), _fingerprint(fnvOffsetBasis)
+{
+    addKey(static_cast<double>(formatVersion));
+    addKey(kind);
+    addKey(static_cast<double>(version));
+}
+
+////////////////////////////////////////////////////////////////////
+
+BinaryCache::~BinaryCache()
+{
+    if (!_mapPath.empty()) System::releaseMemoryMap(_mapPath);
+}
+
+////////////////////////////////////////////////////////////////////
+
+void BinaryCache::addKey(double value)
+{
+    addKey(&value, sizeof(value));
+}
+
+////////////////////////////////////////////////////////////////////
+
+void BinaryCache::addKey(string value)
+{
+    addKey(static_cast<double>(value.size()));
+    addKey(value.data(), value.size());
+}
+
+////////////////////////////////////////////////////////////////////
+
+void BinaryCache::addKey(const Item* item)
+{
+    // add the item type
+    Item* nonConstItem = const_cast<Item*>(item);
+    addKey(item->type());
+
+    // add the item's properties by distributing them to hash functions depending on property type (visitor pattern)
+    auto schema = SimulationItemRegistry::getSchemaDef();
+    PropertyHasher hasher(this, _item->find<FilePaths>());
+    for (const string& property : schema->properties(item->type()))
+    {
+        auto handler = schema->createPropertyHandler(nonConstItem, property, nullptr);
+        handler->acceptVisitor(&hasher);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+void BinaryCache::addKey(const void* data, size_t numBytes)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i != numBytes; ++i)
+    {
+        _fingerprint ^= bytes[i];
+        _fingerprint *= fnvPrime;
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+bool BinaryCache::load(size_t numValues)
+{
+    // release any previously established map
+    release();
+
+    // acquire a memory map for the file, if it exists, and verify the name tag, the Endianness tag,
+    // the fingerprint, and the number of values
+    string path = filePath();
+    bool loaded = false;
+    if (System::isFile(path))
+    {
+        auto map = System::acquireMemoryMap(path);
+        if (map.first)
+        {
+            _mapPath = path;
+            const CacheItem* currentItem = static_cast<const CacheItem*>(map.first);
+            size_t numItems = map.second / itemSize;
+            if (numItems < numOverheadItems || memcmp("SKIRT C\n", currentItem[0].stringType, itemSize)
+                || currentItem[1].sizeType != 0x010203040A0BFEFF || currentItem[2].sizeType != _fingerprint
+                || currentItem[3].sizeType != numItems - numOverheadItems
+                || memcmp("SCACEND\n", currentItem[numItems - 1].stringType, itemSize))
+            {
+                _item->find<Log>()->warning("Ignoring cache file with improper format: " + path);
+            }
+            else if (numValues && currentItem[3].sizeType != numValues)
+            {
+                _item->find<Log>()->warning("Ignoring cache file with unexpected number of values: " + path);
+            }
+            else
+            {
+                _data = &currentItem[4].doubleType;
+                _size = currentItem[3].sizeType;
+                loaded = true;
+            }
+        }
+    }
+
+    // agree on the result between all processes, so that the caller can safely perform collective operations
+    // when the cache file is not available
+    if (ProcessManager::isMultiProc())
+    {
+        Array flags(loaded ? 1. : 0., 1);
+        ProcessManager::sumToAll(flags);
+        loaded = flags[0] == ProcessManager::size();
+    }
+
+    // expose the cached values, or release the memory map
+    if (loaded)
+        _item->find<Log>()->info("Loaded cached " + _kind + " data from file " + path);
+    else
+        release();
+    return loaded;
+}
+
+////////////////////////////////////////////////////////////////////
+
+void BinaryCache::release()
+{
+    if (!_mapPath.empty()) System::releaseMemoryMap(_mapPath);
+    _mapPath.clear();
+    _data = nullptr;
+    _size = 0;
+}
+
+////////////////////////////////////////////////////////////////////
+
+void BinaryCache::store(const vector<double>& values) const
+{
+    store(values.data(), values.size());
+}
+
+////////////////////////////////////////////////////////////////////
+
+void BinaryCache::store(const double* values, size_t numValues) const
+{
+    if (!ProcessManager::isRoot()) return;
+
+    // open a temporary file in the same directory
+    string tempPath = temporaryPath(filePath(), uniqueId());
+    std::ofstream out = System::ofstream(tempPath, false, true);
+    if (!out) throw FATALERROR("Could not open the cache file " + tempPath);
+
+    // write the header, the values, and the end-of-file tag
+    writeHeader(out, _fingerprint, numValues);
+    out.write(reinterpret_cast<const char*>(values), numValues * sizeof(double));
+    out.write("SCACEND\n", itemSize);
+    out.close();
+    if (!out)
+    {
+        System::removeFile(tempPath);
+        throw FATALERROR("Could not write the cache file " + tempPath);
+    }
+
+    replaceFile(tempPath);
+}
+
+////////////////////////////////////////////////////////////////////
+
+void BinaryCache::beginStore(size_t numValues)
+{
+    // agree on a temporary file name in the same directory
+    Array idv(0., 1);
+    if (ProcessManager::isRoot()) idv[0] = static_cast<double>(uniqueId());
+    ProcessManager::sumToAll(idv);
+    _storePath = temporaryPath(filePath(), static_cast<size_t>(idv[0]));
+    _storeSize = numValues;
+
+    // let the root process create the file with the header and the end-of-file tag at the proper position
+    if (ProcessManager::isRoot())
+    {
+        std::ofstream out = System::ofstream(_storePath, false, true);
+        if (!out) throw FATALERROR("Could not open the cache file " + _storePath);
+        writeHeader(out, _fingerprint, numValues);
+        out.seekp((numOverheadItems - 1 + numValues) * itemSize);
+        out.write("SCACEND\n", itemSize);
+        out.close();
+        if (!out)
+        {
+            System::removeFile(_storePath);
+            throw FATALERROR("Could not write the cache file " + _storePath);
+        }
+    }
+    ProcessManager::wait();
+
+    // open the file for writing in all processes
+    _storeFile = std::make_unique<std::fstream>(System::fstream(_storePath));
+    if (!*_storeFile) throw FATALERROR("Could not open the cache file " + _storePath);
+}
+
+////////////////////////////////////////////////////////////////////
+
+void BinaryCache::storeSlice(size_t index, const double* values, size_t numValues)
+{
+    if (!_storeFile) throw FATALERROR("Storing cache slice without calling beginStore()");
+    if (index + numValues > _storeSize) throw FATALERROR("Cache slice is out of range");
+
+    std::unique_lock<std::mutex> lock(_storeMutex);
+    _storeFile->seekp((numOverheadItems - 1 + index) * itemSize);
+    _storeFile->write(reinterpret_cast<const char*>(values), numValues * sizeof(double));
+}
+
+////////////////////////////////////////////////////////////////////
+
+bool BinaryCache::endStore(bool complete)
+{
+    // close the file in all processes and agree on the result
+    if (_storeFile)
+    {
+        _storeFile->close();
+        if (!*_storeFile) complete = false;
+        _storeFile.reset();
+    }
+    if (ProcessManager::isMultiProc())
+    {
+        Array flags(complete ? 1. : 0., 1);
+        ProcessManager::sumToAll(flags);
+        complete = flags[0] == ProcessManager::size();
+    }
+
+    // let the root process rename or remove the file, and wait until it is done
+    if (ProcessManager::isRoot())
+    {
+        if (complete)
+            complete = replaceFile(_storePath);
+        else
+            System::removeFile(_storePath);
+    }
+    if (ProcessManager::isMultiProc())
+    {
+        Array flags(complete && ProcessManager::isRoot() ? 1. : 0., 1);
+        ProcessManager::sumToAll(flags);
+        complete = flags[0] > 0.;
+    }
+    _storePath.clear();
+    _storeSize = 0;
+    return complete;
+}
+
+////////////////////////////////////////////////////////////////////
+
+string BinaryCache::filePath() const
+{
+    const char* digits = "0123456789abcdef";
+    string hex(16, '0');
+    for (int i = 0; i != 16; ++i) hex[15 - i] = digits[(_fingerprint >> (4 * i)) & 15];
+    return _item->find<FilePaths>()->outputPath() + "cache_" + _kind + "_" + hex + ".dat";
+}
+
+////////////////////////////////////////////////////////////////////
+
+bool BinaryCache::replaceFile(string tempPath) const
+{
+    // atomically replace any existing cache file by the new file; if this fails (e.g. because another
+    // simulation has the existing file mapped into memory on a platform that does not allow replacing it),
+    // simply keep the existing file
+    string path = filePath();
+    if (!System::renameFile(tempPath, path))
+    {
+        System::removeFile(tempPath);
+        _item->find<Log>()->warning("Could not replace the cache file " + path);
+        return false;
+    }
+
+    _item->find<Log>()->info("Stored " + _kind + " data in cache file " + path);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////
@@ -0,0 +1,202 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#ifndef BINARYCACHE_HPP
+#define BINARYCACHE_HPP
+
+#include "Basics.hpp"
+#include <iosfwd>
+#include <mutex>
+class Item;
+class SimulationItem;
+
+////////////////////////////////////////////////////////////////////
+
+/** An instance of the BinaryCache class allows storing the result of a costly calculation, such
+    as the construction of a spatial grid, in a binary file so that a subsequent simulation can
+    load the result instead of repeating the calculation. The cache file is identified by a
+    fingerprint, i.e. a 64-bit hash calculated from all information on which the result depends
+    (the key). If any of this information changes, the fingerprint changes as well and the cached
+    result is no longer used.
+
+    Usage
+    -----
+
+    The client constructs a BinaryCache instance, passing a simulation item that provides context
+    (such as the output path and the logger), a short string identifying the kind of data being
+    cached, and optionally a version number for the layout of the serialized data. The kind, the
+    version number and the version of the cache file format are always included in the key, so
+    that a client changing the layout of its serialized data simply increments its version number
+    to avoid loading incompatible cache files. The client then adds all relevant information to
+    the key by calling one or more of the addKey() functions, and calls the load() function. If
+    this function returns true, the cached data is available through the data() and size()
+    functions. Otherwise the client performs the calculation as usual and passes the serialized
+    result to the store() function.
+
+    If the result is too large to be held in memory as a whole, the client can instead write the
+    cache file slice by slice. It calls the beginStore() function to create a file of the proper
+    size, passes each slice of the result to the storeSlice() function, and finally calls the
+    endStore() function to make the file available under its final name. The client can then call
+    load() to access the complete result through a memory map.
+
+    In a multi-processing environment, the load() function must be called by all processes, and
+    the processes agree on its result. This allows the client to perform the calculation
+    collectively (i.e. using inter-process communication) when the cache file is not available,
+    even if the file is visible to some processes but not to others, e.g. because of delays in
+    a shared file system. Similarly, the beginStore() and endStore() functions must be called by
+    all processes, while each process calls storeSlice() only for the slices it calculated
+    itself. This assumes that all processes have access to the same output directory.
+
+    The cache file is placed in the output directory of the simulation, with a filename composed
+    of the fixed string "cache_", the kind of data, and the fingerprint in hexadecimal notation.
+    The output prefix of the simulation is not included in the filename so that subsequent
+    simulations with a different prefix can reuse the cache. Loaded cache files are accessed
+    through a memory map, so the data is not copied into memory before it is used. A new cache
+    file is first written under a temporary name and then renamed to its final name, so that
+    concurrent simulations accessing the same output directory never see a partially written file,
+    and simulations that have mapped a previous version of the file into memory keep accessing
+    that previous version.
+
+    Cache file format
+    -----------------
+
+    A cache file is a sequence of 8-byte data items, using the same conventions as the SKIRT
+    stored columns format (see the StoredColumns class). The layout is as follows:
+        - SKIRT cache tag "SKIRT C\n"
+        - Endianness tag
+        - fingerprint
+        - number of values N
+        - value (x N)
+        - end-of-file tag "SCACEND\n"
+
+    The interpretation of the values is entirely left to the client. Integer quantities are
+    stored as floating point values, which is exact for all integers up to \f$2^{53}\f$. */
+class BinaryCache
+{
+    // ================== Constructing ==================
+
+public:
+    /** The constructor creates a cache instance for the specified kind of data with a key
+        containing just the kind of data and the version numbers. The \em item argument specifies
+        a simulation item in the hierarchy of the caller (usually the caller itself) used to
+        retrieve context such as the output path and an appropriate logger. The \em kind argument
+        is a short string without white space identifying the kind of data being cached. The \em
+        version argument specifies the version of the layout of the serialized data; the client
+        should increment this number whenever it changes this layout. */
+    BinaryCache(const SimulationItem* item, string kind, int version = 1);
+
+    /** The destructor releases the memory map established by the load() function, if any. */
+    ~BinaryCache();
+
+    /** The copy constructor is deleted because instances of this class should never be copied. */
+    BinaryCache(const BinaryCache&) = delete;
+
+    /** The assignment operator is deleted because instances of this class should never be
+        assigned to. */
+    BinaryCache& operator=(const BinaryCache&) = delete;
+
+    // ================== Building the key ==================
+
+public:
+    /** This function adds the specified floating point value to the key. */
+    void addKey(double value);
+
+    /** This function adds the specified string to the key. */
+    void addKey(string value);
+
+    /** This function adds the configuration of the specified simulation item and all of its
+        children to the key. This includes the item types and the values of all properties. In
+        addition, if the value of a string property corresponds to the name of an existing input
+        file, the contents of that file is added to the key as well. */
+    void addKey(const Item* item);
+
+    /** This function adds the specified sequence of bytes to the key. */
+    void addKey(const void* data, size_t numBytes);
+
+    // ================== Loading and storing ==================
+
+public:
+    /** This function attempts to load the cache file corresponding to the current key. If the
+        file exists and has the proper format, and if \em numValues is zero or equal to the number
+        of values in the file, the function returns true and the cached values become available
+        through the data() and size() functions. Otherwise, the function returns false.
+
+        In a multi-processing environment, this function must be called by all processes, and it
+        returns true only if all processes successfully loaded the cache file. */
+    bool load(size_t numValues = 0);
+
+    /** This function returns a pointer to the first cached value, or the null pointer if no cache
+        file has been loaded. The pointer remains valid as long as this cache instance exists. */
+    const double* data() const { return _data; }
+
+    /** This function returns the number of cached values, or zero if no cache file has been
+        loaded. */
+    size_t size() const { return _size; }
+
+    /** This function stores the specified values in the cache file corresponding to the current
+        key, overwriting any existing file with the same name. In a multi-processing environment,
+        only the root process writes the file; it is assumed that all processes pass the same
+        values. */
+    void store(const vector<double>& values) const;
+
+    /** This function stores the specified number of values starting at the specified address in
+        the cache file corresponding to the current key. It is otherwise identical to the store()
+        function taking a vector argument. */
+    void store(const double* values, size_t numValues) const;
+
+    /** This function starts writing a cache file for the current key containing the specified
+        number of values, which are then provided through one or more calls to the storeSlice()
+        function. The root process creates the file under a temporary name with the proper size and
+        header information, and all processes then open the file for writing. In a
+        multi-processing environment, this function must be called by all processes. */
+    void beginStore(size_t numValues);
+
+    /** This function writes the specified number of values starting at the specified address to
+        the cache file started by the beginStore() function, starting at the value with the
+        specified index. Each value of the file should be written exactly once, by any process. This
+        function can be called concurrently from multiple threads. */
+    void storeSlice(size_t index, const double* values, size_t numValues);
+
+    /** This function completes the cache file started by the beginStore() function. If the \em
+        complete flag is true for all processes and all values have been written without error,
+        the file is renamed to its final name and the function returns true. Otherwise the
+        temporary file is removed and the function returns false. In a multi-processing
+        environment, this function must be called by all processes, and it returns only after the
+        file has been renamed or removed. */
+    bool endStore(bool complete);
+
+private:
+    /** This function releases the memory map established by the load() function, if any, and
+        clears the information on the cached values. */
+    void release();
+
+    /** This function returns the path of the cache file corresponding to the current key. */
+    string filePath() const;
+
+    /** This function atomically replaces any existing cache file for the current key by the
+        temporary file at the specified path, and logs the result. It returns false if the file
+        could not be replaced, in which case the temporary file is removed. */
+    bool replaceFile(string tempPath) const;
+
+    // ================== Data members ==================
+
+private:
+    const SimulationItem* _item;   // the simulation item providing context
+    string _kind;                  // the kind of data being cached
+    size_t _fingerprint{0};        // the hash of the key information added so far
+    string _mapPath;               // the path of the memory-mapped cache file, or empty
+    const double* _data{nullptr};  // pointer to the first cached value
+    size_t _size{0};               // the number of cached values
+
+    // data members used while a cache file is being written slice by slice
+    string _storePath;                         // the path of the temporary file being written, or empty
+    size_t _storeSize{0};                      // the number of values in the file being written
+    std::unique_ptr<std::fstream> _storeFile;  // the stream for writing to the temporary file
+    std::mutex _storeMutex;                    // the mutex serializing access to the stream
+};
+
+////////////////////////////////////////////////////////////////////
+
+#endif
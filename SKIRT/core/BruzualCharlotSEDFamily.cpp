@@ -57,6 +57,18 @@ double BruzualCharlotSEDFamily::specificLuminosity(double wavelength, const Arra
 
 ////////////////////////////////////////////////////////////////////
 
+void BruzualCharlotSEDFamily::specificLuminosities(Array& Lv, const Array& lambdav, const Array& parameters) const
+{
+    double M = parameters[0] / Constants::Msun();
+    double Z = parameters[1];
+    double t = parameters[2] / Constants::year();
+
+    _table.valueArray(Lv, lambdav, Z, t);
+    Lv *= M;
+}
+
+////////////////////////////////////////////////////////////////////
+
 double BruzualCharlotSEDFamily::cdf(Array& lambdav, Array& pv, Array& Pv, const Range& wavelengthRange,
                                     const Array& parameters) const
 {
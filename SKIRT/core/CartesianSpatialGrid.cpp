@@ -11,6 +11,36 @@
 
 //////////////////////////////////////////////////////////////////////
 
+namespace
+{
+    // returns the index of the bin containing the given coordinate, with the same semantics as NR::locateClip(),
+    // using the analytic inverse of the mesh if it is available and performing a binary search otherwise
+    int locateClip(const Mesh* mesh, const Array& xv, double x)
+    {
+        int n = xv.size() - 1;
+        double s = mesh->inverseMesh(max(0., min(1., (x - xv[0]) / (xv[n] - xv[0]))));
+        if (!(s >= 0.)) return NR::locateClip(xv, x);
+
+        // correct for any rounding errors by verifying against the actual mesh points
+        int i = min(static_cast<int>(s), n - 1);
+        while (i > 0 && x < xv[i]) --i;
+        while (i < n - 1 && x >= xv[i + 1]) ++i;
+        return i;
+    }
+
+    // returns true if the given mesh points are equally spaced within a small relative tolerance
+    bool isUniform(const Array& xv)
+    {
+        int n = xv.size() - 1;
+        double dx = (xv[n] - xv[0]) / n;
+        for (int i = 0; i != n; ++i)
+            if (fabs(xv[i + 1] - xv[i] - dx) > 1e-10 * dx) return false;
+        return true;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+
 void CartesianSpatialGrid::setupSelfAfter()
 {
     BoxSpatialGrid::setupSelfAfter();
@@ -22,6 +52,9 @@ void CartesianSpatialGrid::setupSelfAfter()
     _xv = _meshX->mesh() * (xmax() - xmin()) + xmin();
     _yv = _meshY->mesh() * (ymax() - ymin()) + ymin();
     _zv = _meshZ->mesh() * (zmax() - zmin()) + zmin();
+
+    // determine whether we can use the path segment generator for uniform grids
+    _uniform = isUniform(_xv) && isUniform(_yv) && isUniform(_zv);
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -49,13 +82,13 @@ double CartesianSpatialGrid::diagonal(int m) const
 
 int CartesianSpatialGrid::cellIndex(Position bfr) const
 {
-    int i = NR::locateFail(_xv, bfr.x());
-    int j = NR::locateFail(_yv, bfr.y());
-    int k = NR::locateFail(_zv, bfr.z());
-    if (i < 0 || j < 0 || k < 0)
-        return -1;
-    else
-        return index(i, j, k);
+    double x, y, z;
+    bfr.cartesian(x, y, z);
+    if (x < _xv[0] || x > _xv[_Nx] || y < _yv[0] || y > _yv[_Ny] || z < _zv[0] || z > _zv[_Nz]) return -1;
+
+    int i, j, k;
+    binIndices(x, y, z, i, j, k);
+    return index(i, j, k);
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -92,9 +125,7 @@ public:
                 if (!moveInside(_grid->extent(), 1e-12 * _grid->extent().diagonal())) return false;
 
                 // determine which grid cell we are in
-                _i = NR::locateClip(_grid->_xv, rx());
-                _j = NR::locateClip(_grid->_yv, ry());
-                _k = NR::locateClip(_grid->_zv, rz());
+                _grid->binIndices(rx(), ry(), rz(), _i, _j, _k);
 
                 // if the photon packet started outside the grid, return the corresponding nonzero-length segment;
                 // otherwise fall through to determine the first actual segment
@@ -154,13 +185,121 @@ public:
 
 //////////////////////////////////////////////////////////////////////
 
+class CartesianSpatialGrid::MyUniformSegmentGenerator : public PathSegmentGenerator
+{
+    const CartesianSpatialGrid* _grid{nullptr};
+    int _i{-1}, _j{-1}, _k{-1};           // indices of the current cell
+    int _di{0}, _dj{0}, _dk{0};           // index increments when crossing a cell wall in each direction
+    double _t{0.};                        // path length from the grid entry point to the current position
+    double _tx{0.}, _ty{0.}, _tz{0.};     // path length from the grid entry point to the next wall in each direction
+    double _dtx{0.}, _dty{0.}, _dtz{0.};  // path length between consecutive walls in each direction
+
+    // initializes the DDA traversal variables for a single direction
+    static void initAxis(const Array& xv, int i, double r, double k, int& di, double& t, double& dt)
+    {
+        if (fabs(k) > 1e-15)
+        {
+            di = (k < 0.0) ? -1 : 1;
+            t = ((k < 0.0 ? xv[i] : xv[i + 1]) - r) / k;
+            dt = (xv[1] - xv[0]) / fabs(k);
+        }
+        else
+        {
+            di = 0;
+            t = DBL_MAX;
+            dt = 0.;
+        }
+    }
+
+public:
+    MyUniformSegmentGenerator(const CartesianSpatialGrid* grid) : _grid(grid) {}
+
+    bool next() override
+    {
+        switch (state())
+        {
+            case State::Unknown:
+            {
+                // try moving the photon packet inside the grid; if this is impossible, return an empty path
+                if (!moveInside(_grid->extent(), 1e-12 * _grid->extent().diagonal())) return false;
+
+                // determine which grid cell we are in and initialize the traversal variables
+                _grid->binIndices(rx(), ry(), rz(), _i, _j, _k);
+                initAxis(_grid->_xv, _i, rx(), kx(), _di, _tx, _dtx);
+                initAxis(_grid->_yv, _j, ry(), ky(), _dj, _ty, _dty);
+                initAxis(_grid->_zv, _k, rz(), kz(), _dk, _tz, _dtz);
+                _t = 0.;
+
+                // if the photon packet started outside the grid, return the corresponding nonzero-length segment;
+                // otherwise fall through to determine the first actual segment
+                if (ds() > 0.) return true;
+            }
+
+            // intentionally falls through
+            case State::Inside:
+            {
+                // determine the segment from the current position to the first cell wall
+                // and advance the traversal variables accordingly
+                int m = _grid->index(_i, _j, _k);
+                if (_tx <= _ty && _tx <= _tz)
+                {
+                    setSegment(m, _tx - _t);
+                    _t = _tx;
+                    _tx += _dtx;
+                    _i += _di;
+                    if (_i >= _grid->_Nx || _i < 0) setState(State::Outside);
+                }
+                else if (_ty < _tx && _ty <= _tz)
+                {
+                    setSegment(m, _ty - _t);
+                    _t = _ty;
+                    _ty += _dty;
+                    _j += _dj;
+                    if (_j >= _grid->_Ny || _j < 0) setState(State::Outside);
+                }
+                else  // if (_tz < _tx && _tz < _ty)
+                {
+                    setSegment(m, _tz - _t);
+                    _t = _tz;
+                    _tz += _dtz;
+                    _k += _dk;
+                    if (_k >= _grid->_Nz || _k < 0) setState(State::Outside);
+                }
+                return true;
+            }
+
+            case State::Outside:
+            {
+            }
+        }
+        return false;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////
+
 std::unique_ptr<PathSegmentGenerator> CartesianSpatialGrid::createPathSegmentGenerator() const
 {
+    if (_uniform) return std::make_unique<MyUniformSegmentGenerator>(this);
     return std::make_unique<MySegmentGenerator>(this);
 }
 
 //////////////////////////////////////////////////////////////////////
 
+bool CartesianSpatialGrid::hasCuboidalCells() const
+{
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Box CartesianSpatialGrid::cellBox(int m) const
+{
+    return box(m);
+}
+
+//////////////////////////////////////////////////////////////////////
+
 void CartesianSpatialGrid::write_xy(SpatialGridPlotFile* outfile) const
 {
     for (int i = 0; i <= _Nx; i++) outfile->writeLine(_xv[i], ymin(), _xv[i], ymax());
@@ -204,6 +343,15 @@ int CartesianSpatialGrid::index(int i, int j, int k) const
 
 //////////////////////////////////////////////////////////////////////
 
+void CartesianSpatialGrid::binIndices(double x, double y, double z, int& i, int& j, int& k) const
+{
+    i = locateClip(_meshX, _xv, x);
+    j = locateClip(_meshY, _yv, y);
+    k = locateClip(_meshZ, _zv, z);
+}
+
+//////////////////////////////////////////////////////////////////////
+
 Box CartesianSpatialGrid::box(int m) const
 {
     int i = m / (_Nz * _Ny);
@@ -14,7 +14,14 @@
 
 /** The CartesianSpatialGrid class is subclass of the BoxSpatialGrid class, and represents
     three-dimensional spatial grids based on a regular Cartesian grid. Each cell in such a grid is
-    a little cuboid (not necessarily all with the same size or axis ratios). */
+    a little cuboid (not necessarily all with the same size or axis ratios).
+
+    If the configured mesh offers an analytic inverse (see Mesh::inverseMesh()), as is the case
+    for example for a linear, power-law or logarithmic mesh, the bin containing a given coordinate
+    is located in constant time rather than through a binary search. Furthermore, if the bins are
+    equally spaced along all three axes, the grid automatically uses a specialized path segment
+    generator based on the 3D digital differential analyzer (DDA) algorithm by Amanatides & Woo
+    (1987). */
 class CartesianSpatialGrid : public BoxSpatialGrid
 {
     ITEM_CONCRETE(CartesianSpatialGrid, BoxSpatialGrid, "a Cartesian spatial grid")
@@ -83,9 +90,19 @@ public:
 
         The algorithm used to construct the path is fairly straightforward because all cells are
         cuboids lined up with the coordinate axes and the neighboring cells are easily found by
-        manipulating cell indices. */
+        manipulating cell indices. If the bins are equally spaced along all three axes, the
+        function returns a generator that implements the 3D DDA traversal algorithm, which
+        advances the path length to the next cell wall in each direction by a constant increment
+        rather than recalculating it at each step. */
     std::unique_ptr<PathSegmentGenerator> createPathSegmentGenerator() const override;
 
+    /** This function returns true because all cells in a cartesian grid are cuboids lined up with
+        the coordinate axes. */
+    bool hasCuboidalCells() const override;
+
+    /** This function returns the extent of the cell with index \f$m\f$ as a Box object. */
+    Box cellBox(int m) const override;
+
 protected:
     /** This function writes the intersection of the grid structure with the xy plane to the
         specified SpatialGridPlotFile object. */
@@ -108,6 +125,12 @@ private:
        \f$j\f$ and \f$k\f$. The correspondence is \f$m=k+j\,N_z+i\,N_y\,N_z\f$. */
     int index(int i, int j, int k) const;
 
+    /** This function returns the three bin indices \f$i\f$, \f$j\f$ and \f$k\f$ of the cell
+        containing the position \f$(x,y,z)\f$, clipping each index to the valid range. It uses
+        the analytic inverse of the mesh in each direction if available, and performs a binary
+        search otherwise. */
+    void binIndices(double x, double y, double z, int& i, int& j, int& k) const;
+
     /** This function calculates the three bin indices \f$i\f$, \f$j\f$ and \f$k\f$ of the cell
         index \f$m\f$, and then returns the coordinates of the corresponding cell as a Box object.
         Since the relation between the index and the three bin indices is
@@ -125,10 +148,13 @@ private:
     Array _xv;
     Array _yv;
     Array _zv;
+    bool _uniform{false};  // true if the bins are equally spaced along all three axes
 
-    // allow our path segment generator to access our private data members
+    // allow our path segment generators to access our private data members
     class MySegmentGenerator;
     friend class MySegmentGenerator;
+    class MyUniformSegmentGenerator;
+    friend class MyUniformSegmentGenerator;
 };
 
 ////////////////////////////////////////////////////////////////////
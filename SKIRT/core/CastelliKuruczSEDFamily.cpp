@@ -77,6 +77,22 @@ double CastelliKuruczSEDFamily::specificLuminosity(double wavelength, const Arra
 
 ////////////////////////////////////////////////////////////////////
 
+void CastelliKuruczSEDFamily::specificLuminosities(Array& Lv, const Array& lambdav, const Array& parameters) const
+{
+    double R = parameters[0];
+    double Z = parameters[1];
+    double T = parameters[2];
+    double g = parameters[3];
+
+    // if needed, force the parameter values inside the valid portion of the grid
+    clampParameterValues(T, g);
+
+    _table.valueArray(Lv, lambdav, Z, T, g);
+    Lv *= 4. * M_PI * R * R;
+}
+
+////////////////////////////////////////////////////////////////////
+
 double CastelliKuruczSEDFamily::cdf(Array& lambdav, Array& pv, Array& Pv, const Range& wavelengthRange,
                                     const Array& parameters) const
 {
@@ -15,23 +15,23 @@
 
 Box CellSnapshot::boxForCell(int m) const
 {
-    const auto& prop = _propv[m];
     int i = boxIndex();
-    return Box(prop[i], prop[i + 1], prop[i + 2], prop[i + 3], prop[i + 4], prop[i + 5]);
+    return Box(_colv[i][m], _colv[i + 1][m], _colv[i + 2][m], _colv[i + 3][m], _colv[i + 4][m], _colv[i + 5][m]);
 }
 
 ////////////////////////////////////////////////////////////////////
 
 void CellSnapshot::readAndClose()
 {
-    // read the snapshot cell info into memory
-    _propv = infile()->readAllRows();
+    // read the snapshot cell info into memory, storing the properties column by column
+    _colv = infile()->readAllColumns();
+    _numCells = _colv.empty() ? 0 : _colv[0].size();
 
     // close the file
     close();
 
     // inform the user
-    log()->info("  Number of cells: " + std::to_string(_propv.size()));
+    log()->info("  Number of cells: " + std::to_string(_numCells));
 
     // if a mass density policy has been set, calculate masses and densities for all cells
     if (hasMassDensityPolicy()) calculateDensityAndMass(_rhov, _cumrhov, _mass);
@@ -39,10 +39,10 @@ void CellSnapshot::readAndClose()
     // if needed, construct a search structure for the cells
     if (hasMassDensityPolicy() || needGetEntities())
     {
-        log()->info("Constructing search grid for " + std::to_string(_propv.size()) + " cells...");
+        log()->info("Constructing search grid for " + std::to_string(_numCells) + " cells...");
         auto bounds = [this](int m) { return boxForCell(m); };
         auto intersects = [this](int m, const Box& box) { return box.intersects(boxForCell(m)); };
-        _search.loadEntities(_propv.size(), bounds, intersects);
+        _search.loadEntities(_numCells, bounds, intersects);
 
         int nb = _search.numBlocks();
         log()->info("  Number of blocks in grid: " + std::to_string(nb * nb * nb) + " (" + std::to_string(nb) + "^3)");
@@ -58,7 +58,7 @@ void CellSnapshot::readAndClose()
 Box CellSnapshot::extent() const
 {
     // if there are no cells, return an empty box
-    if (_propv.empty()) return Box();
+    if (!_numCells) return Box();
 
     // if there is a search structure, ask it to return the extent (it is already calculated)
     if (_search.numBlocks()) return _search.extent();
@@ -70,14 +70,14 @@ Box CellSnapshot::extent() const
     double ymax = -std::numeric_limits<double>::infinity();
     double zmin = +std::numeric_limits<double>::infinity();
     double zmax = -std::numeric_limits<double>::infinity();
-    for (const Array& prop : _propv)
+    for (int m = 0; m != _numCells; ++m)
     {
-        xmin = min(xmin, prop[boxIndex() + 0]);
-        xmax = max(xmax, prop[boxIndex() + 3]);
-        ymin = min(ymin, prop[boxIndex() + 1]);
-        ymax = max(ymax, prop[boxIndex() + 4]);
-        zmin = min(zmin, prop[boxIndex() + 2]);
-        zmax = max(zmax, prop[boxIndex() + 5]);
+        xmin = min(xmin, _colv[boxIndex() + 0][m]);
+        xmax = max(xmax, _colv[boxIndex() + 3][m]);
+        ymin = min(ymin, _colv[boxIndex() + 1][m]);
+        ymax = max(ymax, _colv[boxIndex() + 4][m]);
+        zmin = min(zmin, _colv[boxIndex() + 2][m]);
+        zmax = max(zmax, _colv[boxIndex() + 5][m]);
     }
     return Box(xmin, ymin, zmin, xmax, ymax, zmax);
 }
@@ -86,7 +86,7 @@ Box CellSnapshot::extent() const
 
 int CellSnapshot::numEntities() const
 {
-    return _propv.size();
+    return _numCells;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -140,7 +140,7 @@ Position CellSnapshot::generatePosition(int m) const
 Position CellSnapshot::generatePosition() const
 {
     // if there are no cells, return the origin
-    if (_propv.empty()) return Position();
+    if (!_numCells) return Position();
 
     // select a cell according to its mass contribution
     int m = NR::locateClip(_cumrhov, random()->uniform());
@@ -150,9 +150,9 @@ Position CellSnapshot::generatePosition() const
 
 ////////////////////////////////////////////////////////////////////
 
-const Array& CellSnapshot::properties(int m) const
+double CellSnapshot::property(int m, int p) const
 {
-    return _propv[m];
+    return _colv[p][m];
 }
 
 ////////////////////////////////////////////////////////////////////
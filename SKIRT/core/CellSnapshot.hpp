@@ -101,10 +101,10 @@ public:
     Position generatePosition() const override;
 
 protected:
-    /** This function returns a reference to an array containing the imported properties (in column
-        order) for the cell with index \f$0\le m \le N_\mathrm{ent}-1\f$. If the index is out of
-        range, the behavior is undefined. */
-    const Array& properties(int m) const override;
+    /** This function returns the value of the imported property with column index \em p for the
+        cell with index \f$0\le m \le N_\mathrm{ent}-1\f$. If either index is out of range, the
+        behavior is undefined. */
+    double property(int m, int p) const override;
 
 public:
     /** This function sets the specified entity collection to the cell containing the specified
@@ -131,7 +131,8 @@ private:
 
 private:
     // data members initialized when reading the input file
-    vector<Array> _propv;  // cell properties as imported
+    int _numCells{0};     // number of cells
+    vector<Array> _colv;  // cell properties as imported, one array per column
 
     // data members initialized after reading the input file if a density policy has been set
     Array _rhov;        // density for each cell (not normalized)
@@ -0,0 +1,506 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "CompositeSpatialGrid.hpp"
+#include "FatalError.hpp"
+#include "Log.hpp"
+#include "PathSegmentGenerator.hpp"
+#include "Random.hpp"
+#include "SpatialGridPlotFile.hpp"
+
+//////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    // maximum number of cells for which the 3D grid plot output includes the individual cells
+    const int maxPlotCells = 2500;  // empirical number
+
+    // returns the domain of the specified grid from its configured properties
+    Box domain(const BoxSpatialGrid* grid)
+    {
+        return Box(grid->minX(), grid->minY(), grid->minZ(), grid->maxX(), grid->maxY(), grid->maxZ());
+    }
+
+    // returns true if the two specified boxes overlap with a nonzero volume
+    bool overlaps(const Box& box1, const Box& box2)
+    {
+        return box1.xmin() < box2.xmax() && box2.xmin() < box1.xmax() && box1.ymin() < box2.ymax()
+               && box2.ymin() < box1.ymax() && box1.zmin() < box2.zmax() && box2.zmin() < box1.zmax();
+    }
+
+    // adds the specified cut coordinate to the list if it lies strictly between the given limits
+    void addCut(vector<double>& cuts, double cut, double min, double max)
+    {
+        if (cut > min && cut < max) cuts.push_back(cut);
+    }
+
+    // sorts the specified list of cut coordinates and removes duplicates
+    void sortCuts(vector<double>& cuts)
+    {
+        std::sort(cuts.begin(), cuts.end());
+        cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+    }
+
+    // returns the coordinate with the specified index (0, 1 or 2 for x, y or z) of the given vector
+    double coordinate(Vec v, int dir)
+    {
+        return dir == 0 ? v.x() : (dir == 1 ? v.y() : v.z());
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void CompositeSpatialGrid::setupSelfBefore()
+{
+    SpatialGrid::setupSelfBefore();
+
+    // verify that the outer grid has cuboidal cells
+    if (!_outerGrid->hasCuboidalCells())
+        throw FATALERROR("The outer grid in a composite grid should be a cartesian or tree grid");
+
+    // list the domains of the component grids
+    _domains.push_back(domain(_outerGrid));
+    for (auto grid : _innerGrids) _domains.push_back(domain(grid));
+
+    // verify that the inner grid domains lie inside the outer domain and do not overlap each other
+    int numGrids = _domains.size();
+    for (int g = 1; g != numGrids; ++g)
+    {
+        if (!_domains[0].contains(_domains[g]))
+            throw FATALERROR("The domain of each inner grid in a composite grid should lie inside the outer domain");
+        for (int h = g + 1; h != numGrids; ++h)
+            if (overlaps(_domains[g], _domains[h]))
+                throw FATALERROR("The domains of the inner grids in a composite grid should not overlap");
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void CompositeSpatialGrid::setupSelfAfter()
+{
+    SpatialGrid::setupSelfAfter();
+
+    // list the component grids and determine the corresponding cell index offsets
+    _grids.push_back(_outerGrid);
+    for (auto grid : _innerGrids) _grids.push_back(grid);
+    _offsets.push_back(0);
+    for (auto grid : _grids) _offsets.push_back(_offsets.back() + grid->numCells());
+
+    // calculate the uncovered volume fraction for each outer cell
+    int numOuter = _outerGrid->numCells();
+    _fractions.resize(numOuter);
+    int numPartial = 0;
+    int numFull = 0;
+    for (int m = 0; m != numOuter; ++m)
+    {
+        double volume = 0.;
+        for (const Box& piece : uncoveredPieces(m)) volume += piece.volume();
+        _fractions[m] = volume / _outerGrid->cellBox(m).volume();
+        if (_fractions[m] < 1.) numPartial++;
+        if (_fractions[m] <= 0.) numFull++;
+    }
+
+    // log some statistics
+    auto log = find<Log>();
+    log->info("  Number of cells in the outer grid: " + std::to_string(numOuter));
+    log->info("    of which partially covered by inner grids: " + std::to_string(numPartial - numFull));
+    log->info("    of which completely covered by inner grids: " + std::to_string(numFull));
+    int numInner = _innerGrids.size();
+    for (int i = 0; i != numInner; ++i)
+        log->info("  Number of cells in inner grid " + std::to_string(i + 1) + ": "
+                  + std::to_string(_innerGrids[i]->numCells()));
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int CompositeSpatialGrid::dimension() const
+{
+    return 3;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int CompositeSpatialGrid::numCells() const
+{
+    return _offsets.back();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Box CompositeSpatialGrid::boundingBox() const
+{
+    return _outerGrid->boundingBox();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+double CompositeSpatialGrid::volume(int m) const
+{
+    int mg;
+    int g = gridIndex(m, mg);
+    double volume = _grids[g]->volume(mg);
+    return g ? volume : volume * _fractions[mg];
+}
+
+//////////////////////////////////////////////////////////////////////
+
+double CompositeSpatialGrid::diagonal(int m) const
+{
+    int mg;
+    int g = gridIndex(m, mg);
+    return _grids[g]->diagonal(mg);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int CompositeSpatialGrid::cellIndex(Position bfr) const
+{
+    int numGrids = _grids.size();
+    for (int g = 1; g != numGrids; ++g)
+    {
+        int mg = _grids[g]->cellIndex(bfr);
+        if (mg >= 0) return _offsets[g] + mg;
+    }
+    return _outerGrid->cellIndex(bfr);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Position CompositeSpatialGrid::centralPositionInCell(int m) const
+{
+    int mg;
+    int g = gridIndex(m, mg);
+    return _grids[g]->centralPositionInCell(mg);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Position CompositeSpatialGrid::randomPositionInCell(int m) const
+{
+    int mg;
+    int g = gridIndex(m, mg);
+    if (g || _fractions[mg] >= 1.) return _grids[g]->randomPositionInCell(mg);
+    if (_fractions[mg] <= 0.) return _outerGrid->centralPositionInCell(mg);
+
+    // for partially covered outer cells, select an uncovered piece with a probability proportional to its volume
+    vector<Box> pieces = uncoveredPieces(mg);
+    double volume = 0.;
+    for (const Box& piece : pieces) volume += piece.volume();
+    double target = random()->uniform() * volume;
+    size_t i = 0;
+    double cumulative = pieces[0].volume();
+    while (cumulative < target && i + 1 < pieces.size()) cumulative += pieces[++i].volume();
+    return random()->position(pieces[i]);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int CompositeSpatialGrid::gridIndex(int m, int& mg) const
+{
+    int g = 0;
+    while (m >= _offsets[g + 1]) g++;
+    mg = m - _offsets[g];
+    return g;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+vector<Box> CompositeSpatialGrid::uncoveredPieces(int m) const
+{
+    // collect the coordinates at which the cell must be cut in each direction
+    Box cell = _outerGrid->cellBox(m);
+    vector<double> xv{cell.xmin(), cell.xmax()};
+    vector<double> yv{cell.ymin(), cell.ymax()};
+    vector<double> zv{cell.zmin(), cell.zmax()};
+    int numGrids = _domains.size();
+    bool covered = false;
+    for (int g = 1; g != numGrids; ++g)
+    {
+        const Box& inner = _domains[g];
+        if (overlaps(cell, inner))
+        {
+            covered = true;
+            addCut(xv, inner.xmin(), cell.xmin(), cell.xmax());
+            addCut(xv, inner.xmax(), cell.xmin(), cell.xmax());
+            addCut(yv, inner.ymin(), cell.ymin(), cell.ymax());
+            addCut(yv, inner.ymax(), cell.ymin(), cell.ymax());
+            addCut(zv, inner.zmin(), cell.zmin(), cell.zmax());
+            addCut(zv, inner.zmax(), cell.zmin(), cell.zmax());
+        }
+    }
+    if (!covered) return vector<Box>{cell};
+    sortCuts(xv);
+    sortCuts(yv);
+    sortCuts(zv);
+
+    // each piece lies either completely inside or completely outside of each inner domain,
+    // so it suffices to test the center of the piece
+    vector<Box> pieces;
+    for (size_t i = 0; i + 1 < xv.size(); ++i)
+        for (size_t j = 0; j + 1 < yv.size(); ++j)
+            for (size_t k = 0; k + 1 < zv.size(); ++k)
+            {
+                Box piece(xv[i], yv[j], zv[k], xv[i + 1], yv[j + 1], zv[k + 1]);
+                Vec center = piece.center();
+                bool inside = false;
+                for (int g = 1; g != numGrids; ++g)
+                    if (_domains[g].contains(center)) inside = true;
+                if (!inside) pieces.push_back(piece);
+            }
+    return pieces;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+class CompositeSpatialGrid::MySegmentGenerator : public PathSegmentGenerator
+{
+    const CompositeSpatialGrid* _grid{nullptr};
+    vector<std::unique_ptr<PathSegmentGenerator>> _generators;  // one for each component grid; outer grid first
+    vector<double> _entries;  // distance from the start of the path to the entry point of each inner grid
+    Position _r0;             // the start of the path
+    Direction _k0;            // the direction of the path
+    double _s{0.};            // the distance from the start of the path to the current position
+    int _current{0};          // index of the component grid currently generating segments
+    bool _pending{false};     // true if the current inner generator holds a segment that has not yet been returned
+    bool _outerDone{false};   // true if the outer generator has no more segments
+
+    // sets a segment in the outer cell with index m, or an empty segment if the cell is completely covered
+    void setOuterSegment(int m, double ds)
+    {
+        if (m >= 0 && _grid->_fractions[m] > 0.)
+            setSegment(m, ds);
+        else
+            setEmptySegment(ds);
+    }
+
+public:
+    MySegmentGenerator(const CompositeSpatialGrid* grid) : _grid(grid)
+    {
+        for (auto component : grid->_grids) _generators.push_back(component->createPathSegmentGenerator());
+        _entries.resize(_generators.size());
+    }
+
+    bool next() override
+    {
+        switch (state())
+        {
+            case State::Unknown:
+            {
+                // initialize the path state and start the outer generator
+                _r0 = r();
+                _k0 = k();
+                _s = 0.;
+                _current = 0;
+                _pending = false;
+                _outerDone = false;
+                _generators[0]->start(_r0, _k0);
+
+                // start each inner generator to determine the distance to its entry point, if any;
+                // because the domains are convex, the path enters each inner domain at most once;
+                // after this, each inner generator is positioned inside its domain, ready to generate segments
+                int numGrids = _generators.size();
+                _entries[0] = DBL_MAX;
+                for (int g = 1; g != numGrids; ++g)
+                {
+                    auto& generator = _generators[g];
+                    generator->start(_r0, _k0);
+                    if (!generator->next())
+                        _entries[g] = DBL_MAX;
+                    else if (generator->m() < 0)
+                        _entries[g] = generator->ds();
+                    else
+                    {
+                        // the path starts inside this inner domain; remember the first segment
+                        _entries[g] = 0.;
+                        _current = g;
+                        _pending = true;
+                    }
+                }
+                setState(State::Inside);
+            }
+
+            // intentionally falls through
+            case State::Inside:
+            {
+                while (true)
+                {
+                    // if we're inside an inner grid, return its next segment, if any
+                    if (_current)
+                    {
+                        auto& generator = _generators[_current];
+                        if (_pending || generator->next())
+                        {
+                            _pending = false;
+                            if (generator->m() >= 0)
+                                setSegment(_grid->_offsets[_current] + generator->m(), generator->ds());
+                            else
+                                setEmptySegment(generator->ds());
+                            _s += generator->ds();
+                            return true;
+                        }
+
+                        // the path has left the inner grid; resume the outer grid from the exit point
+                        _entries[_current] = DBL_MAX;
+                        _current = 0;
+                        _generators[0]->start(Position(_r0 + _s * _k0), _k0);
+                        _outerDone = false;
+                    }
+
+                    // determine the nearest inner grid entry point ahead of the current position
+                    int numGrids = _generators.size();
+                    int gnext = 0;
+                    for (int g = 1; g != numGrids; ++g)
+                        if (_entries[g] < _entries[gnext]) gnext = g;
+                    double entry = _entries[gnext];
+
+                    // if the outer grid has another segment, return it, truncated at the entry point if needed
+                    if (!_outerDone && _generators[0]->next())
+                    {
+                        auto& generator = _generators[0];
+                        if (_s + generator->ds() < entry)
+                        {
+                            setOuterSegment(generator->m(), generator->ds());
+                            _s += generator->ds();
+                            return true;
+                        }
+                        double ds = entry - _s;
+                        _s = entry;
+                        _current = gnext;
+                        if (ds > 0.)
+                        {
+                            setOuterSegment(generator->m(), ds);
+                            return true;
+                        }
+                        continue;
+                    }
+                    _outerDone = true;
+
+                    // if there are no more inner grids ahead, the path is complete
+                    if (!gnext) break;
+
+                    // otherwise, return an empty segment up to the entry point of the next inner grid
+                    double ds = entry - _s;
+                    _s = entry;
+                    _current = gnext;
+                    if (ds > 0.)
+                    {
+                        setEmptySegment(ds);
+                        return true;
+                    }
+                }
+                setState(State::Outside);
+                return false;
+            }
+
+            case State::Outside:
+            {
+            }
+        }
+        return false;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<PathSegmentGenerator> CompositeSpatialGrid::createPathSegmentGenerator() const
+{
+    return std::make_unique<MySegmentGenerator>(this);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void CompositeSpatialGrid::write_xy(SpatialGridPlotFile* outfile) const
+{
+    writePlane(outfile, 2);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void CompositeSpatialGrid::write_xz(SpatialGridPlotFile* outfile) const
+{
+    writePlane(outfile, 1);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void CompositeSpatialGrid::write_yz(SpatialGridPlotFile* outfile) const
+{
+    writePlane(outfile, 0);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void CompositeSpatialGrid::write_xyz(SpatialGridPlotFile* outfile) const
+{
+    // output the domains of all component grids
+    for (const Box& box : _domains)
+        outfile->writeCube(box.xmin(), box.ymin(), box.zmin(), box.xmax(), box.ymax(), box.zmax());
+
+    // count the cells with a nonzero volume in the component grids with cuboidal cells
+    int numGrids = _grids.size();
+    int numPlotCells = 0;
+    for (int g = 0; g != numGrids; ++g)
+    {
+        if (_grids[g]->hasCuboidalCells())
+        {
+            int numCells = _grids[g]->numCells();
+            for (int mg = 0; mg != numCells; ++mg)
+                if (g || _fractions[mg] > 0.) numPlotCells++;
+        }
+    }
+
+    // output these cells if there are not too many
+    if (numPlotCells > maxPlotCells)
+    {
+        find<Log>()->info("Limiting 3D grid plot output to the domains of the component grids.");
+        return;
+    }
+    for (int g = 0; g != numGrids; ++g)
+    {
+        if (_grids[g]->hasCuboidalCells())
+        {
+            int numCells = _grids[g]->numCells();
+            for (int mg = 0; mg != numCells; ++mg)
+            {
+                if (g || _fractions[mg] > 0.)
+                {
+                    Box box = _grids[g]->cellBox(mg);
+                    outfile->writeCube(box.xmin(), box.ymin(), box.zmin(), box.xmax(), box.ymax(), box.zmax());
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void CompositeSpatialGrid::writePlane(SpatialGridPlotFile* outfile, int dir) const
+{
+    // determine the indices of the coordinates in the plane
+    int dir1 = dir == 0 ? 1 : 0;
+    int dir2 = dir == 2 ? 1 : 2;
+
+    // output the rectangle in which the specified box intersects the plane, if any
+    auto writeBox = [outfile, dir, dir1, dir2](const Box& box) {
+        if (coordinate(box.rmin(), dir) <= 0. && coordinate(box.rmax(), dir) > 0.)
+            outfile->writeRectangle(coordinate(box.rmin(), dir1), coordinate(box.rmin(), dir2),
+                                    coordinate(box.rmax(), dir1), coordinate(box.rmax(), dir2));
+    };
+
+    // output the domain of each component grid and, for grids with cuboidal cells, the cells with a nonzero volume
+    int numGrids = _grids.size();
+    for (int g = 0; g != numGrids; ++g)
+    {
+        writeBox(_domains[g]);
+        if (_grids[g]->hasCuboidalCells())
+        {
+            int numCells = _grids[g]->numCells();
+            for (int mg = 0; mg != numCells; ++mg)
+                if (g || _fractions[mg] > 0.) writeBox(_grids[g]->cellBox(mg));
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
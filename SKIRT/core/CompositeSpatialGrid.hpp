@@ -0,0 +1,165 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#ifndef COMPOSITESPATIALGRID_HPP
+#define COMPOSITESPATIALGRID_HPP
+
+#include "Array.hpp"
+#include "BoxSpatialGrid.hpp"
+
+//////////////////////////////////////////////////////////////////////
+
+/** The CompositeSpatialGrid class represents a spatial grid composed of an outer grid covering the
+    complete spatial domain and one or more inner grids nested inside the outer grid. This allows,
+    for example, embedding a high-resolution cartesian grid around a circumnuclear torus inside a
+    coarse tree grid covering a complete galaxy, using orders of magnitude fewer cells than a
+    single grid with the same effective resolution.
+
+    The outer grid and the inner grids must all have a cuboidal spatial domain lined up with the
+    coordinate axes. In addition, the cells of the outer grid must be cuboids lined up with the
+    coordinate axes, which is the case for cartesian and tree grids. The domain of each inner grid
+    must lie inside the domain of the outer grid, and the domains of the inner grids must not
+    overlap each other. These requirements are verified during setup.
+
+    In the region covered by an inner grid, the cells of the inner grid take precedence over those
+    of the outer grid. The cells of the composite grid are numbered by first listing all cells of
+    the outer grid, followed by the cells of each inner grid in the configured order. Outer cells
+    that overlap the domain of one or more inner grids represent only the uncovered portion of
+    their volume. Because all domains and outer cells are cuboids, this portion is calculated
+    exactly by cutting the outer cell along the faces of the inner domains that cross the cell.
+    Outer cells that are completely covered by inner grids have zero volume. They never receive
+    path segments or random positions. Random positions in a partially covered outer cell are
+    drawn uniformly from the uncovered portion of the cell.
+
+    The path segment generator for a composite grid hands off between the path segment generators
+    for the outer and inner grids as the path crosses the boundaries of the inner grid domains. */
+class CompositeSpatialGrid : public SpatialGrid
+{
+    ITEM_CONCRETE(CompositeSpatialGrid, SpatialGrid, "a composite grid with nested high-resolution grids")
+        ATTRIBUTE_TYPE_DISPLAYED_IF(CompositeSpatialGrid, "Level3")
+
+        PROPERTY_ITEM(outerGrid, BoxSpatialGrid, "the outer grid covering the complete spatial domain")
+        ATTRIBUTE_DEFAULT_VALUE(outerGrid, "PolicyTreeSpatialGrid")
+
+        PROPERTY_ITEM_LIST(innerGrids, BoxSpatialGrid, "the inner grids nested inside the outer grid")
+        ATTRIBUTE_DEFAULT_VALUE(innerGrids, "CartesianSpatialGrid")
+
+    ITEM_END()
+
+    //============= Construction - Setup - Destruction =============
+
+protected:
+    /** This function verifies that the outer grid has cuboidal cells, that the domain of each
+        inner grid lies inside the domain of the outer grid, and that the domains of the inner
+        grids do not overlap each other. */
+    void setupSelfBefore() override;
+
+    /** This function determines the cell index offset for each of the component grids, and
+        calculates the portion of the volume of each outer cell that is not covered by an inner
+        grid. */
+    void setupSelfAfter() override;
+
+    //======================== Other Functions =======================
+
+public:
+    /** This function returns the dimension of the grid, which is always 3 because all component
+        grids have a cuboidal domain. */
+    int dimension() const override;
+
+    /** This function returns the total number of cells in the outer and inner grids. */
+    int numCells() const override;
+
+    /** This function returns the bounding box of the outer grid, which encloses the domains of
+        all inner grids. */
+    Box boundingBox() const override;
+
+    /** This function returns the volume of the cell with index \f$m\f$. For an inner cell, this is
+        the volume of the cell in the inner grid. For an outer cell, this is the portion of the
+        volume of the cell in the outer grid that is not covered by an inner grid, which is zero
+        for completely covered cells. */
+    double volume(int m) const override;
+
+    /** This function returns the diagonal of the cell with index \f$m\f$ as reported by the
+        component grid containing the cell. */
+    double diagonal(int m) const override;
+
+    /** This function returns the index of the cell that contains the position \f${\bf{r}}\f$. The
+        function first consults the inner grids and, if none of these contains the position, the
+        outer grid. If the position is outside of all grid domains, the function returns -1. */
+    int cellIndex(Position bfr) const override;
+
+    /** This function returns the central location of the cell with index \f$m\f$ as reported by
+        the component grid containing the cell. For partially or completely covered outer cells,
+        the returned position may lie in the region covered by an inner grid. */
+    Position centralPositionInCell(int m) const override;
+
+    /** This function returns a random location from the cell with index \f$m\f$. For a partially
+        covered outer cell, the function cuts the cell into cuboidal pieces along the faces of the
+        inner domains that cross the cell, selects one of the uncovered pieces with a probability
+        proportional to its volume, and returns a uniformly distributed position in that piece.
+        For a completely covered outer cell, which has zero volume, the function returns the
+        central position of the cell. */
+    Position randomPositionInCell(int m) const override;
+
+    /** This function creates and hands over ownership of a path segment generator appropriate for
+        a composite spatial grid. The generator drives the path segment generators of the component
+        grids, truncating segments in the outer grid at the entry point into an inner grid domain
+        and resuming the outer grid at the exit point. Segments in completely covered outer cells,
+        which may arise from round-off errors along the boundaries of an inner domain, are
+        returned as empty segments. */
+    std::unique_ptr<PathSegmentGenerator> createPathSegmentGenerator() const override;
+
+protected:
+    /** This function writes the intersection of the composite grid with the xy plane to the
+        specified SpatialGridPlotFile object. */
+    void write_xy(SpatialGridPlotFile* outfile) const override;
+
+    /** This function writes the intersection of the composite grid with the xz plane to the
+        specified SpatialGridPlotFile object. */
+    void write_xz(SpatialGridPlotFile* outfile) const override;
+
+    /** This function writes the intersection of the composite grid with the yz plane to the
+        specified SpatialGridPlotFile object. */
+    void write_yz(SpatialGridPlotFile* outfile) const override;
+
+    /** This function writes 3D information for the composite grid to the specified
+        SpatialGridPlotFile object. It always writes the domains of the component grids and, if
+        the number of cells is not too large, the cells of the component grids with cuboidal
+        cells. */
+    void write_xyz(SpatialGridPlotFile* outfile) const override;
+
+private:
+    /** This function returns the index \f$g\f$ in the list of component grids (0 for the outer
+        grid, \f$g\ge1\f$ for the inner grids) of the grid containing the cell with index \f$m\f$ in
+        the composite grid, and stores the index of the cell in that component grid in \em mg. */
+    int gridIndex(int m, int& mg) const;
+
+    /** This function returns the list of cuboidal pieces of the specified outer cell that are not
+        covered by an inner grid domain. The pieces are obtained by cutting the cell along the
+        faces of the inner domains that cross the cell. */
+    vector<Box> uncoveredPieces(int m) const;
+
+    /** This function writes the intersection of the composite grid with a coordinate plane to the
+        specified SpatialGridPlotFile object. The plane is perpendicular to the coordinate axis
+        with index \em dir (0, 1 or 2 for x, y or z). */
+    void writePlane(SpatialGridPlotFile* outfile, int dir) const;
+
+    //======================== Data Members ========================
+
+private:
+    // data members initialized during setup
+    vector<const SpatialGrid*> _grids;  // the component grids; outer grid first
+    vector<Box> _domains;               // the domain of each component grid; outer grid first
+    vector<int> _offsets;               // the cell index offset for each component grid, plus total number of cells
+    Array _fractions;                   // the uncovered volume fraction for each outer cell
+
+    // allow our path segment generator to access our private data members
+    class MySegmentGenerator;
+    friend class MySegmentGenerator;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+#endif
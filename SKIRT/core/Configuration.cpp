@@ -128,8 +128,13 @@ void Configuration::setupSelfBefore()
                 _lyaAccelerationScheme = Configuration::LyaAccelerationScheme::Variable;
                 _lyaAccelerationStrength = ms->lyaOptions()->lyaAccelerationStrength();
                 break;
+            case LyaOptions::LyaAccelerationScheme::Dynamic:
+                _lyaAccelerationScheme = Configuration::LyaAccelerationScheme::Dynamic;
+                _lyaAccelerationStrength = ms->lyaOptions()->lyaAccelerationStrength();
+                break;
         }
         if (ms->lyaOptions()->includeHubbleFlow()) _hubbleExpansionRate = sim->cosmology()->relativeExpansionRate();
+        _lyaTabulatedVoigtFunction = ms->lyaOptions()->tabulateVoigtFunction();
     }
 
     // retrieve the presence of phases and iterations
@@ -265,6 +270,9 @@ void Configuration::setupSelfBefore()
         {
             _maxFractionOfPrimary = ms->dustEmissionOptions()->maxFractionOfPrimary();
             _maxFractionOfPrevious = ms->dustEmissionOptions()->maxFractionOfPrevious();
+            _dustEmissionReuseTolerance = ms->dustEmissionOptions()->spectrumReuseTolerance();
+            if (_dustEmissionReuseTolerance > 0. && !dynamic_cast<AllCellsLibrary*>(_cellLibrary))
+                throw FATALERROR("Reusing dust emission spectra requires a cell library with an entry for every cell");
         }
         _dustEmissionSourceWeight = ms->dustEmissionOptions()->sourceWeight();
         _dustEmissionWavelengthBias = ms->dustEmissionOptions()->wavelengthBias();
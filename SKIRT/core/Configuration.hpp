@@ -345,7 +345,7 @@ public:
     double pathLengthBias() const { return _pathLengthBias; }
 
     /** This enumeration lists the supported Lyman-alpha acceleration schemes. */
-    enum class LyaAccelerationScheme { None, Constant, Variable };
+    enum class LyaAccelerationScheme { None, Constant, Variable, Dynamic };
 
     /** Returns the enumeration value determining the acceleration scheme to be used for
         Lyman-alpha line scattering. The value is relevant only if Lyman-alpha line treatment is
@@ -354,7 +354,7 @@ public:
 
     /** Returns the strength of the Lyman-alpha acceleration scheme to be applied. The value is
         relevant only if Lyman-alpha line treatment is enabled in the simulation and
-        lyaAccelerationScheme() returns \c Constant or \c Variable. */
+        lyaAccelerationScheme() returns \c Constant, \c Variable or \c Dynamic. */
     double lyaAccelerationStrength() const { return _lyaAccelerationStrength; }
 
     /** If inclusion of the Hubble flow is enabled, this function returns the relative expansion
@@ -363,6 +363,12 @@ public:
         returns zero. */
     double hubbleExpansionRate() const { return _hubbleExpansionRate; }
 
+    /** Returns true if the Voigt function determining the Lyman-alpha cross section should be
+        evaluated through interpolation in a precalculated table rather than directly, and false
+        otherwise. The value is relevant only if Lyman-alpha line treatment is enabled in the
+        simulation. */
+    bool lyaTabulatedVoigtFunction() const { return _lyaTabulatedVoigtFunction; }
+
     // ----> radiation field
 
     /** Returns true if the radiation field must be stored during the photon cycle, and false
@@ -414,6 +420,12 @@ public:
     /** Returns the cell library mapping to be used for calculating the dust emission spectra. */
     SpatialCellLibrary* cellLibrary() const { return _cellLibrary; }
 
+    /** Returns the relative change in absorbed luminosity since the emission spectrum of a cell
+        was last calculated below which that spectrum may be reused by subsequent secondary
+        emission segments, or zero if emission spectra should always be recalculated. A nonzero
+        value implies that the cell library maps each spatial cell to its own entry. */
+    double dustEmissionReuseTolerance() const { return _dustEmissionReuseTolerance; }
+
     /** Returns the bias weight for dust emission sources. */
     double dustEmissionSourceWeight() const { return _dustEmissionSourceWeight; }
 
@@ -508,6 +520,7 @@ private:
     LyaAccelerationScheme _lyaAccelerationScheme{LyaAccelerationScheme::Variable};
     double _lyaAccelerationStrength{1.};
     double _hubbleExpansionRate{0.};
+    bool _lyaTabulatedVoigtFunction{false};
 
     // radiation field
     bool _hasRadiationField{false};
@@ -526,6 +539,7 @@ private:
     bool _includeHeatingByCMB{false};
     DisjointWavelengthGrid* _dustEmissionWLG{nullptr};
     SpatialCellLibrary* _cellLibrary{nullptr};
+    double _dustEmissionReuseTolerance{0.};
     double _dustEmissionSourceWeight{1.};
     double _dustEmissionWavelengthBias{0.5};
     WavelengthDistribution* _dustEmissionWavelengthBiasDistribution{nullptr};
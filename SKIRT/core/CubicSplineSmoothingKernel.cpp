@@ -48,6 +48,20 @@ double CubicSplineSmoothingKernel::density(double u) const
 
 //////////////////////////////////////////////////////////////////////
 
+void CubicSplineSmoothingKernel::densities(const double* uv, double* Wv, int n) const
+{
+    for (int i = 0; i != n; ++i)
+    {
+        double u = uv[i];
+        double inner = 8.0 / M_PI * (1.0 - 6.0 * u * u * (1.0 - u));
+        double outer = 8.0 / M_PI * 2.0 * (1.0 - u) * (1.0 - u) * (1.0 - u);
+        double W = u < 0.5 ? inner : outer;
+        Wv[i] = (u < 0.0 || u >= 1.0) ? 0.0 : W;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+
 double CubicSplineSmoothingKernel::columnDensity(double q) const
 {
     if (q < 0.0 || q >= 1.0) return 0.0;
@@ -38,6 +38,14 @@ public:
         header. */
     double density(double u) const override;
 
+    /** This function calculates the density \f$W(u_i)\f$ of the smoothing kernel for each of the
+        \em n normalized radii \f$u_i\f$ in the array \em uv, and stores the results in the
+        corresponding elements of the array \em Wv. For each radius, both polynomial pieces of the
+        cubic spline are evaluated and the appropriate one is selected, so that the loop has no
+        branches. The expressions are identical to those in density(), so that both functions
+        return exactly the same values. */
+    void densities(const double* uv, double* Wv, int n) const override;
+
     /** This function returns the column density \f$\Sigma(q) = 2 \int_{q}^1 \frac{W(u)\,u
         \,{\text{d}}u} {\sqrt{u^2-q^2}}\f$ of the smoothing kernel as a function of the normalized
         impact radius \f$q=r_\text{i}/h\f$. For the cubic spline smoothing kernel, we obtain
@@ -223,9 +223,9 @@ Position CylindricalCellSnapshot::generatePosition() const
 
 ////////////////////////////////////////////////////////////////////
 
-const Array& CylindricalCellSnapshot::properties(int m) const
+double CylindricalCellSnapshot::property(int m, int p) const
 {
-    return _propv[m];
+    return _propv[m][p];
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -181,6 +181,7 @@ vector<TreeNode*> DensityTreePolicy::constructTree(TreeNode* root)
 {
     auto log = find<Log>();
     auto parallel = find<ParallelFactory>()->parallelDistributed();
+    auto local = find<ParallelFactory>()->parallelLocal();
 
     // initialize the tree node list with the root node as the first item
     vector<TreeNode*> nodev{root};
@@ -215,19 +216,63 @@ vector<TreeNode*> DensityTreePolicy::constructTree(TreeNode* root)
         });
         ProcessManager::sumToAll(divide);
 
-        // subdivide the nodes that have been flagged
-        size_t numDivideNodes = divide.sum();
-        log->infoSetElapsed(numDivideNodes);
-        size_t numDone = 0;
+        // make a list of the nodes that have been flagged
+        vector<TreeNode*> dividev;
+        dividev.reserve(divide.sum());
         for (size_t l = 0; l != numEvalNodes; ++l)
+            if (divide[l]) dividev.push_back(nodev[lbeg + l]);
+        size_t numDivideNodes = dividev.size();
+
+        // subdivide the flagged nodes; because each process needs the complete tree, every process performs
+        // this operation on its own, in parallel over its threads, in a number of phases that each modify
+        // only the nodes "owned" by a given task so that there is no need for locking
+        if (numDivideNodes)
         {
-            if (divide[l])
-            {
-                nodev[lbeg + l]->subdivide(nodev);
-                numDone++;
-                if (numDone % logDivideChunkSize == 0)
-                    log->infoIfElapsed("Subdivision for level " + std::to_string(level) + ": ", logDivideChunkSize);
-            }
+            // create the children, assigning node identifiers that match the index in the node list
+            // in the same order as a serial subdivision
+            size_t numChildren = dividev[0]->numChildren();
+            nodev.resize(lend + numDivideNodes * numChildren);
+            log->infoSetElapsed(numDivideNodes);
+            local->call(numDivideNodes,
+                        [log, level, lend, numChildren, &nodev, &dividev](size_t firstIndex, size_t numIndices) {
+                            while (numIndices)
+                            {
+                                size_t currentChunkSize = min(logDivideChunkSize, numIndices);
+                                for (size_t i = firstIndex; i != firstIndex + currentChunkSize; ++i)
+                                {
+                                    size_t id = lend + i * numChildren;
+                                    dividev[i]->createChildren(id);
+                                    const auto& children = dividev[i]->children();
+                                    std::copy(children.begin(), children.end(), nodev.begin() + id);
+                                }
+                                log->infoIfElapsed("Subdivision for level " + std::to_string(level) + ": ",
+                                                   currentChunkSize);
+                                firstIndex += currentChunkSize;
+                                numIndices -= currentChunkSize;
+                            }
+                        });
+
+            // initialize the neighbor lists of the new children
+            local->call(numDivideNodes, [&dividev](size_t firstIndex, size_t numIndices) {
+                for (size_t i = firstIndex; i != firstIndex + numIndices; ++i) dividev[i]->addChildNeighbors();
+            });
+
+            // for each childless neighbor of a subdivided node, determine which subdivided node is responsible
+            // for updating its neighbor lists, making sure that each neighbor is assigned to just one task
+            vector<vector<TreeNode*>> updatevv(numDivideNodes);
+            local->call(numDivideNodes, [&dividev, &updatevv](size_t firstIndex, size_t numIndices) {
+                for (size_t i = firstIndex; i != firstIndex + numIndices; ++i)
+                    for (int wall = 0; wall != 6; ++wall)
+                        for (auto neighbor : dividev[i]->neighbors(static_cast<TreeNode::Wall>(wall)))
+                            if (neighbor->isChildless() && neighbor->firstSubdividedNeighbor() == dividev[i])
+                                updatevv[i].push_back(neighbor);
+            });
+
+            // in the neighbor lists of these childless nodes, replace the subdivided nodes by their children
+            local->call(numDivideNodes, [&updatevv](size_t firstIndex, size_t numIndices) {
+                for (size_t i = firstIndex; i != firstIndex + numIndices; ++i)
+                    for (auto node : updatevv[i]) node->replaceSubdividedNeighbors();
+            });
         }
 
         // update iteration variables to the next level
@@ -237,7 +282,9 @@ vector<TreeNode*> DensityTreePolicy::constructTree(TreeNode* root)
     }
 
     // sort the neighbors for all nodes
-    for (auto node : nodev) node->sortNeighbors();
+    local->call(nodev.size(), [&nodev](size_t firstIndex, size_t numIndices) {
+        for (size_t m = firstIndex; m != firstIndex + numIndices; ++m) nodev[m]->sortNeighbors();
+    });
     return nodev;
 }
 
@@ -9,6 +9,7 @@
 #include "Indices.hpp"
 #include "InstrumentWavelengthGridProbe.hpp"
 #include "MediumSystem.hpp"
+#include "ProbeSystem.hpp"
 #include "StringUtils.hpp"
 #include "TextOutFile.hpp"
 #include "Units.hpp"
@@ -33,8 +34,9 @@ void DustAbsorptionPerCellProbe::probe()
             auto grid = ms->grid();
             auto units = find<Units>();
 
-            // create a text file
-            TextOutFile file(this, itemName() + "_Labs", "dust absorption per cell");
+            // create a text or stored column file
+            TextOutFile file(this, itemName() + "_Labs", "dust absorption per cell",
+                             find<ProbeSystem>()->writeStoredColumns());
 
             // write the header
             file.writeLine("# Spectral luminosity absorbed by dust per spatial cell");
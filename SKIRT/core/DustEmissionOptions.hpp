@@ -16,7 +16,17 @@
 
 /** The DustEmissionOptions class simply offers a number of configuration options related to
     thermal emission from dust. In a mode where dust emission is enabled, the simulation also
-    needs a wavelength grid on which to calculate the dust emission spectrum. */
+    needs a wavelength grid on which to calculate the dust emission spectrum.
+
+    In a mode with secondary emission iterations, the \em spectrumReuseTolerance option allows
+    reusing the emission spectrum calculated for a spatial cell in a previous iteration as long as
+    the absorbed luminosity in that cell has changed by less than the specified relative tolerance.
+    To this end, each process keeps the emission spectrum for every spatial cell in memory, i.e.
+    \f$N_\mathrm{cells}\times N_\lambda\f$ double-precision values per process, where
+    \f$N_\lambda\f$ is the number of bins in the dust emission wavelength grid. For a model with
+    \f$10^7\f$ cells and a grid of 100 bins, this amounts to 8 GB per process. The option is
+    available only with a cell library that has a separate entry for every cell (i.e. the default
+    AllCellsLibrary), because other libraries calculate a single spectrum for a group of cells. */
 class DustEmissionOptions : public SimulationItem, public SourceWavelengthRangeInterface
 {
     /** The enumeration type indicating the method used for dust emission calculations. */
@@ -60,6 +70,15 @@ class DustEmissionOptions : public SimulationItem, public SourceWavelengthRangeI
         ATTRIBUTE_DEFAULT_VALUE(maxFractionOfPrevious, "0.03")
         ATTRIBUTE_RELEVANT_IF(maxFractionOfPrevious, "IterateSecondary")
 
+        PROPERTY_DOUBLE(spectrumReuseTolerance,
+                        "reuse the emission spectrum for cells with a relative change in absorbed luminosity "
+                        "below this tolerance since the spectrum was calculated, or zero to always recalculate")
+        ATTRIBUTE_MIN_VALUE(spectrumReuseTolerance, "[0")
+        ATTRIBUTE_MAX_VALUE(spectrumReuseTolerance, "1[")
+        ATTRIBUTE_DEFAULT_VALUE(spectrumReuseTolerance, "0")
+        ATTRIBUTE_RELEVANT_IF(spectrumReuseTolerance, "IterateSecondary&!NonIdentitySpatialCellLibrary")
+        ATTRIBUTE_DISPLAYED_IF(spectrumReuseTolerance, "Level3")
+
         PROPERTY_DOUBLE(sourceWeight, "the weight of dust emission for the number of photon packets launched")
         ATTRIBUTE_MIN_VALUE(sourceWeight, "]0")
         ATTRIBUTE_MAX_VALUE(sourceWeight, "1000]")
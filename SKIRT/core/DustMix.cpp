@@ -96,6 +96,7 @@ void DustMix::setupSelfAfter()
     {
         _lambdav[ell] = sqrt(lambdav[ell] * lambdav[ell - 1]);
     }
+    _lambdaIndexCache.initialize(_lambdav);
 
     // get the scattering mode advertised by this dust mix
     auto mode = scatteringMode();
@@ -172,6 +173,13 @@ void DustMix::setupSelfAfter()
             NR::cdf(_thetaXvv[ell], maxTheta, [this, ell](int t) { return _S11vv(ell, t + 1) * sin(_thetav[t + 1]); });
         }
 
+        // create a guide table for each of these cumulative distributions to accelerate sampling
+        _thetaGuidevv.resize(numLambda);
+        for (int ell = 0; ell != numLambda; ++ell)
+        {
+            NR::guide(_thetaGuidevv[ell], _thetaXvv[ell], maxTheta);
+        }
+
         // create a table with the phase function normalization factor for each wavelength
         _pfnormv.resize(numLambda);
         for (int ell = 0; ell != numLambda; ++ell)
@@ -184,6 +192,21 @@ void DustMix::setupSelfAfter()
             _pfnormv[ell] = 2.0 / sum;
         }
 
+        // create a table with the unnormalized cumulative distribution of the absorption cross sections
+        // over the emission angle for each wavelength, used for sampling the direction of polarized emission
+        if (mode == ScatteringMode::SpheroidalPolarization)
+        {
+            _sigmaabscumvv.resize(numLambda, numTheta);
+            for (int ell = 0; ell != numLambda; ++ell)
+            {
+                for (int t = 1; t != numTheta; ++t)
+                {
+                    _sigmaabscumvv[ell][t] = _sigmaabscumvv[ell][t - 1] + _sigmaabsvv[ell][t - 1] * sin(_thetav[t - 1])
+                                             + _sigmaabsvv[ell][t] * sin(_thetav[t]);
+                }
+            }
+        }
+
         // create tables listing phi, phi/(2 pi), sin(2 phi) and 1-cos(2 phi) for each phi index
         if (mode == ScatteringMode::SphericalPolarization || mode == ScatteringMode::SpheroidalPolarization)
         {
@@ -240,8 +263,12 @@ void DustMix::setupSelfAfter()
     allocatedSize += _phicv.size();
     allocatedSize += _sigmaabsvv.size();
     allocatedSize += _sigmaabspolvv.size();
+    allocatedSize += _sigmaabscumvv.size();
 
-    allocatedBytes += allocatedSize * sizeof(double) + _calc.allocatedBytes();
+    size_t allocatedGuides = 0;
+    for (const auto& guidev : _thetaGuidevv) allocatedGuides += guidev.size();
+
+    allocatedBytes += allocatedSize * sizeof(double) + allocatedGuides * sizeof(int) + _calc.allocatedBytes();
     find<Log>()->info(type() + " allocated " + StringUtils::toMemSizeString(allocatedBytes) + " of memory");
 }
 
@@ -275,7 +302,7 @@ void DustMix::informAvailableWavelengthRange(Range available)
 
 int DustMix::indexForLambda(double lambda) const
 {
-    return NR::locateClip(_lambdav, lambda);
+    return _lambdaIndexCache.index(lambda);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -562,7 +589,8 @@ double DustMix::phaseFunctionValueForCosine(double lambda, double costheta) cons
 
 double DustMix::generateCosineFromPhaseFunction(double lambda) const
 {
-    return cos(random()->cdfLinLin(_thetav, _thetaXvv[indexForLambda(lambda)]));
+    int ell = indexForLambda(lambda);
+    return cos(random()->cdfLinLin(_thetav, _thetaXvv[ell], _thetaGuidevv[ell]));
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -583,16 +611,33 @@ std::pair<double, double> DustMix::generateAnglesFromPhaseFunction(double lambda
     int ell = indexForLambda(lambda);
 
     // sample from the normalized cumulative distribution of theta for this wavelength
-    double theta = random()->cdfLinLin(_thetav, _thetaXvv[ell]);
+    double theta = random()->cdfLinLin(_thetav, _thetaXvv[ell], _thetaGuidevv[ell]);
     int t = indexForTheta(theta);
 
-    // construct and sample from the normalized cumulative distribution of phi for this wavelength and theta angle
+    // sample from the normalized cumulative distribution of phi for this wavelength and theta angle;
+    // the distribution values are evaluated only where needed by the binary search,
+    // avoiding the construction of a temporary array for each scattering event
     double polDegree = sv->linearPolarizationDegree();
     double polAngle = sv->polarizationAngle();
     double PF = polDegree * _S12vv(ell, t) / _S11vv(ell, t) / (4 * M_PI);
     double cos2polAngle = cos(2 * polAngle) * PF;
     double sin2polAngle = sin(2 * polAngle) * PF;
-    double phi = random()->cdfLinLin(_phiv, _phi1v + cos2polAngle * _phisv + sin2polAngle * _phicv);
+    auto Phi = [this, cos2polAngle, sin2polAngle](int f) {
+        return _phi1v[f] + cos2polAngle * _phisv[f] + sin2polAngle * _phicv[f];
+    };
+    double X = random()->uniform();
+    int fl = -1;
+    int fu = maxPhi;
+    while (fu - fl > 1)
+    {
+        int fm = (fu + fl) >> 1;
+        if (X < Phi(fm))
+            fu = fm;
+        else
+            fl = fm;
+    }
+    int f = max(0, fl);
+    double phi = NR::interpolateLinLin(X, Phi(f), Phi(f + 1), _phiv[f], _phiv[f + 1]);
 
     // return the result
     return std::make_pair(theta, phi);
@@ -632,6 +677,14 @@ const Array& DustMix::sectionsAbspol(double lambda) const
 
 ////////////////////////////////////////////////////////////////////
 
+const Array& DustMix::cumulativeSectionsAbs(double lambda) const
+{
+    int ell = indexForLambda(lambda);
+    return _sigmaabscumvv[ell];
+}
+
+////////////////////////////////////////////////////////////////////
+
 Array DustMix::emissivity(const Array& Jv) const
 {
     return _calc.emissivity(Jv);
@@ -653,6 +706,22 @@ Array DustMix::emissionSpectrum(const MaterialState* state, const Array& Jv) con
 
 ////////////////////////////////////////////////////////////////////
 
+vector<Array> DustMix::emissivities(const vector<Array>& Jvv) const
+{
+    return _calc.emissivities(Jvv);
+}
+
+////////////////////////////////////////////////////////////////////
+
+vector<Array> DustMix::emissionSpectra(const vector<const MaterialState*>& states, const vector<Array>& Jvv) const
+{
+    vector<Array> evv = emissivities(Jvv);
+    for (size_t i = 0; i != evv.size(); ++i) evv[i] = states[i]->numberDensity() * evv[i];
+    return evv;
+}
+
+////////////////////////////////////////////////////////////////////
+
 double DustMix::indicativeTemperature(const MaterialState* /*state*/, const Array& Jv) const
 {
     return Jv.size() ? _calc.equilibriumTemperature(0, Jv) : 0.;
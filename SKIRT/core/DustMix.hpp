@@ -11,6 +11,7 @@
 #include "MaterialMix.hpp"
 #include "Range.hpp"
 #include "Table.hpp"
+#include "WavelengthIndexCache.hpp"
 
 ////////////////////////////////////////////////////////////////////
 
@@ -181,7 +182,8 @@ protected:
 private:
     /** This function returns the index in the private wavelength grid corresponding to the
         specified wavelength. The parameters for converting a wavelength to the appropriate index
-        are stored in data members during setup. */
+        are stored in data members during setup, and the most recent result is remembered for each
+        execution thread. */
     int indexForLambda(double lambda) const;
 
     /** This function returns the index in the private scattering angle grid corresponding to the
@@ -469,6 +471,19 @@ public:
         number density retrieved from the material state. */
     Array emissionSpectrum(const MaterialState* state, const Array& Jv) const override;
 
+    /** This function returns the emissivity spectra for a batch of radiation fields, as described
+        for the emissivity() function. It hands the complete batch to the equilibrium emission
+        calculator, which solves the energy balance equation for all radiation fields at the same
+        time. */
+    vector<Array> emissivities(const vector<Array>& Jvv) const override;
+
+    /** This function returns the emission spectra for a batch of spatial cells, as described for
+        the emissionSpectrum() function. It obtains the emissivities for the complete batch through
+        the emissivities() function and multiplies each of them by the hydrogen number density
+        retrieved from the corresponding material state. */
+    vector<Array> emissionSpectra(const vector<const MaterialState*>& states,
+                                  const vector<Array>& Jvv) const override;
+
     /** This function returns an indicative temperature of the material mix when it would be
         embedded in a given radiation field. For dust mixes, it returns the equilibrium temperature
         \f$T_{\text{eq}}\f$ of the dust mix (or rather of the representative grain population
@@ -507,6 +522,13 @@ public:
         \f$\theta\f$, discretized on the grid returned by the thetaGrid() function. */
     const Array& sectionsAbspol(double lambda) const override;
 
+    /** This function is intended for use with the SpheroidalPolarization mode. It returns the
+        unnormalized cumulative distribution of the absorption cross sections per entity at
+        wavelength \f$\lambda\f$ over the emission angle \f$\theta\f$, as described for the
+        MaterialMix::cumulativeSectionsAbs() function. The distributions are precalculated during
+        setup for all wavelengths. */
+    const Array& cumulativeSectionsAbs(double lambda) const override;
+
     //======================== Data Members ========================
 
 private:
@@ -516,6 +538,9 @@ private:
     Array _lambdav;   // indexed on ell
     Range _required;  // the required wavelength range, i.e. the range of _lambdav before it was shifted
 
+    // per-thread memory of the most recent conversion from wavelength to index in the above grid
+    WavelengthIndexCache _lambdaIndexCache;
+
     // scattering angle grid
     Array _thetav;  // indexed on t
 
@@ -533,16 +558,18 @@ private:
     Table<2> _S34vv;  // indexed on ell,t
 
     // precalculated discretizations of (functions of) the scattering angles
-    ArrayTable<2> _thetaXvv;  // indexed on ell and t
-    Array _pfnormv;           // indexed on ell
-    Array _phiv;              // indexed on f
-    Array _phi1v;             // indexed on f
-    Array _phisv;             // indexed on f
-    Array _phicv;             // indexed on f
+    ArrayTable<2> _thetaXvv;            // indexed on ell and t
+    vector<vector<int>> _thetaGuidevv;  // indexed on ell and k
+    Array _pfnormv;                     // indexed on ell
+    Array _phiv;                        // indexed on f
+    Array _phi1v;                       // indexed on f
+    Array _phisv;                       // indexed on f
+    Array _phicv;                       // indexed on f
 
     // precalculated discretizations for spheroidal grains as a function of the emission angle
     ArrayTable<2> _sigmaabsvv;     // indexed on ell and t
     ArrayTable<2> _sigmaabspolvv;  // indexed on ell and t
+    ArrayTable<2> _sigmaabscumvv;  // indexed on ell and t
 
     // equilibrium temperature and emission calculator
     EquilibriumDustEmissionCalculator _calc;
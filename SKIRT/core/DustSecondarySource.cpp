@@ -23,12 +23,23 @@
 
 ////////////////////////////////////////////////////////////////////
 
+namespace
+{
+    // the values for the status of the emission spectrum stored for each cell, if applicable
+    const char storedStale = 0;  // the spectrum must be (re)calculated
+    const char storedBusy = 1;   // the spectrum is being calculated and stored by one of the execution threads
+    const char storedValid = 2;  // the spectrum is available for use
+}
+
+////////////////////////////////////////////////////////////////////
+
 double DustSecondarySource::prepareLuminosities()
 {
     // cache some pointers for later use
     _config = find<Configuration>();
     _ms = find<MediumSystem>();
     _random = find<Random>();
+    _generation++;
 
     int numCells = _ms->numCells();
 
@@ -63,6 +74,32 @@ double DustSecondarySource::prepareLuminosities()
     for (int m = 0; m != numCells; ++m)
         if (_nv[m] < 0) _Lv[m] = 0.;
 
+    // --------- reusing emission spectra ---------
+
+    // if so requested, mark the cells for which the stored emission spectrum must be recalculated
+    _reuseTolerance = _config->dustEmissionReuseTolerance();
+    int numRecalculated = 0;
+    if (_reuseTolerance > 0.)
+    {
+        // allocate the data structures the first time around
+        if (_Lrefv.size() != static_cast<size_t>(numCells))
+        {
+            _Lrefv.resize(numCells);
+            _storedevv.resize(numCells);
+            _storedStatev = vector<std::atomic<char>>(numCells);
+        }
+
+        for (int m = 0; m != numCells; ++m)
+        {
+            if (_Lv[m] > 0. && !(abs(_Lv[m] - _Lrefv[m]) <= _reuseTolerance * _Lrefv[m]))
+            {
+                numRecalculated++;
+                _Lrefv[m] = _Lv[m];
+                _storedStatev[m] = storedStale;
+            }
+        }
+    }
+
     // calculate  the total luminosity, and normalize the individual luminosities to unity
     double L = _Lv.sum();
     _Lv /= L;
@@ -80,6 +117,9 @@ double DustSecondarySource::prepareLuminosities()
               + units->ubolluminosity());
     log->info("  Emitting from " + std::to_string(emittingCells) + " out of " + std::to_string(numCells)
               + " spatial cells");
+    if (_reuseTolerance > 0.)
+        log->info("  Recalculating emission spectra for " + std::to_string(numRecalculated) + " out of "
+                  + std::to_string(emittingCells) + " emitting cells");
 
     // library entries
     int numEntries = _config->cellLibrary()->numEntries();
@@ -149,6 +189,9 @@ void DustSecondarySource::preparePacketMap(size_t firstIndex, size_t numIndices)
 
 namespace
 {
+    // the maximum number of cells for which the emission spectrum is calculated in a single batch
+    const size_t maxBatchSize = 8;
+
     // An instance of this class obtains and/or calculates the information needed to launch photon packets
     // from the dust in a given cell in the spatial grid, and remembers the information for fast retrieval.
     // This information includes the normalized regular and cumulative dust emission spectra, calculated from
@@ -165,6 +208,16 @@ namespace
         vector<int> _hv;             // a list of the media indices for the media containing dust
         int _numMedia{0};            // the number of dust media in the system (and thus the size of hv)
         int _numCells{0};            // the number of cells in the spatial grid (and thus the size of mv and nv)
+        int _generation{-1};         // the emission segment for which the information below was calculated
+
+        // emission spectra precalculated for upcoming cells, initialized by calculateIfNeeded()
+        vector<int> _batchpv;      // launch-order indices of the cells in the batch, in increasing order
+        vector<Array> _batchevv;   // emission spectrum for each cell in the batch
+        size_t _batchIndex{0};     // index in the batch of the first cell that has not yet been processed
+
+        // emission spectra stored across emission segments, or null pointers if not applicable
+        vector<Array>* _storedevv{nullptr};                 // the stored emission spectrum for each cell
+        vector<std::atomic<char>>* _storedStatev{nullptr};  // the status of the stored spectrum for each cell
 
         // information on a particular spatial cell, initialized by calculateIfNeeded()
         int _p{-1};                // spatial cell launch-order index
@@ -182,16 +235,32 @@ namespace
         //   p:  launch-order cell index (cells mapped to a given library entry have consecutive p indices)
         //   mv: map from launch-order cell index p to regular cell index m
         //   nv: map from regular cell index m to library entry index n
+        //   Iv: map from launch-order cell index p to first history index
         //   ms: medium system
         //   config: configuration object
-        void calculateIfNeeded(int p, const vector<int>& mv, const vector<int>& nv, MediumSystem* ms,
-                               Configuration* config)
+        //   generation: emission segment counter
+        //   storedevv, storedStatev: emission spectra stored across segments, or null pointers if not applicable
+        void calculateIfNeeded(int p, const vector<int>& mv, const vector<int>& nv, const vector<size_t>& Iv,
+                               MediumSystem* ms, Configuration* config, int generation, vector<Array>* storedevv,
+                               vector<std::atomic<char>>* storedStatev)
         {
-            // when called for the first time for a given simulation, cache some info
-            if (_ms != ms)
+            _storedevv = storedevv;
+            _storedStatev = storedStatev;
+
+            // when called for the first time for a given emission segment, forget any previously calculated info
+            if (_ms != ms || _generation != generation)
             {
+                _generation = generation;
                 _p = -1;
                 _n = -1;
+                _batchpv.clear();
+                _batchevv.clear();
+                _batchIndex = 0;
+            }
+
+            // when called for the first time for a given simulation, cache some info
+            if (_ms != ms)
+            {
                 _ms = ms;
                 auto wavelengthGrid = config->dustEmissionWLG();
                 _wavelengthGrid = wavelengthGrid->extlambdav();
@@ -226,7 +295,7 @@ namespace
                 // if only a single cell maps to the library entry, we can simply calculate its emission
                 if (numMappedCells == 1)
                 {
-                    calculateSingleSpectrum(m);
+                    calculateSingleSpectrum(p, mv, nv, Iv);
                 }
 
                 // if multiple cells map to the library entry, we use the average radiation field for these cells
@@ -273,17 +342,68 @@ namespace
         }
 
     private:
-        // calculate the emission spectrum for the dust mixes of the specified cell,
-        // and store the result in the data members _lambdav, _pv, _Pv
-        void calculateSingleSpectrum(int m)
+        // calculate the emission spectrum for the dust mixes of the cell with the specified launch-order index,
+        // which is the only cell mapped to its library entry, and store the result in the data members _lambdav,
+        // _pv, _Pv; the emission spectra are calculated in batches that include upcoming cells mapped to their
+        // own library entry and launching photon packets, because this allows the material mixes to vectorize
+        // the calculation across cells
+        void calculateSingleSpectrum(int p, const vector<int>& mv, const vector<int>& nv, const vector<size_t>& Iv)
         {
-            // get the emmissivity spectrum for all dust medium components in the cell
-            const Array& ev = _ms->dustEmissionSpectrum(m);
+            // skip any cells in the current batch that were handled by other threads
+            while (_batchIndex < _batchpv.size() && _batchpv[_batchIndex] < p) _batchIndex++;
+
+            // if the cell is not in the current batch, use the stored spectrum if it is still valid,
+            // or otherwise calculate a new batch starting with this cell
+            if (_batchIndex == _batchpv.size() || _batchpv[_batchIndex] != p)
+            {
+                if (isStored(mv[p]))
+                {
+                    const Array& ev = (*_storedevv)[mv[p]];
+                    NR::cdf<NR::interpolateLogLog>(_lambdav, _pv, _Pv, _wavelengthGrid, ev, _wavelengthRange);
+                    return;
+                }
+
+                _batchpv.assign(1, p);
+                for (int q = p + 1; q < _numCells && _batchpv.size() < maxBatchSize; ++q)
+                {
+                    int n = nv[mv[q]];
+                    if (Iv[q + 1] > Iv[q] && n >= 0 && nv[mv[q - 1]] != n && (q + 1 == _numCells || nv[mv[q + 1]] != n)
+                        && !isStored(mv[q]))
+                        _batchpv.push_back(q);
+                }
+                vector<int> batchmv;
+                for (int q : _batchpv) batchmv.push_back(mv[q]);
+                _batchevv = _ms->dustEmissionSpectra(batchmv);
+                _batchIndex = 0;
+
+                // if applicable, store the spectra for use by subsequent emission segments; if another thread
+                // is storing or has stored the spectrum for a given cell, leave it alone
+                if (_storedevv)
+                {
+                    for (size_t i = 0; i != batchmv.size(); ++i)
+                    {
+                        int m = batchmv[i];
+                        char expected = storedStale;
+                        if ((*_storedStatev)[m].compare_exchange_strong(expected, storedBusy))
+                        {
+                            (*_storedevv)[m] = _batchevv[i];
+                            (*_storedStatev)[m].store(storedValid, std::memory_order_release);
+                        }
+                    }
+                }
+            }
 
             // calculate the normalized plain and cumulative distributions
+            const Array& ev = _batchevv[_batchIndex];
             NR::cdf<NR::interpolateLogLog>(_lambdav, _pv, _Pv, _wavelengthGrid, ev, _wavelengthRange);
         }
 
+        // returns true if a valid emission spectrum is stored for the specified cell
+        bool isStored(int m) const
+        {
+            return _storedevv && (*_storedStatev)[m].load(std::memory_order_acquire) == storedValid;
+        }
+
         // calculate the emission spectrum for the specified radiation field and the dust mixes of the specified cell,
         // and store the result in the data members _lambdav, _pv, _Pv
         void calculateSingleSpectrum(const Array& Jv, int m)
@@ -343,9 +463,11 @@ namespace
         // information on a particular spatial cell, initialized by calculateIfNeeded()
         int _m{-1};              // spatial cell index
         Direction _B_direction;  // direction of the magnetic field
+        vector<double> _nv;      // number density in the cell for each dust medium
 
         // information on a particular photon packet, initialized by calculateIfNeeded()
-        double _lambda{-1.};  // wavelength of the photon packet
+        double _lambda{-1.};        // wavelength of the photon packet
+        vector<const Array*> _Cvv;  // cumulative absorption cross sections over zenith angle for each dust medium
 
     public:
         // instances of this class are allocated in thread-local storage, which means that the constructor is
@@ -356,24 +478,31 @@ namespace
         // if it is different from what's already stored
         void calculateIfNeeded(int m, MediumSystem* ms, double lambda)
         {
-            // always remember the photon packet wavelength
-            _lambda = lambda;
-
-            // if this packet is launched from the same cell as the previous one, we don't need to do anything else
-            if (m == _m) return;
-
             // when called for the first time, cache some info
             if (_m == -1)
             {
                 _ms = ms;
                 _hv = ms->dustMediumIndices();
+                _nv.resize(_hv.size());
+                _Cvv.resize(_hv.size());
             }
 
-            // remember the new cell index and map to the other indices
-            _m = m;
+            // if this packet is launched from a different cell than the previous one, obtain the cell properties
+            if (m != _m)
+            {
+                // remember the new cell index and map to the other indices
+                _m = m;
+
+                // normalise the magnetic field direction
+                _B_direction.set(_ms->magneticField(_m), true);
+
+                // remember the number density for each dust medium
+                for (size_t i = 0; i != _hv.size(); ++i) _nv[i] = _ms->numberDensity(_m, _hv[i]);
+            }
 
-            // normalise the magnetic field direction
-            _B_direction.set(_ms->magneticField(_m), true);
+            // always remember the photon packet wavelength and the corresponding precalculated distributions
+            _lambda = lambda;
+            for (size_t i = 0; i != _hv.size(); ++i) _Cvv[i] = &_ms->mix(_m, _hv[i])->cumulativeSectionsAbs(lambda);
         }
 
         // this AngularDistributionInterface implementation returns the probability for the given direction
@@ -408,37 +537,29 @@ namespace
             const double phi = 2. * M_PI * random->uniform();
 
             // now generate a random zenith angle
-            // first, compute the cumulative distribution for a photon at the given wavelength
-            // create empty PDF and CDF arrays with the same size as the zenith angle grid
+            // the unnormalized cumulative distribution for a photon at the given wavelength is the density-weighted
+            // sum of the distributions precalculated by the dust mixes, which we evaluate only where needed
             const Array& thetas = _ms->mix(_m, _hv[0])->thetaGrid();
-            Array pdf(thetas.size()), cdf(thetas.size());
-            // add the distributions for the different components
-            for (int h : _hv)
+            size_t numMedia = _hv.size();
+            auto cumulative = [this, numMedia](int t) {
+                double C = 0.;
+                for (size_t i = 0; i != numMedia; ++i) C += _nv[i] * (*_Cvv[i])[t];
+                return C;
+            };
+            // locate the bin containing a random value in the distribution by bisection, and interpolate
+            int il = 0;
+            int iu = thetas.size() - 1;
+            double X = random->uniform() * cumulative(iu);
+            while (iu - il > 1)
             {
-                const Array& Qabs = _ms->mix(_m, h)->sectionsAbs(_lambda);
-                pdf += _ms->numberDensity(_m, h) * Qabs;
-            }
-            // the CDF is computed from the PDF by integration
-            // since this is an integration is spherical coordinates, we need to
-            // multiply the PDF with the volume element sin(theta)
-            for (size_t i = 0; i < thetas.size(); ++i)
-            {
-                pdf[i] *= std::sin(thetas[i]);
-            }
-            // convert to the CDF
-            // note that we use the midpoint of each bin as integration point
-            // and omit the common factors from the integration
-            for (size_t i = 1; i < thetas.size(); ++i)
-            {
-                cdf[i] = cdf[i - 1] + pdf[i - 1] + pdf[i];
-            }
-            // normalise the CDF
-            for (size_t i = 0; i < thetas.size(); ++i)
-            {
-                cdf[i] /= cdf[thetas.size() - 1];
+                int im = (iu + il) >> 1;
+                if (X >= cumulative(im))
+                    il = im;
+                else
+                    iu = im;
             }
-            // draw a random zenith angle from the CDF
-            const double theta = random->cdfLinLin(thetas, cdf);
+            const double theta =
+                NR::interpolateLinLin(X, cumulative(il), cumulative(il + 1), thetas[il], thetas[il + 1]);
 
             // generate a random direction
             const Direction krand(theta, phi);
@@ -518,7 +639,9 @@ void DustSecondarySource::launch(PhotonPacket* pp, size_t historyIndex, double L
     double ws = _Lv[m] / _Wv[m];
 
     // calculate the emission spectrum and bulk velocity for this cell, if not already available
-    t_dustcell.calculateIfNeeded(p, _mv, _nv, _ms, _config);
+    bool reuse = _reuseTolerance > 0.;
+    t_dustcell.calculateIfNeeded(p, _mv, _nv, _Iv, _ms, _config, _generation, reuse ? &_storedevv : nullptr,
+                                 reuse ? &_storedStatev : nullptr);
 
     // generate a random wavelength from the emission spectrum for the cell and/or from the bias distribution
     double lambda, w;
@@ -8,6 +8,7 @@
 
 #include "Array.hpp"
 #include "SecondarySource.hpp"
+#include <atomic>
 class Configuration;
 class MediumSystem;
 class PhotonPacket;
@@ -32,7 +33,15 @@ public:
 
 public:
     /** This function calculates and stores the bolometric dust luminosities in each spatial cell
-        of the simulation, and returns the total bolometric dust luminosity. */
+        of the simulation, and returns the total bolometric dust luminosity.
+
+        If the user configured a nonzero tolerance for reusing emission spectra, this function also
+        determines the cells for which the emission spectrum calculated during a previous secondary
+        emission segment, if any, can be reused. The spectrum of a cell is recalculated if its
+        absorbed luminosity has changed by more than the tolerance, relative to the absorbed
+        luminosity at the time of the most recent recalculation. Comparing with the latter value
+        rather than with the value for the previous segment avoids accumulating small changes over
+        many segments. The number of cells marked for recalculation is logged. */
     double prepareLuminosities() override;
 
     /** This function prepares the mapping of history indices to spatial cells, given the range of
@@ -58,6 +67,14 @@ public:
         requirements are limited to storing the information for only a single cell per execution
         thread, and the calculation is still performed only once per cell.
 
+        If the user configured a nonzero tolerance for reusing emission spectra, the function does
+        store the emission spectrum for each cell, so that the spectrum can be reused by subsequent
+        secondary emission segments as long as the absorbed luminosity in the cell does not change
+        significantly (see the prepareLuminosities() function). This requires memory proportional
+        to both the number of cells and the number of dust emission wavelengths. The option is
+        allowed only with a cell library that maps each cell to its own entry, so that every
+        emitting cell has its own spectrum.
+
         Once the emission spectrum for the current cell is known, the function randomly generates a
         wavelength either from this emission spectrum or from the configured bias wavelength
         distribution, adjusting the launch weight with the proper bias factor. It then generates a
@@ -84,6 +101,13 @@ private:
     vector<int> _nv;     // the library entry index corresponding to each spatial cell (i.e. map from cells to entries)
     vector<int> _mv;     // the spatial cell indices sorted so that cells belonging to the same entry are consecutive
     vector<size_t> _Iv;  // first history index allocated to each spatial cell (with extra entry at the end)
+    int _generation{0};  // incremented for each emission segment to invalidate information cached per thread
+
+    // initialized by prepareLuminosities() and used only if emission spectra are reused between segments
+    double _reuseTolerance{0.};                       // the tolerance for reusing emission spectra
+    Array _Lrefv;                                     // the absorbed luminosity of each cell at the last recalculation
+    mutable vector<Array> _storedevv;                 // the stored emission spectrum for each cell
+    mutable vector<std::atomic<char>> _storedStatev;  // the status of the stored emission spectrum for each cell
 };
 
 ////////////////////////////////////////////////////////////////
@@ -49,6 +49,11 @@ void EquilibriumDustEmissionCalculator::precalculate(SimulationItem* item, const
             auto dustEmissionWLG = config->dustEmissionWLG();
             dustEmissionWLG->setup();
             _emlambdav = dustEmissionWLG->extlambdav();
+
+            // precalculate the temperature-independent front factors of the Planck function on this grid
+            int numWavelengths = _emlambdav.size();
+            _emfrontv.resize(numWavelengths);
+            for (int ell = 0; ell != numWavelengths; ++ell) _emfrontv[ell] = PlanckFunction::front(_emlambdav[ell]);
         }
 
         // build the temperature grid on which we store the Planck-integrated absorption cross sections
@@ -101,6 +106,7 @@ size_t EquilibriumDustEmissionCalculator::allocatedBytes() const
     allocatedSize += _rfdlambdav.size();
     allocatedSize += _Bcmbv.size();
     allocatedSize += _emlambdav.size();
+    allocatedSize += _emfrontv.size();
     allocatedSize += _Tv.size();
     if (!_rfsigmaabsvv.empty()) allocatedSize += _rfsigmaabsvv.size() * _rfsigmaabsvv[0].size();
     if (!_emsigmaabsvv.empty()) allocatedSize += _emsigmaabsvv.size() * _emsigmaabsvv[0].size();
@@ -143,10 +149,60 @@ Array EquilibriumDustEmissionCalculator::emissivity(const Array& Jv) const
         PlanckFunction B(T);
         for (int ell = 0; ell < numWavelengths; ell++)
         {
-            ev[ell] += _emsigmaabsvv[b][ell] * B(_emlambdav[ell]);
+            ev[ell] += _emsigmaabsvv[b][ell] * B.value(_emlambdav[ell], _emfrontv[ell]);
         }
     }
     return ev;
 }
 
 ////////////////////////////////////////////////////////////////////
+
+vector<Array> EquilibriumDustEmissionCalculator::emissivities(const vector<Array>& Jvv) const
+{
+    int numWavelengths = _emlambdav.size();
+    int numBins = _rfsigmaabsvv.size();
+    int numFields = Jvv.size();
+    int numRF = _rflambdav.size();
+
+    // transpose the radiation fields including the CMB source term, so that the values for all fields
+    // at a given wavelength are consecutive in memory
+    Array JBvv(numRF * numFields);
+    for (int i = 0; i != numFields; ++i)
+        for (int k = 0; k != numRF; ++k) JBvv[k * numFields + i] = Jvv[i][k] + _Bcmbv[k];
+
+    vector<Array> evv(numFields, Array(numWavelengths));
+    Array inputabsv(numFields);
+    for (int b = 0; b != numBins; ++b)
+    {
+        // integrate the input side of the energy balance equation for all fields at the same time;
+        // the terms are accumulated in reverse order to reproduce the result of the valarray sum() function
+        // used by the equilibriumTemperature() function
+        const Array& sigmaabsv = _rfsigmaabsvv[b];
+        for (int k = numRF - 1; k >= 0; --k)
+        {
+            double sigmaabs = sigmaabsv[k];
+            double dlambda = _rfdlambdav[k];
+            const double* JBv = &JBvv[k * numFields];
+            if (k == numRF - 1)
+                for (int i = 0; i != numFields; ++i) inputabsv[i] = sigmaabs * JBv[i] * dlambda;
+            else
+                for (int i = 0; i != numFields; ++i) inputabsv[i] += sigmaabs * JBv[i] * dlambda;
+        }
+
+        // find the corresponding temperatures and accumulate the emissivities
+        for (int i = 0; i != numFields; ++i)
+        {
+            double inputabs = inputabsv[i];
+            double T = inputabs > 0. ? NR::clampedValue<NR::interpolateLinLin>(inputabs, _planckabsvv[b], _Tv) : 0.;
+            PlanckFunction B(T);
+            Array& ev = evv[i];
+            for (int ell = 0; ell < numWavelengths; ell++)
+            {
+                ev[ell] += _emsigmaabsvv[b][ell] * B.value(_emlambdav[ell], _emfrontv[ell]);
+            }
+        }
+    }
+    return evv;
+}
+
+////////////////////////////////////////////////////////////////////
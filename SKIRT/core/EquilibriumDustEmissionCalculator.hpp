@@ -98,6 +98,15 @@ public:
         behavior of this function is undefined. */
     Array emissivity(const Array& Jv) const;
 
+    /** This function returns the emissivity spectra per hydrogen atom for a batch of radiation
+        fields, for example corresponding to a block of spatial cells. Each of the input radiation
+        fields and output emissivity spectra is discretized as described for the emissivity()
+        function, and the results are identical to those returned by that function for each of
+        the radiation fields separately. However, the integration of the energy balance equation
+        is performed for all radiation fields in the batch at the same time, organized so that the
+        compiler can vectorize the calculation across radiation fields. */
+    vector<Array> emissivities(const vector<Array>& Jvv) const;
+
     //======================== Data Members ========================
 
 private:
@@ -105,6 +114,7 @@ private:
     Array _rfdlambdav;  // radiation field wavelength grid bin widths -- indexed on k
     Array _Bcmbv;       // cosmic microwave background radiation field, or zeroes -- indexed on k
     Array _emlambdav;   // dust emission wavelength grid (EMWLG) -- indexed on ell
+    Array _emfrontv;    // Planck function front factors on the dust emission wavelength grid -- indexed on ell
     Array _Tv;          // temperature grid for the integrated absorption cross sections -- indexed on p
 
     vector<Array> _rfsigmaabsvv;  // absorption cross sections on the RFWLG for each bin -- indexed on b,k
@@ -7,6 +7,8 @@
 #include "FatalError.hpp"
 #include "FilePaths.hpp"
 #include "Log.hpp"
+#include "Parallel.hpp"
+#include "ParallelFactory.hpp"
 #include "ProcessManager.hpp"
 #include "System.hpp"
 #include "fitsio.h"
@@ -51,6 +53,28 @@ void FITSInOut::write(const SimulationItem* item, string description, string fil
 
 ////////////////////////////////////////////////////////////////////
 
+void FITSInOut::write(const SimulationItem* item, string description, string filename, FrameProducer produceFrame,
+                      string dataUnits, int nx, int ny, double incx, double incy, double xc, double yc, string xyUnits,
+                      const Array& z, string zUnits, const ObserverInfo* obsInfo)
+{
+    // Only write the FITS file if this process is the root
+    if (ProcessManager::isRoot())
+    {
+        // Determine the path of the output FITS file
+        string filepath = item->find<FilePaths>()->output(filename + ".fits");
+
+        // Write the FITS file, producing a batch of frames with one frame per execution thread
+        auto factory = item->find<ParallelFactory>();
+        FITSInOut::write(filepath, produceFrame, factory->parallelLocal(), factory->maxThreadCount(), dataUnits, nx, ny,
+                         incx, incy, xc, yc, xyUnits, z, zUnits, obsInfo);
+
+        // Log the file path
+        item->find<Log>()->info(item->typeAndName() + " wrote " + description + " to FITS file " + filepath);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
 namespace
 {
     // mutex to guard the FITS input/output operations
@@ -104,6 +128,96 @@ void FITSInOut::read(string filepath, Array& data, int& nx, int& ny, int& nz)
 
 ////////////////////////////////////////////////////////////////////
 
+namespace
+{
+    // function to create a FITS file with a primary image of the specified dimensions and to write its header;
+    // the caller must hold the global lock
+    fitsfile* createImage(string filepath, string dataUnits, int nx, int ny, int nz, double incx, double incy,
+                          double xc, double yc, string xyUnits, string zUnits, const FITSInOut::ObserverInfo* obsInfo)
+    {
+        long naxes[3] = {nx, ny, nz};
+
+        // Generate time stamp
+        string stamp = System::timestamp(true);
+        stamp.erase(19);  // remove milliseconds
+
+        // Remove any existing file with the same name
+        remove(filepath.c_str());
+
+        // Create the fits file
+        int status = 0;
+        fitsfile* fptr;
+        ffdkinit(&fptr, filepath.c_str(), &status);
+        if (status) report_error(filepath, "creating", status);
+
+        // Create the primary image (32-bit floating point pixels)
+        ffcrim(fptr, FLOAT_IMG, (nz ? 3 : 2), naxes, &status);
+        if (status) report_error(filepath, "creating", status);
+
+        // Add the relevant keywords
+        ffpkyg(fptr, "BSCALE", 1., 0, "Array value scale", &status);
+        ffpkyg(fptr, "BZERO", 0., 0, "Array value offset", &status);
+        ffpkys(fptr, "DATE", const_cast<char*>(stamp.c_str()), "Date and time of creation (UTC)", &status);
+        ffpkys(fptr, "ORIGIN", const_cast<char*>("SKIRT simulation"), "Astronomical Observatory, Ghent University",
+               &status);
+        ffpkys(fptr, "BUNIT", const_cast<char*>(dataUnits.c_str()), "Physical unit of the array values", &status);
+        ffpkyd(fptr, "CRPIX1", (nx + 1) / 2., 9, "X-axis coordinate system reference pixel", &status);
+        ffpkyd(fptr, "CRVAL1", xc, 9, "Coordinate value at X-axis reference pixel", &status);
+        ffpkyd(fptr, "CDELT1", incx, 9, "Coordinate increment along X-axis", &status);
+        ffpkys(fptr, "CUNIT1", const_cast<char*>(xyUnits.c_str()), "Physical units of the X-axis", &status);
+        ffpkys(fptr, "CTYPE1", " ", "Linear X coordinates", &status);
+        ffpkyd(fptr, "CRPIX2", (ny + 1) / 2., 9, "Y-axis coordinate system reference pixel", &status);
+        ffpkyd(fptr, "CRVAL2", yc, 9, "Coordinate value at Y-axis reference pixel", &status);
+        ffpkyd(fptr, "CDELT2", incy, 9, "Coordinate increment along Y-axis", &status);
+        ffpkys(fptr, "CUNIT2", const_cast<char*>(xyUnits.c_str()), "Physical units of the Y-axis", &status);
+        ffpkys(fptr, "CTYPE2", " ", "Linear Y coordinates", &status);
+        if (nz) ffpkys(fptr, "CUNIT3", const_cast<char*>(zUnits.c_str()), "Physical units of the Z-axis", &status);
+        if (obsInfo)
+        {
+            ffpkyd(fptr, "CROTA1", obsInfo->inclination, 9, "Inclination angle, in deg", &status);
+            ffpkyd(fptr, "CROTA2", obsInfo->azimuth, 9, "Azimuth angle, in deg", &status);
+            ffpkyd(fptr, "CROTA3", obsInfo->roll, 9, "Roll angle, in deg", &status);
+            ffpkyd(fptr, "REDSHIFT", obsInfo->redshift, 9, "Redshift (if zero, distances are equal)", &status);
+            ffpkyd(fptr, "DISTLUMI", obsInfo->luminosityDistance, 9, "Luminosity distance", &status);
+            ffpkyd(fptr, "DISTANGD", obsInfo->angularDiameterDistance, 9, "Angular diameter distance", &status);
+            ffpkys(fptr, "DISTUNIT", const_cast<char*>(obsInfo->distanceUnits.c_str()), "Units of distances",
+                   &status);
+        }
+        if (status) report_error(filepath, "writing", status);
+        return fptr;
+    }
+
+    // function to write the z-axis grid points (if any) to a table extension and to close the FITS file;
+    // the caller must hold the global lock
+    void closeImage(fitsfile* fptr, string filepath, const Array& z, string zUnits)
+    {
+        int status = 0;
+
+        // If the data has 3 dimensions, write a FITS table extension with the values of the third axis
+        int nz = z.size();
+        if (nz)
+        {
+            // Create the table
+            char* ttypev[] = {const_cast<char*>("GRID_POINTS")};
+            char* tformv[] = {const_cast<char*>("E16.9")};
+            char* tunitv[] = {const_cast<char*>(zUnits.c_str())};
+            ffcrtb(fptr, ASCII_TBL, 0, 1, ttypev, tformv, tunitv, "Z-axis coordinate values", &status);
+            if (status) report_error(filepath, "writing", status);
+
+            // Write the single column
+            void* gridpoints = const_cast<void*>(static_cast<const void*>(begin(z)));
+            ffpcl(fptr, TDOUBLE, 1, 1, 1, nz, gridpoints, &status);
+            if (status) report_error(filepath, "writing", status);
+        }
+
+        // Close the file
+        ffclos(fptr, &status);
+        if (status) report_error(filepath, "writing", status);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
 void FITSInOut::write(string filepath, const Array& data, string dataUnits, int nx, int ny, double incx, double incy,
                       double xc, double yc, string xyUnits, const Array& z, string zUnits, const ObserverInfo* obsInfo)
 {
@@ -117,82 +231,64 @@ void FITSInOut::write(string filepath, const Array& data, string dataUnits, int
     size_t nelements = data.size();
     if (nelements != static_cast<size_t>(nx) * static_cast<size_t>(ny) * static_cast<size_t>(nz ? nz : 1))
         throw FATALERROR("Inconsistent data size when creating FITS file " + filepath);
-    long naxes[3] = {nx, ny, nz};
 
     // Acquire a global lock since the cfitsio library is not guaranteed to be reentrant
     // (only when it is built with ./configure --enable-reentrant; make)
     std::unique_lock<std::mutex> lock(_mutex);
 
-    // Generate time stamp
-    string stamp = System::timestamp(true);
-    stamp.erase(19);  // remove milliseconds
-
-    // Remove any existing file with the same name
-    remove(filepath.c_str());
-
-    // Create the fits file
-    int status = 0;
-    fitsfile* fptr;
-    ffdkinit(&fptr, filepath.c_str(), &status);
-    if (status) report_error(filepath, "creating", status);
-
-    // Create the primary image (32-bit floating point pixels)
-    ffcrim(fptr, FLOAT_IMG, (nz ? 3 : 2), naxes, &status);
-    if (status) report_error(filepath, "creating", status);
-
-    // Add the relevant keywords
-    ffpkyg(fptr, "BSCALE", 1., 0, "Array value scale", &status);
-    ffpkyg(fptr, "BZERO", 0., 0, "Array value offset", &status);
-    ffpkys(fptr, "DATE", const_cast<char*>(stamp.c_str()), "Date and time of creation (UTC)", &status);
-    ffpkys(fptr, "ORIGIN", const_cast<char*>("SKIRT simulation"), "Astronomical Observatory, Ghent University",
-           &status);
-    ffpkys(fptr, "BUNIT", const_cast<char*>(dataUnits.c_str()), "Physical unit of the array values", &status);
-    ffpkyd(fptr, "CRPIX1", (nx + 1) / 2., 9, "X-axis coordinate system reference pixel", &status);
-    ffpkyd(fptr, "CRVAL1", xc, 9, "Coordinate value at X-axis reference pixel", &status);
-    ffpkyd(fptr, "CDELT1", incx, 9, "Coordinate increment along X-axis", &status);
-    ffpkys(fptr, "CUNIT1", const_cast<char*>(xyUnits.c_str()), "Physical units of the X-axis", &status);
-    ffpkys(fptr, "CTYPE1", " ", "Linear X coordinates", &status);
-    ffpkyd(fptr, "CRPIX2", (ny + 1) / 2., 9, "Y-axis coordinate system reference pixel", &status);
-    ffpkyd(fptr, "CRVAL2", yc, 9, "Coordinate value at Y-axis reference pixel", &status);
-    ffpkyd(fptr, "CDELT2", incy, 9, "Coordinate increment along Y-axis", &status);
-    ffpkys(fptr, "CUNIT2", const_cast<char*>(xyUnits.c_str()), "Physical units of the Y-axis", &status);
-    ffpkys(fptr, "CTYPE2", " ", "Linear Y coordinates", &status);
-    if (nz) ffpkys(fptr, "CUNIT3", const_cast<char*>(zUnits.c_str()), "Physical units of the Z-axis", &status);
-    if (obsInfo)
-    {
-        ffpkyd(fptr, "CROTA1", obsInfo->inclination, 9, "Inclination angle, in deg", &status);
-        ffpkyd(fptr, "CROTA2", obsInfo->azimuth, 9, "Azimuth angle, in deg", &status);
-        ffpkyd(fptr, "CROTA3", obsInfo->roll, 9, "Roll angle, in deg", &status);
-        ffpkyd(fptr, "REDSHIFT", obsInfo->redshift, 9, "Redshift (if zero, distances are equal)", &status);
-        ffpkyd(fptr, "DISTLUMI", obsInfo->luminosityDistance, 9, "Luminosity distance", &status);
-        ffpkyd(fptr, "DISTANGD", obsInfo->angularDiameterDistance, 9, "Angular diameter distance", &status);
-        ffpkys(fptr, "DISTUNIT", const_cast<char*>(obsInfo->distanceUnits.c_str()), "Units of distances", &status);
-    }
-    if (status) report_error(filepath, "writing", status);
+    // Create the fits file and write the header
+    fitsfile* fptr = createImage(filepath, dataUnits, nx, ny, nz, incx, incy, xc, yc, xyUnits, zUnits, obsInfo);
 
     // Write the array of pixels to the image
+    int status = 0;
     ffpprd(fptr, 0, 1, nelements, const_cast<double*>(&data[0]), &status);
     if (status) report_error(filepath, "writing", status);
 
-    // If the data has 3 dimensions, write a FITS table extension with the values of the third axis
-    if (nz)
+    // Write the z-axis grid points, if any, and close the file
+    closeImage(fptr, filepath, z, zUnits);
+}
+
+////////////////////////////////////////////////////////////////////
+
+void FITSInOut::write(string filepath, FrameProducer produceFrame, Parallel* parallel, int batchSize, string dataUnits,
+                      int nx, int ny, double incx, double incy, double xc, double yc, string xyUnits, const Array& z,
+                      string zUnits, const ObserverInfo* obsInfo)
+{
+    // Get the z-axis size and the number of values in a frame
+    int nz = z.size();
+    if (!nz) throw FATALERROR("Missing z-axis grid points when creating FITS file " + filepath);
+    size_t frameSize = static_cast<size_t>(nx) * static_cast<size_t>(ny);
+    batchSize = max(1, min(batchSize, nz));
+
+    // Create the fits file and write the header, holding the global lock
+    fitsfile* fptr = nullptr;
     {
-        // Create the table
-        char* ttypev[] = {const_cast<char*>("GRID_POINTS")};
-        char* tformv[] = {const_cast<char*>("E16.9")};
-        char* tunitv[] = {const_cast<char*>(zUnits.c_str())};
-        ffcrtb(fptr, ASCII_TBL, 0, 1, ttypev, tformv, tunitv, "Z-axis coordinate values", &status);
-        if (status) report_error(filepath, "writing", status);
+        std::unique_lock<std::mutex> lock(_mutex);
+        fptr = createImage(filepath, dataUnits, nx, ny, nz, incx, incy, xc, yc, xyUnits, zUnits, obsInfo);
+    }
 
-        // Write the single column
-        void* gridpoints = const_cast<void*>(static_cast<const void*>(begin(z)));
-        ffpcl(fptr, TDOUBLE, 1, 1, 1, nz, gridpoints, &status);
-        if (status) report_error(filepath, "writing", status);
+    // Produce the frames in batches without holding the global lock, and write each batch holding the lock
+    vector<Array> frames(batchSize);
+    for (Array& frame : frames) frame.resize(frameSize);
+    for (int kbegin = 0; kbegin < nz; kbegin += batchSize)
+    {
+        int numFrames = min(batchSize, nz - kbegin);
+        parallel->call(numFrames, [&frames, &produceFrame, kbegin](size_t firstIndex, size_t numIndices) {
+            for (size_t i = firstIndex; i != firstIndex + numIndices; ++i) produceFrame(kbegin + i, frames[i]);
+        });
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (int i = 0; i != numFrames; ++i)
+        {
+            int status = 0;
+            ffpprd(fptr, 0, 1 + (kbegin + i) * frameSize, frameSize, &frames[i][0], &status);
+            if (status) report_error(filepath, "writing", status);
+        }
     }
 
-    // Close the file
-    ffclos(fptr, &status);
-    if (status) report_error(filepath, "writing", status);
+    // Write the z-axis grid points and close the file, holding the global lock
+    std::unique_lock<std::mutex> lock(_mutex);
+    closeImage(fptr, filepath, z, zUnits);
 }
 
 ////////////////////////////////////////////////////////////////////
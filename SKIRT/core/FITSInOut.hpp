@@ -7,6 +7,8 @@
 #define FITINSOUT_HPP
 
 #include "Array.hpp"
+#include <functional>
+class Parallel;
 class SimulationItem;
 
 ////////////////////////////////////////////////////////////////////
@@ -51,6 +53,28 @@ public:
                       string dataUnits, int nx, int ny, double incx, double incy, double xc, double yc, string xyUnits,
                       const Array& z = Array(), string zUnits = string(), const ObserverInfo* obsInfo = nullptr);
 
+    /** This is the type of the callback function used by the streaming version of the write()
+        function to obtain the values in a given frame of a data cube. The function receives the
+        index \em k of the frame in the cube and a data array with \f$n_x\times n_y\f$ elements
+        that it must fill with the values of that frame, using the same ordering as the frames in
+        a complete data cube. */
+    using FrameProducer = std::function<void(int k, Array& frame)>;
+
+    /** This function writes a 3D data cube to a FITS file in the context of the simulation item
+        hierarchy specified through the first argument, like the write() function described above.
+        However, rather than receiving the complete data cube, the function obtains the values for
+        each frame by invoking the \em produceFrame callback function and writes the frames to the
+        file as they become available. The number of frames is given by the size of the \em z
+        array. The callback function is invoked in parallel for distinct frames, so that it can
+        perform per-frame calculations such as calibration or unit conversion concurrently; it
+        must thus be thread-safe. At any given time, this function holds at most a single frame
+        per execution thread in memory, so that peak memory usage remains limited even for very
+        large data cubes. The remaining arguments are the same as those for the write() function
+        described above. */
+    static void write(const SimulationItem* item, string description, string filename, FrameProducer produceFrame,
+                      string dataUnits, int nx, int ny, double incx, double incy, double xc, double yc, string xyUnits,
+                      const Array& z, string zUnits, const ObserverInfo* obsInfo = nullptr);
+
     // ================== Basic read/write ==================
 
 private:
@@ -104,6 +128,15 @@ private:
         data structure holding observer information (or the null pointer). */
     static void write(string filepath, const Array& data, string dataUnits, int nx, int ny, double incx, double incy,
                       double xc, double yc, string xyUnits, const Array& z, string zUnits, const ObserverInfo* obsInfo);
+
+    /** This function writes a 3D data cube to the primary data unit of a FITS file, obtaining the
+        values frame by frame from the specified callback function. Frames are produced in batches
+        of \em batchSize frames using the specified Parallel instance, and each batch is written to
+        the file before the next one is produced. The remaining arguments are the same as those for
+        the basic write() function described above. */
+    static void write(string filepath, FrameProducer produceFrame, Parallel* parallel, int batchSize, string dataUnits,
+                      int nx, int ny, double incx, double incy, double xc, double yc, string xyUnits, const Array& z,
+                      string zUnits, const ObserverInfo* obsInfo);
 };
 
 ////////////////////////////////////////////////////////////////////
@@ -59,6 +59,26 @@ double FileSSPSEDFamily::specificLuminosity(double wavelength, const Array& para
 
 ////////////////////////////////////////////////////////////////////
 
+void FileSSPSEDFamily::specificLuminosities(Array& Lv, const Array& lambdav, const Array& parameters) const
+{
+    double M = parameters[0] / Constants::Msun();
+    double Z = parameters[1];
+    double t = parameters[2] / Constants::year();
+
+    if (!_hasIonizationParameter)
+    {
+        _table3.valueArray(Lv, lambdav, Z, t);
+    }
+    else
+    {
+        double U = parameters[3];
+        _table4.valueArray(Lv, lambdav, Z, t, U);
+    }
+    Lv *= M;
+}
+
+////////////////////////////////////////////////////////////////////
+
 double FileSSPSEDFamily::cdf(Array& lambdav, Array& pv, Array& Pv, const Range& wavelengthRange,
                              const Array& parameters) const
 {
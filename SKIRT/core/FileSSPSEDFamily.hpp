@@ -77,6 +77,11 @@ public:
         if not the behavior is undefined. */
     double specificLuminosity(double wavelength, const Array& parameters) const override;
 
+    /** This function stores in \em Lv the specific luminosity \f$L_\lambda\f$ for the %SED with
+        the specified parameters at each of the wavelengths in \em lambdav, using the batch
+        interpolation offered by the stored table. */
+    void specificLuminosities(Array& Lv, const Array& lambdav, const Array& parameters) const override;
+
     /** This function constructs both the normalized probability density function (pdf) and the
         corresponding normalized cumulative distribution function (cdf) for the %SED with the
         specified parameters over the specified wavelength range. The function returns the
@@ -6,12 +6,14 @@
 #include "FluxRecorder.hpp"
 #include "FITSInOut.hpp"
 #include "Indices.hpp"
+#include "InstrumentSystem.hpp"
 #include "LockFree.hpp"
 #include "Log.hpp"
 #include "MediumSystem.hpp"
 #include "NR.hpp"
 #include "PhotonPacket.hpp"
 #include "ProcessManager.hpp"
+#include "SourceSystem.hpp"
 #include "StringUtils.hpp"
 #include "TextOutFile.hpp"
 #include "Units.hpp"
@@ -146,10 +148,22 @@ void FluxRecorder::finalizeConfiguration()
     _numPixelsInFrame = _numPixelsX * _numPixelsY;  // convert to size_t before calculating lenIFU
     size_t lenSED = _includeFluxDensity ? _lambdagrid->numBins() : 0;
     size_t lenIFU = _includeSurfaceBrightness ? _numPixelsInFrame * _lambdagrid->numBins() : 0;
+    size_t numFrames = _includeSurfaceBrightness ? _lambdagrid->numBins() : 0;
 
     // do not try to record components if there is no medium
     _recordTotalOnly = !_recordComponents || !_hasMedium;
 
+    // determine the precision of the IFU detector arrays and, for single precision, the factor for scaling
+    // the recorded luminosities to the total source luminosity
+    auto instrumentSystem = _parentItem->find<InstrumentSystem>(false);
+    bool singlePrecision = instrumentSystem && instrumentSystem->recordDataCubesInSinglePrecision();
+    double scale = 1.;
+    if (singlePrecision)
+    {
+        double L = _parentItem->find<SourceSystem>()->luminosity();
+        if (L > 0.) scale = 1. / L;
+    }
+
     // allocate the appropriate number of flux detector arrays
     _sed.resize(PrimaryScatteredLevel + _numScatteringLevels);
     _ifu.resize(PrimaryScatteredLevel + _numScatteringLevels);
@@ -158,40 +172,40 @@ void FluxRecorder::finalizeConfiguration()
     if (_recordTotalOnly)
     {
         _sed[Total].resize(lenSED);
-        _ifu[Total].resize(lenIFU);
+        _ifu[Total].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
     }
     else
     {
         _sed[Transparent].resize(lenSED);
-        _ifu[Transparent].resize(lenIFU);
+        _ifu[Transparent].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
         _sed[PrimaryDirect].resize(lenSED);
-        _ifu[PrimaryDirect].resize(lenIFU);
+        _ifu[PrimaryDirect].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
         _sed[PrimaryScattered].resize(lenSED);
-        _ifu[PrimaryScattered].resize(lenIFU);
+        _ifu[PrimaryScattered].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
 
         for (int i = 0; i != _numScatteringLevels; ++i)
         {
             _sed[PrimaryScatteredLevel + i].resize(lenSED);
-            _ifu[PrimaryScatteredLevel + i].resize(lenIFU);
+            _ifu[PrimaryScatteredLevel + i].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
         }
         if (_hasMediumEmission)
         {
             _sed[SecondaryTransparent].resize(lenSED);
-            _ifu[SecondaryTransparent].resize(lenIFU);
+            _ifu[SecondaryTransparent].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
             _sed[SecondaryDirect].resize(lenSED);
-            _ifu[SecondaryDirect].resize(lenIFU);
+            _ifu[SecondaryDirect].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
             _sed[SecondaryScattered].resize(lenSED);
-            _ifu[SecondaryScattered].resize(lenIFU);
+            _ifu[SecondaryScattered].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
         }
     }
     if (_recordPolarization)
     {
         _sed[TotalQ].resize(lenSED);
-        _ifu[TotalQ].resize(lenIFU);
+        _ifu[TotalQ].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
         _sed[TotalU].resize(lenSED);
-        _ifu[TotalU].resize(lenIFU);
+        _ifu[TotalU].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
         _sed[TotalV].resize(lenSED);
-        _ifu[TotalV].resize(lenIFU);
+        _ifu[TotalV].resize(numFrames, _numPixelsInFrame, singlePrecision, scale);
     }
 
     // allocate and resize the statistics detector arrays
@@ -204,13 +218,13 @@ void FluxRecorder::finalizeConfiguration()
     }
 
     // calculate and log allocated memory size
-    size_t allocatedSize = 0;
-    for (const auto& array : _sed) allocatedSize += array.size();
-    for (const auto& array : _ifu) allocatedSize += array.size();
-    for (const auto& array : _wsed) allocatedSize += array.size();
-    for (const auto& array : _wifu) allocatedSize += array.size();
+    size_t allocatedBytes = 0;
+    for (const auto& array : _sed) allocatedBytes += array.size() * sizeof(double);
+    for (const auto& table : _ifu) allocatedBytes += table.numBytes();
+    for (const auto& array : _wsed) allocatedBytes += array.size() * sizeof(double);
+    for (const auto& array : _wifu) allocatedBytes += array.size() * sizeof(double);
     _parentItem->find<Log>()->info(_parentItem->typeAndName() + " allocated "
-                                   + StringUtils::toMemSizeString(allocatedSize * sizeof(double)) + " of memory");
+                                   + StringUtils::toMemSizeString(allocatedBytes) + " of memory");
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -310,7 +324,7 @@ void FluxRecorder::detect(PhotonPacket* pp, int l, double distance)
 
             if (_recordTotalOnly)
             {
-                LockFree::add(_ifu[Total][lell], Lext);
+                _ifu[Total].add(lell, Lext);
             }
             else
             {
@@ -318,34 +332,34 @@ void FluxRecorder::detect(PhotonPacket* pp, int l, double distance)
                 {
                     if (numScatt == 0)
                     {
-                        LockFree::add(_ifu[Transparent][lell], L);
-                        LockFree::add(_ifu[PrimaryDirect][lell], Lext);
+                        _ifu[Transparent].add(lell, L);
+                        _ifu[PrimaryDirect].add(lell, Lext);
                     }
                     else
                     {
-                        LockFree::add(_ifu[PrimaryScattered][lell], Lext);
+                        _ifu[PrimaryScattered].add(lell, Lext);
                         if (numScatt <= _numScatteringLevels)
-                            LockFree::add(_ifu[PrimaryScatteredLevel + numScatt - 1][lell], Lext);
+                            _ifu[PrimaryScatteredLevel + numScatt - 1].add(lell, Lext);
                     }
                 }
                 else
                 {
                     if (numScatt == 0)
                     {
-                        LockFree::add(_ifu[SecondaryTransparent][lell], L);
-                        LockFree::add(_ifu[SecondaryDirect][lell], Lext);
+                        _ifu[SecondaryTransparent].add(lell, L);
+                        _ifu[SecondaryDirect].add(lell, Lext);
                     }
                     else
                     {
-                        LockFree::add(_ifu[SecondaryScattered][lell], Lext);
+                        _ifu[SecondaryScattered].add(lell, Lext);
                     }
                 }
             }
             if (_recordPolarization)
             {
-                LockFree::add(_ifu[TotalQ][lell], Lext * pp->stokesQ());
-                LockFree::add(_ifu[TotalU][lell], Lext * pp->stokesU());
-                LockFree::add(_ifu[TotalV][lell], Lext * pp->stokesV());
+                _ifu[TotalQ].add(lell, Lext * pp->stokesQ());
+                _ifu[TotalU].add(lell, Lext * pp->stokesU());
+                _ifu[TotalV].add(lell, Lext * pp->stokesV());
             }
         }
 
@@ -381,7 +395,7 @@ void FluxRecorder::calibrateAndWrite()
 {
     // collect recorded data from all processes
     for (auto& array : _sed) ProcessManager::sumToRoot(array);
-    for (auto& array : _ifu) ProcessManager::sumToRoot(array);
+    for (auto& table : _ifu) table.sumToRoot();
     for (auto& array : _wsed) ProcessManager::sumToRoot(array);
     for (auto& array : _wifu) ProcessManager::sumToRoot(array);
 
@@ -397,8 +411,10 @@ void FluxRecorder::calibrateAndWrite()
 
     // convert from recorded quantities to output quantities and from internal units to user-selected output units
     // (for performance reasons, determine the units scaling factor only once for each wavelength)
+    // the IFU frames are calibrated on the fly while they are being written, so here we just remember the factors
     Units* units = _parentItem->find<Units>();
     int numWavelengths = _lambdagrid->numBins();
+    Array ifuFactors(numWavelengths);
     for (int ell = 0; ell != numWavelengths; ++ell)
     {
         // SEDs
@@ -412,13 +428,8 @@ void FluxRecorder::calibrateAndWrite()
         // IFUs
         if (_includeSurfaceBrightness)
         {
-            double factor = 1. / fourpid2 / omega / _lambdagrid->effectiveWidth(ell)
-                            * units->osurfacebrightness(_lambdagrid->wavelength(ell), 1.);
-            size_t begin = ell * _numPixelsInFrame;
-            size_t end = begin + _numPixelsInFrame;
-            for (auto& array : _ifu)
-                if (array.size())
-                    for (size_t lell = begin; lell != end; ++lell) array[lell] *= factor;
+            ifuFactors[ell] = 1. / fourpid2 / omega / _lambdagrid->effectiveWidth(ell)
+                              * units->osurfacebrightness(_lambdagrid->wavelength(ell), 1.);
         }
     }
 
@@ -537,20 +548,20 @@ void FluxRecorder::calibrateAndWrite()
     // write IFUs to FITS files (one file per IFU)
     if (_includeSurfaceBrightness)
     {
-        // Build a list of file names and corresponding pointers to ifu arrays (which may be empty)
+        // Build a list of file names and corresponding lists of pointers to ifu arrays (which may be empty);
+        // the arrays in each list are added together after calibration
         vector<string> ifuNames;
-        vector<Array*> ifuArrays;
+        vector<vector<const AccumulationTable*>> ifuArrays;
 
-        // add the total flux; if we didn't record it directly, calculate it now
+        // add the total flux; if we didn't record it directly, calculate it on the fly from the components
         ifuNames.push_back("total");
-        Array ifuTotal;
         if (_recordTotalOnly)
-            ifuArrays.push_back(&_ifu[Total]);
+            ifuArrays.push_back({&_ifu[Total]});
         else
         {
-            ifuTotal = _ifu[PrimaryDirect] + _ifu[PrimaryScattered];
-            if (_hasMediumEmission) ifuTotal += _ifu[SecondaryDirect] + _ifu[SecondaryScattered];
-            ifuArrays.push_back(&ifuTotal);
+            ifuArrays.push_back({&_ifu[PrimaryDirect], &_ifu[PrimaryScattered]});
+            if (_hasMediumEmission)
+                ifuArrays.back().insert(ifuArrays.back().end(), {&_ifu[SecondaryDirect], &_ifu[SecondaryScattered]});
         }
 
         // add the flux components, if requested
@@ -560,21 +571,23 @@ void FluxRecorder::calibrateAndWrite()
             if (!_recordTotalOnly)
             {
                 ifuNames.push_back("transparent");
-                ifuArrays.push_back(&_ifu[Transparent]);
+                ifuArrays.push_back({&_ifu[Transparent]});
             }
             // add the actual components of the total flux (empty arrays will be ignored later on)
             ifuNames.insert(ifuNames.end(), {"primarydirect", "primaryscattered", "secondarytransparent",
                                              "secondarydirect", "secondaryscattered"});
-            ifuArrays.insert(ifuArrays.end(),
-                             {&_ifu[PrimaryDirect], &_ifu[PrimaryScattered], &_ifu[SecondaryTransparent],
-                              &_ifu[SecondaryDirect], &_ifu[SecondaryScattered]});
+            ifuArrays.insert(ifuArrays.end(), {{&_ifu[PrimaryDirect]},
+                                               {&_ifu[PrimaryScattered]},
+                                               {&_ifu[SecondaryTransparent]},
+                                               {&_ifu[SecondaryDirect]},
+                                               {&_ifu[SecondaryScattered]}});
         }
 
         // add the polarization components, if requested
         if (_recordPolarization)
         {
             ifuNames.insert(ifuNames.end(), {"stokesQ", "stokesU", "stokesV"});
-            ifuArrays.insert(ifuArrays.end(), {&_ifu[TotalQ], &_ifu[TotalU], &_ifu[TotalV]});
+            ifuArrays.insert(ifuArrays.end(), {{&_ifu[TotalQ]}, {&_ifu[TotalU]}, {&_ifu[TotalV]}});
         }
 
         // add the scattering levels, if requested
@@ -582,27 +595,16 @@ void FluxRecorder::calibrateAndWrite()
             for (int i = 0; i != _numScatteringLevels; ++i)
             {
                 ifuNames.push_back("primaryscattered" + std::to_string(i + 1));
-                ifuArrays.push_back(&_ifu[PrimaryScatteredLevel + i]);
+                ifuArrays.push_back({&_ifu[PrimaryScatteredLevel + i]});
             }
 
-        // copy the wavelength grid in output units
+        // copy the wavelength grid in output units, reversing the ordering if necessary;
+        // the frames are reversed on the fly by the frame producers below
         Array wavegrid(numWavelengths);
         for (int ell = 0; ell != numWavelengths; ++ell)
             wavegrid[ell] = units->owavelength(_lambdagrid->wavelength(ell));
-
-        // reverse the ordering of the wavelength grid and frames if necessary
-        if (units->rwavelength())
-        {
-            NR::reverse(wavegrid);
-
-            // flux frames
-            for (auto array : ifuArrays)
-                if (array->size()) NR::reverse(*array, _numPixelsInFrame);
-
-            // statistics frames
-            for (auto& array : _wifu)
-                if (array.size()) NR::reverse(array, _numPixelsInFrame);
-        }
+        bool reverse = units->rwavelength();
+        if (reverse) NR::reverse(wavegrid);
 
         // determine spatial axes values and units
         double incx, incy, cx, cy;
@@ -651,14 +653,43 @@ void FluxRecorder::calibrateAndWrite()
             obsInfo->distanceUnits = units->udistance();
         }
 
-        // output the files (ignoring empty arrays)
+        // output the files (ignoring empty arrays), calibrating each frame as it is being written
+        // (when adding components, group them in pairs so that the result is identical to the sum of full arrays)
         int numFiles = ifuNames.size();
         for (int q = 0; q != numFiles; ++q)
-            if (ifuArrays[q]->size())
+            if (ifuArrays[q][0]->size())
             {
+                const vector<const AccumulationTable*>& arrays = ifuArrays[q];
+                auto produceFrame = [this, &arrays, &ifuFactors, reverse, numWavelengths](int k, Array& frame) {
+                    int ell = reverse ? numWavelengths - 1 - k : k;
+                    double factor = ifuFactors[ell];
+                    size_t begin = ell * _numPixelsInFrame;
+                    size_t numArrays = arrays.size();
+                    for (size_t i = 0; i < numArrays; i += 2)
+                    {
+                        const AccumulationTable& a = *arrays[i];
+                        if (i + 1 < numArrays)
+                        {
+                            const AccumulationTable& b = *arrays[i + 1];
+                            if (i)
+                                for (size_t l = 0; l != _numPixelsInFrame; ++l)
+                                    frame[l] += a[begin + l] * factor + b[begin + l] * factor;
+                            else
+                                for (size_t l = 0; l != _numPixelsInFrame; ++l)
+                                    frame[l] = a[begin + l] * factor + b[begin + l] * factor;
+                        }
+                        else
+                        {
+                            if (i)
+                                for (size_t l = 0; l != _numPixelsInFrame; ++l) frame[l] += a[begin + l] * factor;
+                            else
+                                for (size_t l = 0; l != _numPixelsInFrame; ++l) frame[l] = a[begin + l] * factor;
+                        }
+                    }
+                };
                 string filename = _instrumentName + "_" + ifuNames[q];
                 string description = ifuNames[q] + " flux";
-                FITSInOut::write(_parentItem, description, filename, *(ifuArrays[q]), units->usurfacebrightness(),
+                FITSInOut::write(_parentItem, description, filename, produceFrame, units->usurfacebrightness(),
                                  _numPixelsX, _numPixelsY, incx, incy, cx, cy, unitsxy, wavegrid, units->uwavelength(),
                                  obsInfo.get());
             }
@@ -680,9 +711,14 @@ void FluxRecorder::calibrateAndWrite()
             {
                 string filename = _instrumentName + "_stats" + std::to_string(k);
                 string description = "sum of contributions to the power of " + std::to_string(k);
-                _wifu[k] *= cn;
-                FITSInOut::write(_parentItem, description, filename, _wifu[k], "", _numPixelsX, _numPixelsY, incx, incy,
-                                 cx, cy, unitsxy, wavegrid, units->uwavelength());
+                const Array& array = _wifu[k];
+                auto produceFrame = [this, &array, cn, reverse, numWavelengths](int kk, Array& frame) {
+                    int ell = reverse ? numWavelengths - 1 - kk : kk;
+                    size_t begin = ell * _numPixelsInFrame;
+                    for (size_t l = 0; l != _numPixelsInFrame; ++l) frame[l] = array[begin + l] * cn;
+                };
+                FITSInOut::write(_parentItem, description, filename, produceFrame, "", _numPixelsX, _numPixelsY, incx,
+                                 incy, cx, cy, unitsxy, wavegrid, units->uwavelength());
                 cn *= c;
             }
         }
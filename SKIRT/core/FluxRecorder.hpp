@@ -6,6 +6,7 @@
 #ifndef FLUXRECORDER_HPP
 #define FLUXRECORDER_HPP
 
+#include "AccumulationTable.hpp"
 #include "Array.hpp"
 #include "ThreadLocalMember.hpp"
 #include <tuple>
@@ -365,7 +366,7 @@ private:
 
     // detector arrays that need to be calibrated, initialized when configuration is finalized
     vector<Array> _sed;
-    vector<Array> _ifu;
+    vector<AccumulationTable> _ifu;  // indexed on ell and pixel; possibly in single precision
 
     // detector arrays for statistics that should not be calibrated, initialized when configuration is finalized
     vector<Array> _wsed;
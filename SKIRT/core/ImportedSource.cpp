@@ -18,6 +18,7 @@
 #include "Snapshot.hpp"
 #include "VelocityInterface.hpp"
 #include "WavelengthGrid.hpp"
+#include <atomic>
 
 ////////////////////////////////////////////////////////////////////
 
@@ -25,6 +26,11 @@ namespace
 {
     // maximum number of luminosity calculations between two invocations of infoIfElapsed()
     const size_t logProgressChunkSize = 10000;
+
+    // returns the index in the SED cache of the spectral distribution for entity m, given the number of points n
+    // in the wavelength grid; the distribution is stored as n single-precision pv
+    // values followed by n single-precision Pv values, packed into n double-precision slots
+    size_t sedOffset(size_t m, size_t n) { return 2 + n + n * m; }
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -82,30 +88,120 @@ void ImportedSource::setupSelfAfter()
     int M = _snapshot->numEntities();
     if (M)
     {
-        // integrating over the SED for each entity can be time-consuming, so we do this in parallel
         _Lv.resize(M);
         auto log = find<Log>();
-        log->info("Calculating luminosities for " + std::to_string(M) + " imported entities...");
-        log->infoSetElapsed(M);
-        find<ParallelFactory>()->parallelDistributed()->call(M, [this, log](size_t firstIndex, size_t numIndices) {
-            // the contents of these three arrays is not used, so this could be optimized if needed
-            Array lambdav, pv, Pv;
-            Array params;
-
-            while (numIndices)
+
+        // if requested, attempt to load the luminosities and spectral distributions from a cache file;
+        // the cached information depends only on the configuration of this source and on the wavelength range
+        // layout of the cached values: M, N, wavelength grid (N), spectral distributions (N for each entity),
+        // and luminosities (M); see sedOffset() for the layout of the spectral distribution of each entity
+        if (cacheSEDs())
+        {
+            auto createCache = [this]() {
+                _cache = std::make_unique<BinaryCache>(this, "sed", 2);
+                _cache->addKey(this);
+                _cache->addKey(_wavelengthRange.min());
+                _cache->addKey(_wavelengthRange.max());
+            };
+            createCache();
+            if (_cache->load())
+            {
+                const double* data = _cache->data();
+                size_t size = _cache->size();
+                size_t n = size >= 2 ? static_cast<size_t>(data[1]) : 0;
+                if (n && static_cast<int>(data[0]) == M && size == 2 + n + n * M + M)
+                {
+                    _sedData = data;
+                    _sedN = n;
+                    for (int m = 0; m != M; ++m) _Lv[m] = data[2 + n + n * M + m];
+                }
+                else
+                {
+                    // release the memory map before the file is overwritten
+                    log->warning("Ignoring SED cache file with inconsistent contents");
+                    createCache();
+                }
+            }
+        }
+
+        if (!_sedData)
+        {
+            // if a new cache file should be produced, obtain the wavelength grid from the first entity;
+            // we assume that the SED family uses the same grid for all entities and verify this assumption below
+            Array gridv;
+            size_t n = 0;
+            if (_cache)
+            {
+                Array pv, Pv, params;
+                _snapshot->parameters(0, params);
+                _sedFamily->cdf(gridv, pv, Pv, _wavelengthRange, params);
+                n = gridv.size();
+                _cache->beginStore(2 + n + n * M + M);
+            }
+            std::atomic<bool> mismatch{false};
+
+            // integrating over the SED for each entity can be time-consuming, so we do this in parallel;
+            // when producing a cache file, each process writes the distributions of the entities it handles
+            log->info("Calculating luminosities for " + std::to_string(M) + " imported entities...");
+            log->infoSetElapsed(M);
+            find<ParallelFactory>()->parallelDistributed()->call(
+                M, [this, log, n, &gridv, &mismatch](size_t firstIndex, size_t numIndices) {
+                    // the contents of these arrays is used only when producing a cache file
+                    Array lambdav, pv, Pv;
+                    vector<float> slice(2 * n);
+                    Array params;
+
+                    while (numIndices)
+                    {
+                        size_t currentChunkSize = min(logProgressChunkSize, numIndices);
+                        for (size_t m = firstIndex; m != firstIndex + currentChunkSize; ++m)
+                        {
+                            _snapshot->parameters(m, params);
+                            _Lv[m] = _sedFamily->cdf(lambdav, pv, Pv, _wavelengthRange, params);
+
+                            // write the distributions to the cache file if the wavelength grids match
+                            if (n && !mismatch)
+                            {
+                                if (lambdav.size() == n && std::equal(begin(lambdav), end(lambdav), begin(gridv)))
+                                {
+                                    std::copy(begin(pv), end(pv), slice.begin());
+                                    std::copy(begin(Pv), end(Pv), slice.begin() + n);
+                                    auto values = reinterpret_cast<const double*>(slice.data());
+                                    _cache->storeSlice(sedOffset(m, n), values, n);
+                                }
+                                else
+                                    mismatch = true;
+                            }
+                        }
+                        log->infoIfElapsed("Calculated luminosities: ", currentChunkSize);
+                        firstIndex += currentChunkSize;
+                        numIndices -= currentChunkSize;
+                    }
+                });
+            ProcessManager::sumToAll(_Lv);
+
+            // if all wavelength grids match, complete the cache file and access the information through a memory map
+            if (n)
             {
-                size_t currentChunkSize = min(logProgressChunkSize, numIndices);
-                for (size_t m = firstIndex; m != firstIndex + currentChunkSize; ++m)
+                Array mismatchv(mismatch ? 1. : 0., 1);
+                ProcessManager::sumToAll(mismatchv);
+                if (mismatchv[0])
+                    log->warning(
+                        "Cannot cache SEDs because the SED family uses a different wavelength grid per entity");
+                else if (ProcessManager::isRoot())
                 {
-                    _snapshot->parameters(m, params);
-                    _Lv[m] = _sedFamily->cdf(lambdav, pv, Pv, _wavelengthRange, params);
+                    double header[2] = {static_cast<double>(M), static_cast<double>(n)};
+                    _cache->storeSlice(0, header, 2);
+                    _cache->storeSlice(2, begin(gridv), n);
+                    _cache->storeSlice(2 + n + n * M, begin(_Lv), M);
+                }
+                if (_cache->endStore(!mismatchv[0]) && _cache->load(2 + n + n * M + M))
+                {
+                    _sedData = _cache->data();
+                    _sedN = n;
                 }
-                log->infoIfElapsed("Calculated luminosities: ", currentChunkSize);
-                firstIndex += currentChunkSize;
-                numIndices -= currentChunkSize;
             }
-        });
-        ProcessManager::sumToAll(_Lv);
+        }
 
         // save the bias and biased luminosity and normalize both vectors
         if (_snapshot->hasBias())
@@ -202,6 +298,19 @@ double ImportedSource::specificLuminosity(double wavelength, int m) const
 
 ////////////////////////////////////////////////////////////////////
 
+void ImportedSource::specificLuminosities(Array& Lv, const Array& wavelengths, int m) const
+{
+    Array params;
+    _snapshot->parameters(m, params);
+    _sedFamily->specificLuminosities(Lv, wavelengths, params);
+
+    size_t n = wavelengths.size();
+    for (size_t i = 0; i != n; ++i)
+        if (!_wavelengthRange.containsFuzzy(wavelengths[i])) Lv[i] = 0.;
+}
+
+////////////////////////////////////////////////////////////////////
+
 double ImportedSource::meanSpecificLuminosity(Range wavelengthRange, int m) const
 {
     wavelengthRange.intersect(_wavelengthRange);
@@ -271,17 +380,15 @@ namespace
     public:
         EntitySED() {}
 
-        // sets the normalized distributions from the SED family if this is a different entity or snapshot
-        void setIfNeeded(int m, const Snapshot* snapshot, const SEDFamily* family, Range range)
+        // returns true if this instance holds the distributions for the specified entity and snapshot
+        bool matches(int m, const Snapshot* snapshot) const { return m == _m && snapshot == _snapshot; }
+
+        // sets the normalized distributions for the specified entity and snapshot using the specified function
+        template<typename Calculator> void set(int m, const Snapshot* snapshot, Calculator calculate)
         {
-            if (m != _m || snapshot != _snapshot)
-            {
-                Array params;
-                snapshot->parameters(m, params);
-                family->cdf(_lambdav, _pv, _Pv, range, params);
-                _snapshot = snapshot;
-                _m = m;
-            }
+            calculate(_lambdav, _pv, _Pv);
+            _snapshot = snapshot;
+            _m = m;
         }
 
         // returns a random wavelength generated from the distribution
@@ -294,9 +401,47 @@ namespace
         }
     };
 
-    // setup an SED instance for each parallel execution thread to cache discretized SED data; this works even if
+    // an instance of this class holds the spectral distributions for a small number of recently used entities,
+    // discarding the least recently used entry when a new entity is requested
+    class EntitySEDCache
+    {
+    private:
+        static constexpr int _capacity = 8;  // the maximum number of entities held in the cache
+        EntitySED _sedv[_capacity];          // the cached distributions
+        size_t _usev[_capacity]{};           // the time of last use for each cache entry (zero if unused)
+        size_t _time{0};                     // the current time, incremented for each request
+
+    public:
+        EntitySEDCache() {}
+
+        // returns the normalized distributions for the specified entity and snapshot,
+        // obtaining them using the specified function if they are not already in the cache
+        template<typename Calculator> const EntitySED& get(int m, const Snapshot* snapshot, Calculator calculate)
+        {
+            ++_time;
+            int oldest = 0;
+            for (int i = 0; i != _capacity; ++i)
+            {
+                if (_sedv[i].matches(m, snapshot))
+                {
+                    _usev[i] = _time;
+                    return _sedv[i];
+                }
+                if (_usev[i] < _usev[oldest]) oldest = i;
+            }
+            _sedv[oldest].set(m, snapshot, calculate);
+            _usev[oldest] = _time;
+            return _sedv[oldest];
+        }
+    };
+
+    // setup an SED cache for each parallel execution thread to cache discretized SED data; this works even if
     // there are multiple sources of this type because each thread handles a single photon packet at a time
-    thread_local EntitySED t_sed;
+    thread_local EntitySEDCache t_sedCache;
+
+    // remember the entity index selected for the previous photon packet launched by each parallel execution thread;
+    // because consecutive history indices usually map to the same entity, this often avoids a binary search
+    thread_local ptrdiff_t t_entityHint{-1};
 }
 
 namespace
@@ -323,8 +468,14 @@ namespace
 
 void ImportedSource::launch(PhotonPacket* pp, size_t historyIndex, double L) const
 {
-    // select the entity corresponding to this history index
-    auto m = std::upper_bound(_Iv.cbegin(), _Iv.cend(), historyIndex) - _Iv.cbegin() - 1;
+    // select the entity corresponding to this history index, trying the entity selected for the previous packet first;
+    // the hint is verified against the map so that it cannot produce an incorrect result, even for another source
+    ptrdiff_t m = t_entityHint;
+    if (m < 0 || m + 1 >= static_cast<ptrdiff_t>(_Iv.size()) || historyIndex < _Iv[m] || historyIndex >= _Iv[m + 1])
+    {
+        m = std::upper_bound(_Iv.cbegin(), _Iv.cend(), historyIndex) - _Iv.cbegin() - 1;
+        t_entityHint = m;
+    }
 
     // if there are no entities in the source, or the selected entity has no contribution,
     // launch a photon packet with zero luminosity
@@ -338,26 +489,27 @@ void ImportedSource::launch(PhotonPacket* pp, size_t historyIndex, double L) con
     double ws = _Lv[m] / _Wv[m];
 
     // get the normalized regular and cumulative distributions for this entity, if not already available
-    t_sed.setIfNeeded(m, _snapshot, _sedFamily, _wavelengthRange);
+    const EntitySED& sed = t_sedCache.get(
+        m, _snapshot, [this, m](Array& lambdav, Array& pv, Array& Pv) { entityCDF(m, lambdav, pv, Pv); });
 
     // generate a random wavelength from the SED and/or from the bias distribution
     double lambda, w;
     if (!_xi)
     {
         // no biasing -- simply use the intrinsic spectral distribution
-        lambda = t_sed.generateWavelength(random());
+        lambda = sed.generateWavelength(random());
         w = 1.;
     }
     else
     {
         // biasing -- use one or the other distribution
         if (random()->uniform() > _xi)
-            lambda = t_sed.generateWavelength(random());
+            lambda = sed.generateWavelength(random());
         else
             lambda = _biasDistribution->generateWavelength();
 
         // calculate the compensating weight factor
-        double s = t_sed.specificLuminosity(lambda);
+        double s = sed.specificLuminosity(lambda);
         if (!s)
         {
             // if the wavelength can't occur in the intrinsic distribution,
@@ -397,3 +549,27 @@ const Snapshot* ImportedSource::snapshot() const
 }
 
 ////////////////////////////////////////////////////////////////////
+
+void ImportedSource::entityCDF(int m, Array& lambdav, Array& pv, Array& Pv) const
+{
+    if (_sedData)
+    {
+        size_t n = _sedN;
+            const double* gridv = _sedData + 2;
+        const float* source = reinterpret_cast<const float*>(_sedData + sedOffset(m, n));
+        lambdav.resize(n);
+        pv.resize(n);
+        Pv.resize(n);
+        std::copy(gridv, gridv + n, begin(lambdav));
+        std::copy(source, source + n, begin(pv));
+        std::copy(source + n, source + 2 * n, begin(Pv));
+    }
+    else
+    {
+        Array params;
+        _snapshot->parameters(m, params);
+        _sedFamily->cdf(lambdav, pv, Pv, _wavelengthRange, params);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
@@ -7,6 +7,7 @@
 #define IMPORTEDSOURCE_HPP
 
 #include "Array.hpp"
+#include "BinaryCache.hpp"
 #include "Range.hpp"
 #include "SEDFamily.hpp"
 #include "Source.hpp"
@@ -66,7 +67,33 @@ class Snapshot;
 
     where \f$L\f$ is the total luminosity for this source and \f$M\f$ is the total number of
     entities in this source. In all cases, the value of \f$\xi\f$ shifts between luminosity-weighted
-    (\f$\xi=0\f$) and entity-weighted (\f$\xi=1\f$) or any combination thereof. */
+    (\f$\xi=0\f$) and entity-weighted (\f$\xi=1\f$) or any combination thereof.
+
+    <em>Caching spectral distributions</em>
+
+    For snapshots with many entities, obtaining the spectral distribution of each entity from the
+    %SED family can take a substantial amount of time, both during setup (to calculate the
+    luminosity of each entity) and while launching photon packets. If the \em cacheSEDs flag is
+    enabled, this class stores the luminosity and the normalized spectral distribution of each
+    entity on the source wavelength range in a binary cache file in the output directory (see the
+    BinaryCache class). A subsequent simulation with the same source configuration, including the
+    contents of the imported file, and with the same source wavelength range loads this information
+    from the cache file through a memory map instead of recalculating it. Configuration changes to
+    other parts of the simulation, such as the media or the instruments, do not affect the cache.
+
+    The distributions for all entities are discretized on the same wavelength grid, which is stored
+    only once. The normalized distribution and the corresponding cumulative distribution of each
+    entity are stored in single precision, so that the cache file contains approximately \f$NM\f$
+    values of 8 bytes each, where \f$M\f$ is the number of entities and \f$N\f$ is the number of
+    points in the wavelength grid used by the %SED family. Because this may be large, the flag is
+    disabled by default. Also, the cache is not produced for %SED families that use a different
+    wavelength grid for each entity. Changes to the resource files used by the %SED family are not
+    detected.
+
+    When the cache file is produced, each process writes the distributions for the entities it
+    handled directly to the file, so that the complete information is never held in memory. After
+    the file has been completed, it is accessed through a memory map, exactly as if it had been
+    loaded by the simulation. */
 class ImportedSource : public Source
 {
     ITEM_ABSTRACT(ImportedSource, Source, "a primary source imported from snapshot data")
@@ -104,6 +131,10 @@ class ImportedSource : public Source
         PROPERTY_ITEM(sedFamily, SEDFamily, "the SED family for assigning spectra to the imported sources")
         ATTRIBUTE_DEFAULT_VALUE(sedFamily, "BlackBodySEDFamily")
 
+        PROPERTY_BOOL(cacheSEDs, "cache the spectral distributions of the entities for use by subsequent simulations")
+        ATTRIBUTE_DEFAULT_VALUE(cacheSEDs, "false")
+        ATTRIBUTE_DISPLAYED_IF(cacheSEDs, "Level3")
+
     ITEM_END()
 
     //============= Construction - Setup - Destruction =============
@@ -117,7 +148,9 @@ protected:
 
         Finally, the function constructs a vector with the luminosities (integrated over the
         primary source wavelength range) for all imported entities. This information is used when
-        deciding how many photon packets should be launched from each entity. */
+        deciding how many photon packets should be launched from each entity. If the \em cacheSEDs
+        flag is enabled, the function loads the luminosities and the spectral distributions from a
+        cache file, if available, or stores them in a new cache file otherwise. */
     void setupSelfAfter() override;
 
     /** This function constructs a new Snapshot object of the type appropriate for the subclass,
@@ -168,6 +201,18 @@ public:
         from anywhere else in the simulation machinery. */
     double specificLuminosity(double wavelength, int m) const;
 
+    /** This function stores in \em Lv the specific luminosity \f$L_\lambda\f$ of the source's
+        snapshot entity with index \f$m\f$ at each of the wavelengths in \em wavelengths. The
+        resulting values are identical to those returned by the specificLuminosity(double, int)
+        function for each of the wavelengths, but they are obtained from the %SED family in a
+        single batch. If the entity index is out of range, the behavior is undefined.
+
+        This function is intended to provide InputModelProbe instances with access to the
+        luminosity per snapshot entity, information that is not otherwise made available to the
+        simulation. To preserve proper data encapsulation, this function should \em not be called
+        from anywhere else in the simulation machinery. */
+    void specificLuminosities(Array& Lv, const Array& wavelengths, int m) const;
+
     /** This function returns the average specific luminosity \f$L_\lambda\f$ of the source's
         snapshot entity with index \f$m\f$ in the specified wavelength range, or zero if the
         wavelength range is outside the wavelength range of primary sources or if the source does
@@ -199,7 +244,12 @@ public:
         This function distributes the provided range of history indices over the individual
         entities imported by this source, creating a map for use when actually launching the photon
         packets. The number of photon packets allocated to each entity is determined following the
-        scheme described in the header documentation of this class. */
+        scheme described in the header documentation of this class. Each entity is allocated a
+        contiguous range of history indices, and the entities are listed in order of increasing
+        history index. Because the parallelization machinery hands out contiguous chunks of history
+        indices to each execution thread, the photon packets in a chunk are thus grouped by entity,
+        so that the spectral distribution for a given entity is usually constructed only once per
+        chunk. */
     void prepareForLaunch(double sourceBias, size_t firstIndex, size_t numIndices) override;
 
     /** This function causes the photon packet \em pp to be launched from the source using the
@@ -208,10 +258,13 @@ public:
          First, the function finds the entity index that corresponding to the history index using
          the map constructed by the prepareForLaunch() function. It obtains the normalized spectral
          distribition (and the corresponding cumulative distribution) for that entity from the SED
-         family configured for this source. In fact, the function sets up a thread-local object
-         that caches the spectral distribution for an entity between consecutive invocations of the
-         launch() function. This works even if there are multiple sources of this type because each
-         thread handles a single photon packet at a time.
+         family configured for this source. In fact, the function sets up a thread-local cache that
+         holds the spectral distributions for a small number of recently used entities, discarding
+         the least recently used entry when needed. This avoids recalculating the distributions for
+         consecutive photon packets launched from the same entity, and limits recalculation when a
+         thread alternates between a few entities, for example because it processes chunks of
+         history indices from multiple sources. This works even if there are multiple sources of
+         this type because each thread handles a single photon packet at a time.
 
          Subsequently, the function samples a wavelength from the entity's SED, properly handling
          the configured wavelength biasing, and asks the Snapshot object to generate a random
@@ -231,6 +284,12 @@ public:
         from anywhere else in the simulation machinery. */
     const Snapshot* snapshot() const;
 
+private:
+    /** This function obtains the normalized spectral distribution and the corresponding cumulative
+        distribution for the entity with index \em m on the source wavelength range, either from the
+        cached information, if available, or from the %SED family. */
+    void entityCDF(int m, Array& lambdav, Array& pv, Array& Pv) const;
+
     //======================== Data Members ========================
 
 private:
@@ -246,6 +305,11 @@ private:
     double _L{0};  // the total bolometric luminosity of all entities (absolute number)
     Array _Lv;     // the relative bolometric luminosity of each entity (normalized to unity)
 
+    // cached spectral information initialized during setup if requested
+    std::unique_ptr<BinaryCache> _cache;  // the cache providing the memory-mapped spectral information, if any
+    const double* _sedData{nullptr};      // pointer to the first value of the cached spectral information, if any
+    size_t _sedN{0};                      // the number of points in the wavelength grid of the cached information
+
     // intialized by prepareForLaunch()
     Array _Wv;           // the relative launch weight for each entity (normalized to unity)
     Array _bv;           // the bias for each entity (normalized to unity)
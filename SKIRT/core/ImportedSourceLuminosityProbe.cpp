@@ -161,8 +161,9 @@ void ImportedSourceLuminosityProbe::probeImportedSources(const vector<const Impo
     //  - a surface brightness value along a given path
     auto valueAtPositionOrAlongPath = [&sources, &snapshots, numWaves, style, &wave, &cvol, &csrf,
                                        &storedLuminosities](bool path, Position bfr, Direction bfk) {
-        // allocate an entity collection that can be reused for all queries in a given execution thread
+        // allocate an entity collection and a luminosity array that can be reused for all queries in a given thread
         thread_local EntityCollection entities;
+        thread_local Array sampledLuminosities;
 
         // allocate array to store the result
         Array result(numWaves);
@@ -183,6 +184,9 @@ void ImportedSourceLuminosityProbe::probeImportedSources(const vector<const Impo
                 int m = entity.first;
                 double w = entity.second;
 
+                // for style Sample, get the specific luminosities for all wavelengths in a single batch
+                if (style == Style::Sample) sources[h]->specificLuminosities(sampledLuminosities, wave, m);
+
                 // loop over the wavelength bins
                 for (int ell = 0; ell != numWaves; ++ell)
                 {
@@ -190,7 +194,7 @@ void ImportedSourceLuminosityProbe::probeImportedSources(const vector<const Impo
                     double luminosity = 0.;
                     switch (style)
                     {
-                        case Style::Sample: luminosity = sources[h]->specificLuminosity(wave[ell], m); break;
+                        case Style::Sample: luminosity = sampledLuminosities[ell]; break;
                         case Style::Average: luminosity = storedLuminosities(ell, h, m); break;
                         case Style::Convolve: luminosity = storedLuminosities(ell, h, m); break;
                     }
@@ -14,7 +14,16 @@
 /** An InstrumentSystem instance keeps a list of zero or more instruments and an optional default
     wavelength grid that will be used by an instrument unless it specifies its own wavelength grid.
     The instruments can be of various nature and do not need to be located at the same observing
-    position. */
+    position.
+
+    The user can request that the instruments record their surface brightness data cubes in single
+    precision rather than in double precision, halving the memory requirements for these data
+    cubes. Each thread then stages its contributions in a small double precision buffer, and the
+    staged sums are added to the recorded values with stochastic rounding, so that small
+    contributions are not lost and the results remain unbiased (see the AccumulationTable class).
+    The data cubes are written to FITS files in single precision in any
+    case. This option does not affect the statistics data cubes, which require the range of double
+    precision values during the simulation. */
 class InstrumentSystem : public SimulationItem
 {
     ITEM_CONCRETE(InstrumentSystem, SimulationItem, "an instrument system")
@@ -29,6 +38,11 @@ class InstrumentSystem : public SimulationItem
         ATTRIBUTE_DEFAULT_VALUE(instruments, "SEDInstrument")
         ATTRIBUTE_REQUIRED_IF(instruments, "false")
 
+        PROPERTY_BOOL(recordDataCubesInSinglePrecision,
+                      "record instrument data cubes in single precision to reduce memory usage")
+        ATTRIBUTE_DEFAULT_VALUE(recordDataCubesInSinglePrecision, "false")
+        ATTRIBUTE_DISPLAYED_IF(recordDataCubesInSinglePrecision, "Level3")
+
     ITEM_END()
 
     //============= Construction - Setup - Destruction =============
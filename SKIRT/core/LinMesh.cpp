@@ -16,3 +16,10 @@ Array LinMesh::mesh() const
 }
 
 //////////////////////////////////////////////////////////////////////
+
+double LinMesh::inverseMesh(double t) const
+{
+    return numBins() * t;
+}
+
+//////////////////////////////////////////////////////////////////////
@@ -22,6 +22,11 @@ class LinMesh : public Mesh
 public:
     /** This function returns an array containing the mesh points. */
     Array mesh() const override;
+
+    /** This function returns the (generally non-integer) mesh point index \f$s\f$ corresponding to
+        the normalized coordinate \f$0\le t\le 1\f$, which for a linear mesh is simply given
+        by \f$s=N\,t\f$. */
+    double inverseMesh(double t) const override;
 };
 
 //////////////////////////////////////////////////////////////////////
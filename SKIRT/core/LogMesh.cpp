@@ -8,6 +8,21 @@
 
 ////////////////////////////////////////////////////////////////////
 
+void LogMesh::setupSelfBefore()
+{
+    Mesh::setupSelfBefore();
+
+    // use the same expressions as NR::buildZeroLogGrid()
+    int n = numBins();
+    if (n > 1)
+    {
+        _logtc = log(_centralBinFraction);
+        _dlogt = -_logtc / (n - 1);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
 Array LogMesh::mesh() const
 {
     Array tv;
@@ -19,3 +34,12 @@ Array LogMesh::mesh() const
 }
 
 //////////////////////////////////////////////////////////////////////
+
+double LogMesh::inverseMesh(double t) const
+{
+    if (numBins() == 1) return t;
+    if (t < _centralBinFraction) return 0.;
+    return 1. + (log(t) - _logtc) / _dlogt;
+}
+
+//////////////////////////////////////////////////////////////////////
@@ -26,11 +26,30 @@ class LogMesh : public Mesh
 
     ITEM_END()
 
+    //============= Construction - Setup - Destruction =============
+
+protected:
+    /** This function precalculates some constants used by the inverseMesh() function. */
+    void setupSelfBefore() override;
+
     //======================== Other Functions =======================
 
 public:
     /** This function returns an array containing the mesh points. */
     Array mesh() const override;
+
+    /** This function returns the (generally non-integer) mesh point index \f$s\f$ corresponding to
+        the normalized coordinate \f$0\le t\le 1\f$, obtained by inverting the logarithmic
+        formula for the mesh points beyond the central bin. For \f$t<t_\text{c}\f$, the function
+        returns zero. */
+    double inverseMesh(double t) const override;
+
+    //======================== Data Members ========================
+
+private:
+    // data members initialized during setup
+    double _logtc{0.};  // the natural logarithm of the central bin width fraction
+    double _dlogt{0.};  // the logarithmic width of the bins beyond the central bin
 };
 
 //////////////////////////////////////////////////////////////////////
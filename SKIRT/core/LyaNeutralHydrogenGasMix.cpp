@@ -18,6 +18,7 @@ void LyaNeutralHydrogenGasMix::setupSelfBefore()
     MaterialMix::setupSelfBefore();
 
     _dpf.initialize(random(), includePolarization());
+    _tabulatedVoigt = find<Configuration>()->lyaTabulatedVoigtFunction();
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -96,14 +97,14 @@ double LyaNeutralHydrogenGasMix::sectionAbs(double /*lambda*/) const
 
 double LyaNeutralHydrogenGasMix::sectionSca(double lambda) const
 {
-    return LyaUtils::section(lambda, defaultTemperature());
+    return LyaUtils::section(lambda, defaultTemperature(), _tabulatedVoigt);
 }
 
 ////////////////////////////////////////////////////////////////////
 
 double LyaNeutralHydrogenGasMix::sectionExt(double lambda) const
 {
-    return LyaUtils::section(lambda, defaultTemperature());
+    return LyaUtils::section(lambda, defaultTemperature(), _tabulatedVoigt);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -119,7 +120,7 @@ double LyaNeutralHydrogenGasMix::opacityAbs(double /*lambda*/, const MaterialSta
 double LyaNeutralHydrogenGasMix::opacitySca(double lambda, const MaterialState* state, const PhotonPacket* /*pp*/) const
 {
     double n = state->numberDensity();
-    return n > 0. ? n * LyaUtils::section(lambda, state->temperature()) : 0.;
+    return n > 0. ? n * LyaUtils::section(lambda, state->temperature(), _tabulatedVoigt) : 0.;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -127,7 +128,7 @@ double LyaNeutralHydrogenGasMix::opacitySca(double lambda, const MaterialState*
 double LyaNeutralHydrogenGasMix::opacityExt(double lambda, const MaterialState* state, const PhotonPacket* /*pp*/) const
 {
     double n = state->numberDensity();
-    return n > 0. ? n * LyaUtils::section(lambda, state->temperature()) : 0.;
+    return n > 0. ? n * LyaUtils::section(lambda, state->temperature(), _tabulatedVoigt) : 0.;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -142,7 +143,7 @@ void LyaNeutralHydrogenGasMix::peeloffScattering(double& I, double& Q, double& U
     {
         scatinfo->valid = true;
         std::tie(scatinfo->velocity, scatinfo->dipole) = LyaUtils::sampleAtomVelocity(
-            lambda, state->temperature(), state->numberDensity(), pp->direction(), config(), random());
+            lambda, state->temperature(), state->numberDensity(), state->volume(), pp->direction(), config(), random());
     }
 
     // add the contribution to the Stokes vector components depending on scattering type
@@ -171,7 +172,7 @@ void LyaNeutralHydrogenGasMix::performScattering(double lambda, const MaterialSt
     {
         scatinfo->valid = true;
         std::tie(scatinfo->velocity, scatinfo->dipole) = LyaUtils::sampleAtomVelocity(
-            lambda, state->temperature(), state->numberDensity(), pp->direction(), config(), random());
+            lambda, state->temperature(), state->numberDensity(), state->volume(), pp->direction(), config(), random());
     }
 
     // draw the outgoing direction from the dipole or the isotropic phase function
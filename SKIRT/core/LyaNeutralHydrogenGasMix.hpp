@@ -52,7 +52,8 @@ class LyaNeutralHydrogenGasMix : public MaterialMix
     //============= Construction - Setup - Destruction =============
 
 protected:
-    /** This function initializes the DipolePhaseFunction instance held by this class. */
+    /** This function initializes the DipolePhaseFunction instance held by this class, and
+        remembers whether the Voigt function should be evaluated through a precalculated table. */
     void setupSelfBefore() override;
 
     //======== Capabilities =======
@@ -171,6 +172,9 @@ public:
 private:
     // the dipole phase function helper instance - initialized during setup
     DipolePhaseFunction _dpf;
+
+    // flag indicating whether to use the tabulated Voigt function - initialized during setup
+    bool _tabulatedVoigt{false};
 };
 
 ////////////////////////////////////////////////////////////////////
@@ -11,7 +11,14 @@
 ////////////////////////////////////////////////////////////////////
 
 /** The LyaOptions class simply offers a number of configuration options related to the treatment
-    of Lyman-alpha line transfer, if this is enabled in the simulation. */
+    of Lyman-alpha line transfer, if this is enabled in the simulation.
+
+    The \em tabulateVoigtFunction option causes the Voigt function determining the Lyman-alpha
+    cross section to be evaluated through interpolation in a precalculated table rather than
+    through direct evaluation of its approximating formula. This speeds up the calculation of the
+    optical depth along the many short paths traversed by Lyman-alpha photon packets, while
+    reproducing the directly evaluated cross section to within a relative error of a few times
+    \f$10^{-6}\f$ (see VoigtProfile::tabulatedValue()). */
 class LyaOptions : public SimulationItem
 {
     /** The enumeration type indicating the supported Lyman-alpha acceleration schemes.
@@ -26,7 +33,7 @@ class LyaOptions : public SimulationItem
         dimensionless frequency \f$x\f$ smaller than a given critical value \f$x_\mathrm{crit}\f$
         are treated this way.
 
-        SKIRT implements three variations of the core-skipping acceleration scheme:
+        SKIRT implements four variations of the core-skipping acceleration scheme:
 
         - \em None: no acceleration is performed, corresponding to \f$x_\mathrm{crit}=0\f$. This
         can be useful for models with low optical depths, or to produce reference results for
@@ -47,7 +54,23 @@ class LyaOptions : public SimulationItem
         below. This variable mechanism is applicable for most models, and is preferred for models
         with a broad dynamic range in optical depths.
 
-        For both the constant and variable schemes, the user can configure the acceleration
+        - \em Dynamic: acceleration with a variable critical value that depends on the line-center
+        optical depth of the spatial cell hosting the scattering event, following the dynamic
+        core-skipping scheme of Laursen et al. 2009 (ApJ, 696, 853-869). Specifically, the critical
+        value is determined as \f[ x_\mathrm{crit} = \begin{cases} 0 & a\tau_0 \le 1 \\ 0.02\,s\,
+        \exp\left[0.6\,(\ln a\tau_0)^{1.2}\right] & 1 < a\tau_0 \le 60 \\ 0.02\,s\,
+        \exp\left[1.4\,(\ln a\tau_0)^{0.6}\right] & a\tau_0 > 60 \end{cases} \f] where \f$s\f$
+        is the acceleration strength configured by the user, \f$a\f$ is the Voigt parameter, and
+        \f$\tau_0\f$ is the optical depth at the Lyman-alpha line center from the center of the
+        cell to its border. The latter is approximated as \f$\tau_0 = n_\mathrm{H}\,
+        \sigma_{\alpha,0}(T)\,V^{1/3}/2\f$, where \f$V\f$ is the volume of the cell and
+        \f$\sigma_{\alpha,0}(T)\f$ is the cross section at the line center (see the LyaUtils
+        namespace). Unlike the variable scheme, this scheme thus depends on the spatial
+        resolution of the grid. On the other hand, the acceleration automatically vanishes in
+        cells that are optically thin at the line center, and increases gradually in the optically
+        thick cores that trap photon packets for many scatterings.
+
+        For the constant, variable and dynamic schemes, the user can configure the acceleration
         strength \f$s\f$, with a default value of unity. Larger values will decrease run time and
         accuracy; smaller values will increase run time and accuracy.
 
@@ -72,10 +95,11 @@ class LyaOptions : public SimulationItem
         \propto (n_\mathrm{H}/T)^{1/6}\f$. With the gas properties expressed in SI units,
         experiments with benchmark models show that a proportionality factor of order unity is
         appropriate. */
-    ENUM_DEF(LyaAccelerationScheme, None, Constant, Variable)
+    ENUM_DEF(LyaAccelerationScheme, None, Constant, Variable, Dynamic)
         ENUM_VAL(LyaAccelerationScheme, None, "no acceleration")
         ENUM_VAL(LyaAccelerationScheme, Constant, "acceleration scheme with a constant critical value")
         ENUM_VAL(LyaAccelerationScheme, Variable, "acceleration scheme depending on local gas temperature and density")
+        ENUM_VAL(LyaAccelerationScheme, Dynamic, "acceleration scheme depending on the local line-center optical depth")
     ENUM_END()
 
     ITEM_CONCRETE(LyaOptions, SimulationItem, "a set of options related to Lyman-alpha line transfer")
@@ -88,13 +112,17 @@ class LyaOptions : public SimulationItem
         ATTRIBUTE_MIN_VALUE(lyaAccelerationStrength, "]0")
         ATTRIBUTE_MAX_VALUE(lyaAccelerationStrength, "10]")
         ATTRIBUTE_DEFAULT_VALUE(lyaAccelerationStrength, "1")
-        ATTRIBUTE_RELEVANT_IF(lyaAccelerationStrength, "lyaAccelerationSchemeConstant|lyaAccelerationSchemeVariable")
+        ATTRIBUTE_RELEVANT_IF(lyaAccelerationStrength, "!lyaAccelerationSchemeNone")
         ATTRIBUTE_DISPLAYED_IF(lyaAccelerationStrength, "Level2")
 
         PROPERTY_BOOL(includeHubbleFlow, "include the Doppler shift caused by the expansion of the universe")
         ATTRIBUTE_DEFAULT_VALUE(includeHubbleFlow, "false")
         ATTRIBUTE_DISPLAYED_IF(includeHubbleFlow, "Level2")
 
+        PROPERTY_BOOL(tabulateVoigtFunction, "evaluate the Voigt function using a precalculated table")
+        ATTRIBUTE_DEFAULT_VALUE(tabulateVoigtFunction, "false")
+        ATTRIBUTE_DISPLAYED_IF(tabulateVoigtFunction, "Level3")
+
     ITEM_END()
 };
 
@@ -80,14 +80,13 @@ double LyaSEDFamilyDecorator::cdf(Array& lambdav, Array& pv, Array& Pv, const Ra
 
     // calculate the specific luminosity at each of these grid points
     size_t n = lambdav.size();
-    pv.resize(n);
+    sedFamilyOriginal()->specificLuminosities(pv, lambdav, parameters);
     for (size_t i = 0; i != n; ++i)
     {
         if (lambdav[i] <= Constants::lambdaIon())
-            pv[i] = (1. - conversionFraction()) * sedFamilyOriginal()->specificLuminosity(lambdav[i], parameters);
+            pv[i] *= (1. - conversionFraction());
         else
-            pv[i] = sedFamilyOriginal()->specificLuminosity(lambdav[i], parameters)
-                    + ionizingLuminosity * conversionFraction() * sedLymanAlpha()->specificLuminosity(lambdav[i]);
+            pv[i] += ionizingLuminosity * conversionFraction() * sedLymanAlpha()->specificLuminosity(lambdav[i]);
     }
 
     // calculate the cumulative distribution and normalization
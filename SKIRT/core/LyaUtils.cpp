@@ -22,29 +22,20 @@ namespace
 
 ////////////////////////////////////////////////////////////////////
 
-double LyaUtils::section(double lambda, double T)
+double LyaUtils::section(double lambda, double T, bool tabulated)
 {
     double vth = sqrt(2. * kB / mp * T);                 // thermal velocity for T
     double a = Aa * la / 4. / M_PI / vth;                // Voigt parameter
     double x = (la - lambda) / lambda * c / vth;         // dimensionless frequency
     double sigma0 = 3. * la * la * M_2_SQRTPI / 4. * a;  // cross section at line center
-    return sigma0 * VoigtProfile::value(a, x);           // cross section at given x
+    double H = tabulated ? VoigtProfile::tabulatedValue(a, x) : VoigtProfile::value(a, x);
+    return sigma0 * H;  // cross section at given x
 }
 
 ////////////////////////////////////////////////////////////////////
 
-std::pair<Vec, bool> LyaUtils::sampleAtomVelocity(double lambda, double T, double nH, Direction kin,
-                                                  Configuration* config, Random* random)
+double LyaUtils::criticalFrequency(double T, double nH, double V, const Configuration* config)
 {
-    double vth = sqrt(2. * kB / mp * T);          // thermal velocity for T
-    double a = Aa * la / 4. / M_PI / vth;         // Voigt parameter
-    double x = (la - lambda) / lambda * c / vth;  // dimensionless frequency
-
-    // generate two directions that are orthogonal to each other and to the incoming photon packet direction
-    Direction k1 = (kin.kx() || kin.ky()) ? Direction(kin.ky(), -kin.kx(), 0., true) : Direction(1., 0., 0., false);
-    Direction k2(Vec::cross(k1, kin), false);
-
-    // select the critical value of the dimensionless frequency depending on the acceleration scheme;
     // leaving the value at zero is equivalent to no acceleration
     double xcrit = 0.;
     switch (config->lyaAccelerationScheme())
@@ -60,7 +51,55 @@ std::pair<Vec, bool> LyaUtils::sampleAtomVelocity(double lambda, double T, doubl
             xcrit = config->lyaAccelerationStrength() * pow(nH / T, 1. / 6.);
             break;
         }
+        case Configuration::LyaAccelerationScheme::Dynamic:
+        {
+            double vth = sqrt(2. * kB / mp * T);                 // thermal velocity for T
+            double a = Aa * la / 4. / M_PI / vth;                // Voigt parameter
+            double sigma0 = 3. * la * la * M_2_SQRTPI / 4. * a;  // cross section at line center
+            double atau0 = a * nH * sigma0 * 0.5 * cbrt(V);      // a times optical depth from cell center to border
+            xcrit = config->lyaAccelerationStrength() * dynamicCriticalFrequency(atau0);
+            break;
+        }
     }
+    return xcrit;
+}
+
+////////////////////////////////////////////////////////////////////
+
+double LyaUtils::dynamicCriticalFrequency(double atau0)
+{
+    if (atau0 <= 1.) return 0.;
+
+    // fitting formula by Laursen et al. 2009, with different coefficients for moderate and large optical depths
+    double lnatau0 = log(atau0);
+    double exponent = atau0 <= 60. ? 0.6 * pow(lnatau0, 1.2) : 1.4 * pow(lnatau0, 0.6);
+    return 0.02 * exp(exponent);
+}
+
+////////////////////////////////////////////////////////////////////
+
+double LyaUtils::coreReductionFactor(double x, double T)
+{
+    double vth = sqrt(2. * kB / mp * T);   // thermal velocity for T
+    double a = Aa * la / 4. / M_PI / vth;  // Voigt parameter
+    return VoigtProfile::value(a, 0.) / VoigtProfile::value(a, x);
+}
+
+////////////////////////////////////////////////////////////////////
+
+std::pair<Vec, bool> LyaUtils::sampleAtomVelocity(double lambda, double T, double nH, double V, Direction kin,
+                                                  Configuration* config, Random* random)
+{
+    double vth = sqrt(2. * kB / mp * T);          // thermal velocity for T
+    double a = Aa * la / 4. / M_PI / vth;         // Voigt parameter
+    double x = (la - lambda) / lambda * c / vth;  // dimensionless frequency
+
+    // generate two directions that are orthogonal to each other and to the incoming photon packet direction
+    Direction k1 = (kin.kx() || kin.ky()) ? Direction(kin.ky(), -kin.kx(), 0., true) : Direction(1., 0., 0., false);
+    Direction k2(Vec::cross(k1, kin), false);
+
+    // select the critical value of the dimensionless frequency depending on the acceleration scheme
+    double xcrit = criticalFrequency(T, nH, V, config);
 
     // apply the acceleration only to core scatterings, with xcrit defining the transition between core and wings
     if (abs(x) > xcrit) xcrit = 0.;
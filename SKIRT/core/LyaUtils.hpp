@@ -106,8 +106,30 @@ namespace LyaUtils
 {
     /** This function returns the Lyman-alpha scattering cross section per hydrogen atom
         \f$\sigma_\alpha(\lambda, T)\f$ at the given photon wavelength and gas temperature, using
-        the definition given in the class header. */
-    double section(double lambda, double T);
+        the definition given in the class header. If the \em tabulated flag is true, the Voigt
+        function is evaluated through interpolation in a precalculated table rather than directly
+        (see VoigtProfile::tabulatedValue()). */
+    double section(double lambda, double T, bool tabulated = false);
+
+    /** This function returns the critical dimensionless frequency \f$x_\mathrm{crit}\f$ below
+        which the Lyman-alpha acceleration scheme configured for the simulation moves scattering
+        photon packets from the core to the wings of the line, given the hydrogen temperature, the
+        hydrogen number density and the volume of the spatial cell hosting the scattering event.
+        The various acceleration schemes are described for the LyaOptions class. If acceleration
+        is disabled, the function returns zero. */
+    double criticalFrequency(double T, double nH, double V, const Configuration* config);
+
+    /** This function returns the critical dimensionless frequency \f$x_\mathrm{crit}\f$ for the
+        dynamic acceleration scheme with unit acceleration strength, given the product
+        \f$a\tau_0\f$ of the Voigt parameter and the line-center optical depth of the spatial
+        cell hosting the scattering event, using the fitting formula of Laursen et al. 2009 (see
+        the LyaOptions class). The function returns zero for \f$a\tau_0\le 1\f$. */
+    double dynamicCriticalFrequency(double atau0);
+
+    /** This function returns the factor \f$\sigma_\alpha(0,T)/\sigma_\alpha(x,T)\f$ by which
+        the Lyman-alpha scattering cross section per hydrogen atom at the given gas temperature
+        decreases when moving from the line center to the given dimensionless frequency. */
+    double coreReductionFactor(double x, double T);
 
     /** This function draws a random hydrogen atom velocity as seen by an incoming photon from the
         appropriate probability distributions, reflecting the preference for photons to be
@@ -115,8 +137,9 @@ namespace LyaUtils
         whether the photon scatters through the isotropic or dipole phase function.
 
         The function arguments include the photon packet wavelength as it is perceived in the local
-        gas frame and the hydrogen temperature and number density in the current spatial cell. The
-        latter two values are used in the variable acceleration scheme. The return value is a pair:
+        gas frame and the hydrogen temperature, the hydrogen number density and the volume of the
+        current spatial cell. The latter three values are used to determine the critical frequency
+        for the configured acceleration scheme (see criticalFrequency()). The return value is a pair:
         the first item is the atom velocity and the second item is true for the dipole phase
         function and false for isotropic scattering.
 
@@ -141,8 +164,8 @@ namespace LyaUtils
         - Return the atom velocity and a flag indicating the selected phase function.
 
         */
-    std::pair<Vec, bool> sampleAtomVelocity(double lambda, double T, double nH, Direction kin, Configuration* config,
-                                            Random* random);
+    std::pair<Vec, bool> sampleAtomVelocity(double lambda, double T, double nH, double V, Direction kin,
+                                            Configuration* config, Random* random);
 
     /** This function returns the Doppler-shifted wavelength in the gas bulk rest frame after a
         Lyman-alpha scattering event, given the incoming wavelength in the gas bulk rest frame, the
@@ -58,6 +58,20 @@ double MappingsSEDFamily::specificLuminosity(double wavelength, const Array& par
 
 ////////////////////////////////////////////////////////////////////
 
+void MappingsSEDFamily::specificLuminosities(Array& Lv, const Array& lambdav, const Array& parameters) const
+{
+    double SFR = parameters[0] / Constants::Msun() * Constants::year();
+    double Z = parameters[1];
+    double logC = parameters[2];
+    double p = parameters[3];
+    double fPDR = parameters[4];
+
+    _table.valueArray(Lv, lambdav, Z, logC, p, fPDR);
+    Lv *= SFR;
+}
+
+////////////////////////////////////////////////////////////////////
+
 double MappingsSEDFamily::cdf(Array& lambdav, Array& pv, Array& Pv, const Range& wavelengthRange,
                               const Array& parameters) const
 {
@@ -154,6 +154,26 @@ Array MaterialMix::emissionSpectrum(const MaterialState* /*state*/, const Array&
 
 ////////////////////////////////////////////////////////////////////
 
+vector<Array> MaterialMix::emissivities(const vector<Array>& Jvv) const
+{
+    vector<Array> evv;
+    evv.reserve(Jvv.size());
+    for (const Array& Jv : Jvv) evv.push_back(emissivity(Jv));
+    return evv;
+}
+
+////////////////////////////////////////////////////////////////////
+
+vector<Array> MaterialMix::emissionSpectra(const vector<const MaterialState*>& states, const vector<Array>& Jvv) const
+{
+    vector<Array> evv;
+    evv.reserve(Jvv.size());
+    for (size_t i = 0; i != Jvv.size(); ++i) evv.push_back(emissionSpectrum(states[i], Jvv[i]));
+    return evv;
+}
+
+////////////////////////////////////////////////////////////////////
+
 const Array& MaterialMix::thetaGrid() const
 {
     throw FATALERROR("This function implementation should never be called");
@@ -175,6 +195,13 @@ const Array& MaterialMix::sectionsAbspol(double /*lambda*/) const
 
 ////////////////////////////////////////////////////////////////////
 
+const Array& MaterialMix::cumulativeSectionsAbs(double /*lambda*/) const
+{
+    throw FATALERROR("This function implementation should never be called");
+}
+
+////////////////////////////////////////////////////////////////////
+
 Array MaterialMix::lineEmissionCenters() const
 {
     throw FATALERROR("This function implementation should never be called");
@@ -519,6 +519,26 @@ public:
         fatal error. */
     virtual Array emissionSpectrum(const MaterialState* state, const Array& Jv) const;
 
+    /** This function returns the continuum emissivity spectra for a batch of radiation fields,
+        for example corresponding to a block of spatial cells. The input radiation fields and
+        output emissivity spectra are discretized as described for the emissivity() function, and
+        the results are identical to those returned by that function for each of the radiation
+        fields separately. Subclasses can override this function to process the batch more
+        efficiently. The default implementation in this base class simply calls the emissivity()
+        function for each radiation field in turn. */
+    virtual vector<Array> emissivities(const vector<Array>& Jvv) const;
+
+    /** This function returns the continuum emission spectra for a batch of spatial cells
+        represented by the specified material states, each embedded in the corresponding radiation
+        field. The number of material states and radiation fields must be the same. The input
+        radiation fields and output emission spectra are discretized as described for the
+        emissionSpectrum() function, and the results are identical to those returned by that
+        function for each of the cells separately. Subclasses can override this function to
+        process the batch more efficiently. The default implementation in this base class simply
+        calls the emissionSpectrum() function for each cell in turn. */
+    virtual vector<Array> emissionSpectra(const vector<const MaterialState*>& states,
+                                          const vector<Array>& Jvv) const;
+
     /** This function is intended for use with the SpheroidalPolarization mode. It returns the grid
         used for discretizing quantities that are a function of the scattering/emission angle
         \f$\theta\f$. The same grid is returned by all material mixes that have
@@ -540,6 +560,18 @@ public:
         implementation in this base class throws a fatal error. */
     virtual const Array& sectionsAbspol(double lambda) const;
 
+    /** This function is intended for use with the SpheroidalPolarization mode. It returns the
+        unnormalized cumulative distribution \f$C_t\f$ of the absorption cross sections per entity
+        at wavelength \f$\lambda\f$ over the emission angle \f$\theta\f$, discretized on the grid
+        returned by the thetaGrid() function. The distribution is obtained through trapezoidal
+        integration of \f$\varsigma ^{\text{abs}} _{\lambda} (\theta)\,\sin\theta\f$, omitting the
+        common factors, i.e. \f$C_0=0\f$ and \f$C_t = C_{t-1} + s_{t-1} + s_t\f$ with \f$s_t =
+        \varsigma ^{\text{abs}} _{\lambda} (\theta_t)\,\sin\theta_t\f$. Because the distribution is
+        linear in the cross sections, the distribution for a mixture of material mixes can be
+        obtained as the density-weighted sum of the distributions for the individual mixes. The
+        default implementation in this base class throws a fatal error. */
+    virtual const Array& cumulativeSectionsAbs(double lambda) const;
+
     //======== Secondary line emission =======
 
 public:
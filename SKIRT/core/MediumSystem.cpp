@@ -9,7 +9,6 @@
 #include "DensityInCellInterface.hpp"
 #include "DisjointWavelengthGrid.hpp"
 #include "FatalError.hpp"
-#include "LockFree.hpp"
 #include "Log.hpp"
 #include "LyaUtils.hpp"
 #include "MaterialMix.hpp"
@@ -22,6 +21,7 @@
 #include "ProcessManager.hpp"
 #include "Random.hpp"
 #include "ShortArray.hpp"
+#include "SourceSystem.hpp"
 #include "StringUtils.hpp"
 
 ////////////////////////////////////////////////////////////////////
@@ -218,14 +218,25 @@ void MediumSystem::setupSelfAfter()
     if (_config->hasRadiationField())
     {
         _wavelengthGrid = _config->radiationFieldWLG();
-        _rf1.resize(_numCells, _wavelengthGrid->numBins());
-        allocatedBytes += _rf1.size() * sizeof(double);
+
+        // when storing in single precision, scale the accumulated values (luminosity times path length)
+        // by the product of the total source luminosity and the size of the spatial domain
+        bool singlePrecision = radiationFieldOptions()->storeRadiationFieldInSinglePrecision();
+        double scale = 1.;
+        if (singlePrecision)
+        {
+            double L = find<SourceSystem>()->luminosity();
+            double D = _grid->boundingBox().diagonal();
+            if (L > 0. && D > 0.) scale = 1. / (L * D);
+        }
+        _rf1.resize(_numCells, _wavelengthGrid->numBins(), singlePrecision, scale);
+        allocatedBytes += _rf1.numBytes();
 
         if (_config->hasSecondaryRadiationField())
         {
-            _rf2.resize(_numCells, _wavelengthGrid->numBins());
-            _rf2c.resize(_numCells, _wavelengthGrid->numBins());
-            allocatedBytes += 2 * _rf2.size() * sizeof(double);
+            _rf2.resize(_numCells, _wavelengthGrid->numBins(), singlePrecision, scale);
+            _rf2c.resize(_numCells, _wavelengthGrid->numBins(), singlePrecision, scale);
+            allocatedBytes += 2 * _rf2.numBytes();
         }
     }
 
@@ -396,6 +407,49 @@ void MediumSystem::setupSelfAfter()
     _state.calculateAggregate();
 
     log->info("Done calculating medium properties");
+
+    // if the simulation includes Lyman-alpha line transfer with acceleration, log statistics on the critical
+    // frequency in the spatial cells and on the corresponding reduction of the cross section for core photons
+    if (_config->lyaAccelerationScheme() != Configuration::LyaAccelerationScheme::None)
+    {
+        vector<double> xcritv;
+        vector<double> reductionv;
+        for (int h = 0; h != _numMedia; ++h)
+        {
+            if (mix(0, h)->hasResonantScattering())
+            {
+                for (int m = 0; m != _numCells; ++m)
+                {
+                    // skip cells with zero volume, which are never visited by photon packets
+                    double nH = numberDensity(m, h);
+                    if (nH > 0. && volume(m) > 0.)
+                    {
+                        double T = temperature(m, h);
+                        double xcrit = LyaUtils::criticalFrequency(T, nH, volume(m), _config);
+                        xcritv.push_back(xcrit);
+                        reductionv.push_back(LyaUtils::coreReductionFactor(xcrit, T));
+                    }
+                }
+            }
+        }
+        if (!xcritv.empty())
+        {
+            size_t numValues = xcritv.size();
+            size_t numActive = std::count_if(xcritv.begin(), xcritv.end(), [](double xcrit) { return xcrit > 0.; });
+            auto minmax = std::minmax_element(xcritv.begin(), xcritv.end());
+            double xcritMin = *minmax.first;
+            double xcritMax = *minmax.second;
+            std::nth_element(xcritv.begin(), xcritv.begin() + numValues / 2, xcritv.end());
+            std::nth_element(reductionv.begin(), reductionv.begin() + numValues / 2, reductionv.end());
+            log->info("Lyman-alpha acceleration is active in " + std::to_string(numActive) + " out of "
+                      + std::to_string(numValues) + " cells with neutral hydrogen");
+            log->info("  Critical frequency x_crit ranges from " + StringUtils::toString(xcritMin, 'g', 3) + " to "
+                      + StringUtils::toString(xcritMax, 'g', 3) + " with median "
+                      + StringUtils::toString(xcritv[numValues / 2], 'g', 3));
+            log->info("  Median ratio of line-center to critical-frequency cross section: "
+                      + StringUtils::toString(reductionv[numValues / 2], 'g', 3));
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -1293,9 +1347,9 @@ void MediumSystem::clearRadiationField(bool primary)
 void MediumSystem::storeRadiationField(bool primary, int m, int ell, double Lds)
 {
     if (primary)
-        LockFree::add(_rf1(m, ell), Lds);
+        _rf1.add(m, ell, Lds);
     else
-        LockFree::add(_rf2c(m, ell), Lds);
+        _rf2c.add(m, ell, Lds);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -1303,10 +1357,10 @@ void MediumSystem::storeRadiationField(bool primary, int m, int ell, double Lds)
 void MediumSystem::communicateRadiationField(bool primary)
 {
     if (primary)
-        ProcessManager::sumToAll(_rf1.data());
+        _rf1.sumToAll();
     else
     {
-        ProcessManager::sumToAll(_rf2c.data());
+        _rf2c.sumToAll();
         _rf2 = _rf2c;
     }
 }
@@ -1370,6 +1424,7 @@ Array MediumSystem::meanIntensity(int m) const
 {
     int numWavelengths = _wavelengthGrid->numBins();
     Array Jv(numWavelengths);
+    if (_state.volume(m) <= 0.) return Jv;
     double factor = 1. / (4. * M_PI * _state.volume(m));
     for (int ell = 0; ell < numWavelengths; ell++)
     {
@@ -1476,6 +1531,42 @@ Array MediumSystem::dustEmissionSpectrum(int m) const
 
 ////////////////////////////////////////////////////////////////////
 
+vector<Array> MediumSystem::dustEmissionSpectra(const vector<int>& mv) const
+{
+    int numCells = mv.size();
+    vector<Array> Jvv;
+    Jvv.reserve(numCells);
+    for (int m : mv) Jvv.push_back(meanIntensity(m));
+
+    vector<Array> evv(numCells, Array(_numDustEmissionWavelengths));
+    for (int h : _dust_hv)
+    {
+        // construct the material states for this medium component
+        vector<MaterialState> states;
+        states.reserve(numCells);
+        for (int m : mv) states.emplace_back(_state, m, h);
+        vector<const MaterialState*> statePointers;
+        for (const MaterialState& mst : states) statePointers.push_back(&mst);
+
+        // if all cells share the same material mix, process them as a batch; otherwise process each cell separately
+        const MaterialMix* mixh = mix(mv[0], h);
+        bool sameMix = true;
+        for (int m : mv) sameMix &= mix(m, h) == mixh;
+        if (sameMix)
+        {
+            vector<Array> ehvv = mixh->emissionSpectra(statePointers, Jvv);
+            for (int i = 0; i != numCells; ++i) evv[i] += ehvv[i];
+        }
+        else
+        {
+            for (int i = 0; i != numCells; ++i) evv[i] += mix(mv[i], h)->emissionSpectrum(statePointers[i], Jvv[i]);
+        }
+    }
+    return evv;
+}
+
+////////////////////////////////////////////////////////////////////
+
 Array MediumSystem::continuumEmissionSpectrum(int m, int h) const
 {
     const Array& Jv = meanIntensity(m);
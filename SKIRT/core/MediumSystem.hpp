@@ -6,6 +6,7 @@
 #ifndef MEDIUMSYSTEM_HPP
 #define MEDIUMSYSTEM_HPP
 
+#include "AccumulationTable.hpp"
 #include "Array.hpp"
 #include "DustEmissionOptions.hpp"
 #include "DynamicStateOptions.hpp"
@@ -239,7 +240,8 @@ public:
     //=============== Medium state ===================
 
 public:
-    /** This function returns the volume of the spatial cell with index \f$m\f$. */
+    /** This function returns the volume of the spatial cell with index \f$m\f$. The volume may be
+        zero (see SpatialGrid::volume()); such a cell is never crossed by a photon packet path. */
     double volume(int m) const;
 
     /** This function returns the aggregate bulk velocity \f${\boldsymbol{v}}\f$ of the medium in
@@ -662,7 +664,9 @@ public:
         spatial cell index, \f$V_m\f$ is the volume of the cell, and \f$(L\Delta s)_{\ell,m}\f$ has
         been accumulated over all photon packets contributing to the bin. The resulting mean
         intensity \f$J_\lambda\f$ is expressed as an amount of energy per unit of time, per unit of
-        area, per unit of wavelength, and per unit of solid angle. */
+        area, per unit of wavelength, and per unit of solid angle. For a cell with zero volume, such
+        as an outer cell completely covered by an inner grid in a CompositeSpatialGrid, the
+        function returns an array of zeros. */
     Array meanIntensity(int m) const;
 
     //=============== Indicative temperature ===================
@@ -769,6 +773,15 @@ public:
         normalizing the spectrum based on the value returned by the dustLuminosity() function. */
     Array dustEmissionSpectrum(int m) const;
 
+    /** This function returns the combined emission spectrum for all dust media in each of the
+        spatial cells with the specified indices. The result for each cell is identical to the
+        spectrum returned by the dustEmissionSpectrum() function for that cell. However, when
+        the material mix for a given medium component is the same in all of the specified cells,
+        the spectra for that component are obtained through a single call to the
+        MaterialMix::emissionSpectra() function, allowing the material mix to process the cells as
+        a batch. */
+    vector<Array> dustEmissionSpectra(const vector<int>& mv) const;
+
     /** This function returns the continuum emission spectrum in the spatial cell with index
         \f$m\f$ for the medium component with index \f$h\f$. It is intended for use with gas medium
         components that support secondary continuum emission. When invoked for other medium
@@ -861,9 +874,9 @@ private:
     // - the sum of rf1 and rf2 represents the stable radiation field to be used as input for regular calculations
     // - rf2c serves as a target for storing the secondary radiation field so that rf1+rf2 remain available for
     //   calculating secondary emission spectra while already shooting photons through the grid
-    Table<2> _rf1;   // radiation field from primary sources
-    Table<2> _rf2;   // radiation field from secondary sources (copied from _rf2c at the appropriate time)
-    Table<2> _rf2c;  // radiation field currently being accumulated from secondary sources
+    AccumulationTable _rf1;   // radiation field from primary sources
+    AccumulationTable _rf2;   // radiation field from secondary sources (copied from _rf2c at the appropriate time)
+    AccumulationTable _rf2c;  // radiation field currently being accumulated from secondary sources
 
     // relevant for any simulation mode that includes dust emission
     int _numDustEmissionWavelengths{0};
@@ -15,3 +15,10 @@ void Mesh::setNumBins(int value)
 }
 
 ////////////////////////////////////////////////////////////////////
+
+double Mesh::inverseMesh(double /*t*/) const
+{
+    return -1.;
+}
+
+////////////////////////////////////////////////////////////////////
@@ -41,6 +41,19 @@ public:
     /** This pure virtual function returns an array containing the \f$N+1\f$ mesh points
         \f$\{t_i\}\f$ in ascending order, with \f$t_0=0\f$ and \f$t_N=1\f$. */
     virtual Array mesh() const = 0;
+
+    /** This function returns the (generally non-integer) mesh point index \f$s\f$ corresponding to
+        the normalized coordinate \f$0\le t\le 1\f$. In other words, it implements the inverse of
+        the formula used to generate the mesh points, so that the bin containing \f$t\f$ has index
+        \f$\lfloor s \rfloor\f$. This allows clients to locate the bin for a given coordinate in
+        constant time rather than through a binary search. Because of rounding errors, the
+        resulting bin index may be off by one, so the client should verify it against the actual
+        mesh points.
+
+        If the mesh point distribution does not have an analytic inverse, the function returns a
+        negative value, indicating that the client should search the mesh points instead. The
+        implementation in this base class always returns -1. */
+    virtual double inverseMesh(double t) const;
 };
 
 //////////////////////////////////////////////////////////////////////
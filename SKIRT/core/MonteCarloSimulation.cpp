@@ -14,6 +14,7 @@
 #include "ShortArray.hpp"
 #include "SpecialFunctions.hpp"
 #include "StringUtils.hpp"
+#include "System.hpp"
 #include "TimeLogger.hpp"
 
 ////////////////////////////////////////////////////////////////////
@@ -23,9 +24,16 @@ void MonteCarloSimulation::setupSimulation()
     // perform regular setup for the hierarchy and wait for all processes to finish
     {
         TimeLogger logger(log(), "setup");
+        auto startFaults = System::pageFaults();
         _config->setup();  // first of all perform setup for the configuration object
         SimulationItem::setup();
         wait("setup");
+
+        // report the page faults incurred during setup, which include the first accesses to memory-mapped
+        // resources and input files, to help diagnose file system performance issues
+        auto endFaults = System::pageFaults();
+        log()->info("Page faults during setup: " + std::to_string(endFaults.first - startFaults.first) + " major, "
+                    + std::to_string(endFaults.second - startFaults.second) + " minor");
     }
 
     // write setup output
@@ -4,6 +4,7 @@
 ///////////////////////////////////////////////////////////////// */
 
 #include "MultiGrainDustMix.hpp"
+#include "BinaryCache.hpp"
 #include "Configuration.hpp"
 #include "Constants.hpp"
 #include "FatalError.hpp"
@@ -67,6 +68,45 @@ double MultiGrainDustMix::getOpticalProperties(const Array& lambdav, const Array
     // get the number of requested grid points
     int numLambda = lambdav.size();
 
+    // if requested, attempt to load the optical properties from a cache file; the cache file holds the dust mass
+    // per hydrogen atom, the available wavelength range, the mass and normalization for each population, and the
+    // contents of the output arrays and tables
+    std::unique_ptr<BinaryCache> cache;
+    vector<Array*> outputs;
+    if (cacheOpticalProperties())
+    {
+        outputs = {&sigmaabsv, &sigmascav, &asymmparv, &S11vv.data(), &S12vv.data(), &S33vv.data(), &S34vv.data()};
+        if (needSpheroidalPolarization)
+            for (int ell = 0; ell != numLambda; ++ell)
+            {
+                outputs.push_back(&sigmaabsvv[ell]);
+                outputs.push_back(&sigmaabspolvv[ell]);
+            }
+        size_t numValues = 3 + 2 * numPops;
+        for (const Array* output : outputs) numValues += output->size();
+
+        cache = std::make_unique<BinaryCache>(this, "dustmix");
+        addCacheKey(*cache, lambdav, thetav);
+        if (cache->load(numValues))
+        {
+            const double* data = cache->data();
+            double mu = data[0];
+            Range availableWavelengthRange(data[1], data[2]);
+            data += 3;
+            _mupopv.assign(data, data + numPops);
+            data += numPops;
+            _normv.assign(data, data + numPops);
+            data += numPops;
+            for (Array* output : outputs)
+            {
+                std::copy(data, data + output->size(), begin(*output));
+                data += output->size();
+            }
+            informAvailableWavelengthRange(availableWavelengthRange);
+            return mu;
+        }
+    }
+
     // dust mass per hydrogen atom accumulated over all populations
     double mu = 0.;
 
@@ -323,6 +363,16 @@ double MultiGrainDustMix::getOpticalProperties(const Array& lambdav, const Array
         }
     }
 
+    // if requested, store the optical properties in a cache file
+    if (cache)
+    {
+        vector<double> values({mu, availableWavelengthRange.min(), availableWavelengthRange.max()});
+        values.insert(values.end(), _mupopv.begin(), _mupopv.end());
+        values.insert(values.end(), _normv.begin(), _normv.end());
+        for (const Array* output : outputs) values.insert(values.end(), begin(*output), end(*output));
+        cache->store(values);
+    }
+
     // log warning if the simulation wavelength range extends beyond the optical property range
     informAvailableWavelengthRange(availableWavelengthRange);
 
@@ -347,6 +397,21 @@ size_t MultiGrainDustMix::initializeExtraProperties(const Array& lambdav)
         // allocate temporary array for size-bin-integrated absorption cross sections
         Array sigmaabsv(numLambda);
 
+        // if requested, attempt to load the size-bin-integrated absorption cross sections from a cache file;
+        // otherwise, gather the calculated cross sections so that they can be stored in a cache file later on
+        std::unique_ptr<BinaryCache> cache;
+        const double* cachedData = nullptr;
+        vector<double> calculatedValues;
+        if (cacheOpticalProperties())
+        {
+            size_t numBins = 0;
+            for (auto population : _populations) numBins += population->numSizes();
+
+            cache = std::make_unique<BinaryCache>(this, "dustbins");
+            addCacheKey(*cache, lambdav, Array());
+            if (cache->load(numBins * numLambda)) cachedData = cache->data();
+        }
+
         // loop over all populations and process size bins for each
         int c = 0;  // population index
         for (auto population : _populations)
@@ -394,26 +459,36 @@ size_t MultiGrainDustMix::initializeExtraProperties(const Array& lambdav)
                     weightv[numSizes - 1] *= 0.5;
                 }
 
-                // size-integrate the absorption cross sections for this bin
-                // this can take a few seconds for all populations/size bins combined,
-                // so we parallelize the loop but there is no reason to log progress
-                sigmaabsv = 0;  // clear array in case calculation is distributed over multiple processes
-                find<ParallelFactory>()->parallelDistributed()->call(
-                    numLambda,
-                    [&lambdav, &av, &dav, &dndav, &weightv, &Qabs, &sigmaabsv](size_t firstIndex, size_t numIndices) {
-                        size_t numSizes = av.size();
-                        for (size_t ell = firstIndex; ell != firstIndex + numIndices; ++ell)
-                        {
-                            double sum = 0.;
-                            for (size_t i = 0; i != numSizes; ++i)
+                // get the size-integrated absorption cross sections for this bin from the cache, if available
+                if (cachedData)
+                {
+                    std::copy(cachedData, cachedData + numLambda, begin(sigmaabsv));
+                    cachedData += numLambda;
+                }
+                else
+                {
+                    // otherwise, size-integrate the absorption cross sections for this bin
+                    // this can take a few seconds for all populations/size bins combined,
+                    // so we parallelize the loop but there is no reason to log progress
+                    sigmaabsv = 0;  // clear array in case calculation is distributed over multiple processes
+                    find<ParallelFactory>()->parallelDistributed()->call(
+                        numLambda, [&lambdav, &av, &dav, &dndav, &weightv, &Qabs, &sigmaabsv](size_t firstIndex,
+                                                                                             size_t numIndices) {
+                            size_t numSizes = av.size();
+                            for (size_t ell = firstIndex; ell != firstIndex + numIndices; ++ell)
                             {
-                                double area = M_PI * av[i] * av[i];
-                                sum += weightv[i] * dndav[i] * area * Qabs(av[i], lambdav[ell]) * dav[i];
+                                double sum = 0.;
+                                for (size_t i = 0; i != numSizes; ++i)
+                                {
+                                    double area = M_PI * av[i] * av[i];
+                                    sum += weightv[i] * dndav[i] * area * Qabs(av[i], lambdav[ell]) * dav[i];
+                                }
+                                sigmaabsv[ell] = sum;
                             }
-                            sigmaabsv[ell] = sum;
-                        }
-                    });
-                ProcessManager::sumToAll(sigmaabsv);
+                        });
+                    ProcessManager::sumToAll(sigmaabsv);
+                    if (cache) calculatedValues.insert(calculatedValues.end(), begin(sigmaabsv), end(sigmaabsv));
+                }
 
                 // setup the appropriate emissivity calculator for this bin
                 if (_stochastic)
@@ -445,6 +520,9 @@ size_t MultiGrainDustMix::initializeExtraProperties(const Array& lambdav)
             // increment the population index
             c++;
         }
+
+        // if requested and not loaded, store the size-bin-integrated absorption cross sections in a cache file
+        if (cache && !cachedData) cache->store(calculatedValues);
     }
 
     // determine the allocated number of bytes
@@ -459,6 +537,28 @@ size_t MultiGrainDustMix::initializeExtraProperties(const Array& lambdav)
 
 ////////////////////////////////////////////////////////////////////
 
+void MultiGrainDustMix::addCacheKey(BinaryCache& cache, const Array& lambdav, const Array& thetav) const
+{
+    // the configuration of the dust mix, including any user-configured grain populations
+    cache.addKey(this);
+
+    // the resources used by the grain populations, which may have been added by a subclass
+    for (auto population : _populations)
+    {
+        cache.addKey(population->composition()->resourceNameForOpticalProps());
+        cache.addKey(population->composition()->resourceNameForMuellerMatrix());
+    }
+
+    // the scattering mode and the grids on which the properties are tabulated
+    cache.addKey(static_cast<double>(scatteringMode()));
+    cache.addKey(static_cast<double>(lambdav.size()));
+    cache.addKey(begin(lambdav), lambdav.size() * sizeof(double));
+    cache.addKey(static_cast<double>(thetav.size()));
+    cache.addKey(begin(thetav), thetav.size() * sizeof(double));
+}
+
+////////////////////////////////////////////////////////////////////
+
 bool MultiGrainDustMix::hasStochasticDustEmission() const
 {
     return true;
@@ -477,6 +577,15 @@ Array MultiGrainDustMix::emissivity(const Array& Jv) const
 
 ////////////////////////////////////////////////////////////////////
 
+vector<Array> MultiGrainDustMix::emissivities(const vector<Array>& Jvv) const
+{
+    // use the appropriate emissivity calculator
+    if (_stochastic) return MaterialMix::emissivities(Jvv);
+    return _calcEq.emissivities(Jvv);
+}
+
+////////////////////////////////////////////////////////////////////
+
 int MultiGrainDustMix::numPopulations() const
 {
     return _populations.size();
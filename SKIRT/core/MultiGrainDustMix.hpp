@@ -12,6 +12,7 @@
 #include "MultiGrainPopulationInterface.hpp"
 #include "StochasticDustEmissionCalculator.hpp"
 #include "StoredTable.hpp"
+class BinaryCache;
 class GrainComposition;
 class GrainSizeDistribution;
 
@@ -105,10 +106,30 @@ class GrainSizeDistribution;
     accurate but also much slower. See the StochasticDustEmissionCalculator class for more
     information.
 
+    <b>Caching optical properties</b>
+
+    Integrating the optical properties over the grain size distribution can take a substantial
+    amount of time, especially for dust mixes with Mueller matrices or many size bins. If the \em
+    cacheOpticalProperties flag is enabled, the size-integrated properties (the representative
+    cross sections, asymmetry parameters and Mueller matrix coefficients, and the absorption cross
+    sections for each size bin used for calculating emission) are stored in binary cache files in
+    the output directory (see the BinaryCache class). A subsequent simulation with the same dust mix
+    configuration and the same wavelength and scattering angle grids loads these properties from
+    the cache files through a memory map rather than recalculating them. The emission calculators
+    are still initialized from the loaded cross sections, which is relatively fast. Note that the
+    fingerprint identifying the cache file includes the names of the built-in resources used by the
+    grain compositions but not their contents, so the cache files should be removed after
+    installing an updated version of these resources.
+
     */
 class MultiGrainDustMix : public DustMix, public MultiGrainPopulationInterface
 {
     ITEM_ABSTRACT(MultiGrainDustMix, DustMix, "a dust mix with one or more grain populations")
+
+        PROPERTY_BOOL(cacheOpticalProperties, "cache the optical properties for use by subsequent simulations")
+        ATTRIBUTE_DEFAULT_VALUE(cacheOpticalProperties, "false")
+        ATTRIBUTE_DISPLAYED_IF(cacheOpticalProperties, "Level3")
+
     ITEM_END()
 
     //============= Construction - Setup - Destruction =============
@@ -175,6 +196,12 @@ protected:
         requested). */
     size_t initializeExtraProperties(const Array& lambdav) override;
 
+private:
+    /** This function adds the information on which the cached optical properties depend to the
+        key of the specified cache, i.e. the configuration of this dust mix, the resource names
+        used by its grain populations, and the specified wavelength and scattering angle grids. */
+    void addCacheKey(BinaryCache& cache, const Array& lambdav, const Array& thetav) const;
+
     //======================== Capabilities =======================
 
 public:
@@ -201,6 +228,12 @@ public:
         function relies. */
     Array emissivity(const Array& Jv) const override;
 
+    /** This function returns the emissivity spectra for a batch of radiation fields, as described
+        for the emissivity() function. For equilibrium emission, the complete batch is handed to
+        the equilibrium emission calculator. For stochastic emission, the emissivity is calculated
+        for each radiation field in turn. */
+    vector<Array> emissivities(const vector<Array>& Jvv) const override;
+
     //=========== Exposing multiple grain populations (MultiGrainPopulationInterface) ============
 
 public:
@@ -11,6 +11,7 @@
 #include "Log.hpp"
 #include "MaterialState.hpp"
 #include "NR.hpp"
+#include "RateEquationSolver.hpp"
 #include "StringUtils.hpp"
 #include "TextInFile.hpp"
 #include "Units.hpp"
@@ -327,47 +328,12 @@ void NonLTELineGasMix::initializeSpecificState(MaterialState* state, double /*me
 
 namespace
 {
-    // solve the square set of linear equations represented by the given matrix using LU decomposition
-    // the matrix should have N rows and N+1 columns; its contents is overwritten and
-    // the solution is returned as an array of size N
-    Array solveMatrixEquation(vector<vector<double>>& matrix)
-    {
-        size_t size = matrix.size();
-        Array solution(size);
-
-        // forwarding elimination
-        for (size_t i = 0; i < size; i++) solution[i] = matrix[i][size];
-
-        // decomposition
-        for (size_t k = 0; k < size - 1; ++k)
-        {
-            if (matrix[k][k] == 0.0)
-            {
-                std::swap(matrix[k], matrix[k + 1]);
-                std::swap(solution[k], solution[k + 1]);
-            }
-            for (size_t i = k + 1; i < size; ++i)
-            {
-                double inverse = matrix[i][k] / matrix[k][k];
-                for (size_t j = k + 1; j < size; ++j) matrix[i][j] -= inverse * matrix[k][j];
-                matrix[i][k] = inverse;
-            }
-        }
-
-        // forwarding elimination
-        for (size_t i = 0; i < size; ++i)
-            for (size_t j = 0; j < i; ++j) solution[i] -= matrix[i][j] * solution[j];
+    // the maximum number of Gauss-Seidel sweeps performed by the iterative solver before giving up
+    constexpr int MAX_SOLVER_SWEEPS = 10;
 
-        // backward substitution
-        for (int i = static_cast<int>(size) - 1; i >= 0; --i)
-        {
-            for (size_t j = i + 1; j < size; ++j) solution[i] -= matrix[i][j] * solution[j];
-            solution[i] /= matrix[i][i];
-        }
-
-        // return the solution
-        return solution;
-    }
+    // the tolerance on the relative residual of the rate equations for each level solved by the iterative solver,
+    // expressed as a fraction of the user-configured convergence criterion for the level populations in a cell
+    constexpr double SOLVER_TOLERANCE_FRACTION = 0.01;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -410,8 +376,16 @@ UpdateStatus NonLTELineGasMix::updateSpecificState(MaterialState* state, const A
     // if the cell does not contain any material for this component, leave all properties untouched
     if (state->numberDensity() > 0)
     {
-        // allocate the statistical equilibrium matrix for the level populations
-        vector<vector<double>> matrix(_numLevels, vector<double>(_numLevels + 1));
+        // obtain per-thread scratch storage for the statistical equilibrium matrix for the level populations,
+        // with N rows and N+1 columns stored contiguously in row-major order, and for the solution
+        thread_local vector<double> t_matrix;
+        thread_local vector<double> t_solution;
+        int stride = _numLevels + 1;
+        t_matrix.assign(_numLevels * stride, 0.);
+        t_solution.resize(_numLevels);
+        double* matrix = t_matrix.data();
+        double* solution = t_solution.data();
+        auto element = [matrix, stride](int i, int j) -> double& { return matrix[i * stride + j]; };
 
         // add the terms for the radiational transitions
         for (int k = 0; k != _numLines; ++k)
@@ -420,8 +394,8 @@ UpdateStatus NonLTELineGasMix::updateSpecificState(MaterialState* state, const A
             int low = _indexLowRad[k];
 
             // add the Einstein Aul coefficients (spontaneous emission)
-            matrix[up][up] -= _einsteinA[k];
-            matrix[low][up] += _einsteinA[k];
+            element(up, up) -= _einsteinA[k];
+            element(low, up) += _einsteinA[k];
 
             // calculate the mean intensity of the radiation field convolved over the normalized line profile g:
             //   J_convolved = \int J_lambda(lambda) g(lambda) d lambda  /  \int g(lambda) d lambda
@@ -468,12 +442,12 @@ UpdateStatus NonLTELineGasMix::updateSpecificState(MaterialState* state, const A
             if (storeMeanIntensities()) state->setMeanIntensity(k, J);
 
             // add the Einstein Bul coefficients (stimulated emission)
-            matrix[up][up] -= _einsteinBul[k] * J;
-            matrix[low][up] += _einsteinBul[k] * J;
+            element(up, up) -= _einsteinBul[k] * J;
+            element(low, up) += _einsteinBul[k] * J;
 
             // add the Einstein Blu coefficients (absorption)
-            matrix[low][low] -= _einsteinBlu[k] * J;
-            matrix[up][low] += _einsteinBlu[k] * J;
+            element(low, low) -= _einsteinBlu[k] * J;
+            element(up, low) += _einsteinBlu[k] * J;
         }
 
         // add the terms for the collisional transitions
@@ -497,19 +471,33 @@ UpdateStatus NonLTELineGasMix::updateSpecificState(MaterialState* state, const A
 
                 // add the coefficients after multiplication by the partner number density
                 double n = state->colPartnerDensity(c);
-                matrix[up][up] -= Kul * n;
-                matrix[low][low] -= Klu * n;
-                matrix[up][low] += Klu * n;
-                matrix[low][up] += Kul * n;
+                element(up, up) -= Kul * n;
+                element(low, low) -= Klu * n;
+                element(up, low) += Klu * n;
+                element(low, up) += Kul * n;
             }
         }
 
-        // replace the last row of the matrix by the normalization of the number density
-        for (int p = 0; p != _numLevels; ++p) matrix[_numLevels - 1][p] = 1.;
-        matrix[_numLevels - 1][_numLevels] = state->numberDensity();
+        // if requested, solve the rate equations iteratively, starting from the current level populations
+        bool solved = false;
+        if (warmStartSolver())
+        {
+            for (int p = 0; p != _numLevels; ++p) solution[p] = state->levelPopulation(p);
+            solved = RateEquationSolver::solveIterative(matrix, _numLevels, state->numberDensity(),
+                                                        SOLVER_TOLERANCE_FRACTION * maxChangeInLevelPopulations(),
+                                                        MAX_SOLVER_SWEEPS, solution);
+        }
+
+        // otherwise, or if the iteration did not converge, solve the set of equations directly
+        if (!solved)
+        {
+            // replace the last row of the matrix by the normalization of the number density
+            for (int p = 0; p != _numLevels; ++p) element(_numLevels - 1, p) = 1.;
+            element(_numLevels - 1, _numLevels) = state->numberDensity();
 
-        // solve the set of equations represented by the matrix
-        Array solution = solveMatrixEquation(matrix);
+            // solve the set of equations represented by the matrix
+            RateEquationSolver::solveDirect(matrix, _numLevels, solution);
+        }
 
         // update the level populations, keeping track of the amount of change
         double change = 0.;
@@ -624,11 +612,11 @@ double NonLTELineGasMix::opacityAbs(double lambda, const MaterialState* state, c
             }
         }
 
-        // apply lower limit to (negative) optical depth
+        // apply lower limit to (negative) optical depth, except in cells with zero volume (which are never crossed)
         if (opacity < 0.)
         {
             double diagonal = 1.7320508 * cbrt(state->volume());  // correct only for cubical cell
-            if (opacity * diagonal < lowestOpticalDepth()) opacity = lowestOpticalDepth() / diagonal;
+            if (diagonal > 0. && opacity * diagonal < lowestOpticalDepth()) opacity = lowestOpticalDepth() / diagonal;
         }
     }
     return opacity;
@@ -201,6 +201,25 @@
     gas. These coefficients are related by \f[ \frac{C_{lu}}{C_{ul}} = \frac{g_u}{g_l}
     \exp(-E_{ul}/kT_\mathrm{kin}).\f]
 
+    By default, the statistical equilibrium equations are solved for each cell in each iteration
+    through LU decomposition of the corresponding matrix, after replacing one of the equations by
+    the normalization condition \f$\sum_i n_i = n_\mathrm{mol}\f$. The computational cost of this
+    direct solution scales as \f$N^3\f$. Once the iterative process approaches convergence, the
+    level populations change only slightly between consecutive iterations. If the \em
+    warmStartSolver flag is turned on, the equations are therefore first solved with Gauss-Seidel
+    sweeps starting from the level populations obtained in the previous iteration (or from the
+    initial level populations for the first update), renormalizing the populations after each
+    sweep. The cost of a single sweep scales as \f$N^2\f$. The iteration stops as soon as the
+    relative residual of the rate equations for each level, \f$\max_i |(A\,n)_i/A_{ii}|/n_i\f$
+    where \f$A\f$ is the rate matrix, drops below one percent of the \em
+    maxChangeInLevelPopulations convergence criterion (see above). Like that criterion, the
+    residual is relative to the population of each level, so that levels with a small population
+    are solved to the same relative accuracy as the dominant levels. Using the residual rather
+    than the change during a sweep avoids accepting populations that merely change slowly. If the
+    residual criterion is not met within ten sweeps, the iterative result is discarded and the
+    equations are solved directly. The solvers are implemented in the RateEquationSolver
+    namespace.
+
     <b>Emission</b>
 
     The integrated line luminosity \f$L_{ul}\f$ corresponding to the transition from upper energy
@@ -367,6 +386,10 @@ class NonLTELineGasMix : public EmittingGasMix
         ATTRIBUTE_DEFAULT_VALUE(storeMeanIntensities, "false")
         ATTRIBUTE_DISPLAYED_IF(storeMeanIntensities, "Level3")
 
+        PROPERTY_BOOL(warmStartSolver, "solve the level populations iteratively, starting from the previous solution")
+        ATTRIBUTE_DEFAULT_VALUE(warmStartSolver, "false")
+        ATTRIBUTE_DISPLAYED_IF(warmStartSolver, "Level3")
+
         PROPERTY_STRING(initialLevelPopsFilename, "the name of the file with initial level populations")
         ATTRIBUTE_REQUIRED_IF(initialLevelPopsFilename, "false")
         ATTRIBUTE_DISPLAYED_IF(initialLevelPopsFilename, "Level3")
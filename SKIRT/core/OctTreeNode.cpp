@@ -34,6 +34,13 @@ void OctTreeNode::createChildren(int id)
 
 ////////////////////////////////////////////////////////////////////
 
+int OctTreeNode::numChildren() const
+{
+    return 8;
+}
+
+////////////////////////////////////////////////////////////////////
+
 TreeNode* OctTreeNode::child(Vec r)
 {
     Vec rc = CHILD_0->rmax();
@@ -30,6 +30,10 @@ public:
         function on a node that already has children results in undefined behavior. */
     void createChildren(int id) override;
 
+    /** This function returns the number of children created by the createChildren() function,
+        i.e. eight. */
+    int numChildren() const override;
+
     /** This function returns a pointer to the node's child that contains the specified point. More
         accurately, it returns the child corresponding to the octant that contains the specified
         point relative to the node's central division point. If the specified point is inside the
@@ -30,13 +30,14 @@ class Parallel;
     have a single ParallelFactory instance per simulation, and to use yet another ParallelFactory
     instance to run multiple simulations at the same time.
 
-    ParallelFactory clients can request a Parallel instance for one of the two task allocation
+    ParallelFactory clients can request a Parallel instance for one of the three task allocation
     modes described in the table below.
 
     Task mode | Description
     ----------|------------
     Distributed | All threads in all processes perform the tasks in parallel
     RootOnly | All threads in the root process perform the tasks in parallel; the other processes ignore the tasks
+    Local | All threads in each process perform all tasks in parallel, independently of the other processes
 
     In support of these task modes, the Parallel class has several subclasses, each implementing
     a specific parallelization scheme as described in the table below.
@@ -56,6 +57,7 @@ class Parallel;
     -------------|-------|-------|-------|-------|
     Distributed  |  S    |  MT   |  MTP  |  MTP  |
     RootOnly     |  S    |  MT   |  S/0  |  MT/0 |
+    Local        |  S    |  MT   |  S    |  MT   |
 
 */
 class ParallelFactory : public SimulationItem
@@ -93,9 +95,13 @@ public:
         performance). */
     static int defaultThreadCount();
 
+    /** Returns true if the calling thread is the thread that constructed this factory object, i.e.
+        the only thread from which the parallel() function may be invoked, and false otherwise. */
+    bool isParentThread() const { return std::this_thread::get_id() == _parentThread; }
+
     /** This enumeration includes a constant for each task allocation mode supported by ParallelFactory
      * and the Parallel subclasses. */
-    enum class TaskMode { Distributed, RootOnly };
+    enum class TaskMode { Distributed, RootOnly, Local };
 
     /** This function returns a Parallel subclass instance of the appropriate type and with an
         appropriate number of execution threads, depending on the requested task allocation mode,
@@ -114,6 +120,9 @@ public:
     /** This function calls the parallel() function for the RootOnly task allocation mode. */
     Parallel* parallelRootOnly(int maxThreadCount = 0) { return parallel(TaskMode::RootOnly, maxThreadCount); }
 
+    /** This function calls the parallel() function for the Local task allocation mode. */
+    Parallel* parallelLocal(int maxThreadCount = 0) { return parallel(TaskMode::Local, maxThreadCount); }
+
     //======================== Data Members ========================
 
 private:
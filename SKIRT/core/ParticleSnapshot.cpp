@@ -14,94 +14,51 @@
 
 ////////////////////////////////////////////////////////////////////
 
-/** Particle is a simple helper class for working with smoothed particles, usually
-    imported from a smoothed particle hydrodynamical (SPH) simulation. A Particle object
-    holds the particle's center position, smoothing length, and effective mass (after any
-    multipliers have been applied). Isolating these properties in a simple object allows efficient
-    storage and retrieval, for example when organizing smoothed particles in a search structure. */
-class ParticleSnapshot::Particle
+void ParticleSnapshot::readAndClose()
 {
-public:
-    /** The constructor arguments specify the particle attributes: particle index, coordinates of
-        the center, smoothing length, and effective mass. */
-    Particle(double x, double y, double z, double h, double M) : _x(x), _y(y), _z(z), _h(h), _M(M) {}
-
-    /** This function returns the coordinates of the center of the particle. */
-    Vec center() const { return Vec(_x, _y, _z); }
-
-    /** This function returns the smoothing length of the particle. */
-    double radius() const { return _h; }
-
-    /** This function returns the bounding box of the particle. */
-    Box bounds() const { return Box(_x - _h, _y - _h, _z - _h, _x + _h, _y + _h, _z + _h); }
-
-    /** This function returns the mass of the particle. */
-    double mass() const { return _M; }
-
-    /** This function returns the effective volume of the particle. */
-    double volume() const { return _h * _h * _h; }
-
-    /** This function returns the effective density of the particle. */
-    double density() const { return _M / (_h * _h * _h); }
-
-    /** This function returns the impact radius of the path specified by a starting position and
-        direction relative to the particle center (i.e. the minimum distance between the path and
-        the center). If the path's starting position is located beyond the impact point (the point
-        of minimum distance), the function returns infinity to indicate that the path does not
-        intersect the particle. */
-    double impact(Vec r, Vec k) const
-    {
-        // assume that k is normalized so we don't need to divide by its norm
-        double s = Vec::dot(k, center() - r);
-        if (s < 0.) return std::numeric_limits<double>::infinity();
-        return (center() - (r + s * k)).norm();
-    }
-
-private:
-    // data members received as constructor arguments
-    double _x, _y, _z;  // center coordinates
-    double _h;          // smoothing length
-    double _M;          // total mass
-};
-
-////////////////////////////////////////////////////////////////////
-
-ParticleSnapshot::ParticleSnapshot() {}
-
-////////////////////////////////////////////////////////////////////
+    // read the particle info into memory, storing the properties column by column
+    _colv = infile()->readAllColumns();
+    int numRows = _colv.empty() ? 0 : _colv[0].size();
 
-ParticleSnapshot::~ParticleSnapshot() {}
-
-////////////////////////////////////////////////////////////////////
+    // close the file
+    close();
 
-void ParticleSnapshot::readAndClose()
-{
-    // read the particle info into memory
+    // determine the indices of the particles to be retained
     // if the user configured a temperature cutoff, we skip high-temperature particles
     // if the user configured a mass-density policy, we skip zero-mass particles
     int numTempIgnored = 0;
     int numMassIgnored = 0;
     int numBiasIgnored = 0;
-    Array row;
-    while (infile()->readRow(row))
+    vector<int> retained;
+    retained.reserve(numRows);
+    for (int m = 0; m != numRows; ++m)
     {
-        if (useTemperatureCutoff() && row[temperatureIndex()] > maxTemperature())
+        if (useTemperatureCutoff() && _colv[temperatureIndex()][m] > maxTemperature())
             numTempIgnored++;
-        else if (hasMassDensityPolicy() && row[massIndex()] == 0.)
+        else if (hasMassDensityPolicy() && _colv[massIndex()][m] == 0.)
             numMassIgnored++;
-        else if (hasBias() && row[biasIndex()] == 0.)
+        else if (hasBias() && _colv[biasIndex()][m] == 0.)
             numBiasIgnored++;
         else
-            _propv.push_back(row);
+            retained.push_back(m);
     }
+    _numParticles = retained.size();
 
-    // close the file
-    close();
+    // if some particles are skipped, compact the columns so that they contain only the retained particles
+    if (_numParticles != numRows)
+    {
+        for (Array& col : _colv)
+        {
+            Array compacted(_numParticles);
+            for (int m = 0; m != _numParticles; ++m) compacted[m] = col[retained[m]];
+            col = std::move(compacted);
+        }
+    }
 
     // log the number of particles
     if (!numTempIgnored && !numMassIgnored && !numBiasIgnored)
     {
-        log()->info("  Number of particles: " + std::to_string(_propv.size()));
+        log()->info("  Number of particles: " + std::to_string(_numParticles));
     }
     else
     {
@@ -109,28 +66,23 @@ void ParticleSnapshot::readAndClose()
             log()->info("  Number of high-temperature particles ignored: " + std::to_string(numTempIgnored));
         if (numMassIgnored) log()->info("  Number of zero-mass particles ignored: " + std::to_string(numMassIgnored));
         if (numBiasIgnored) log()->info("  Number of zero-bias particles ignored: " + std::to_string(numBiasIgnored));
-        log()->info("  Number of particles retained: " + std::to_string(_propv.size()));
+        log()->info("  Number of particles retained: " + std::to_string(_numParticles));
     }
 
-    // if a mass density policy has been set, calculate masses and densities for all cells
+    // if a mass density policy has been set, calculate the effective masses for all particles
     if (hasMassDensityPolicy())
     {
-        // build a list of compact smoothed particle objects that we can organize in a search structure
         double totalOriginalMass = 0;
         double totalMetallicMass = 0;
         double totalEffectiveMass = 0;
-        int numParticles = _propv.size();
-        _pv.reserve(numParticles);
-        for (int m = 0; m != numParticles; ++m)
+        _Mv.resize(_numParticles);
+        for (int m = 0; m != _numParticles; ++m)
         {
-            const Array& prop = _propv[m];
-
-            double originalMass = prop[massIndex()];
-            double metallicMass = originalMass * (useMetallicity() ? prop[metallicityIndex()] : 1.);
+            double originalMass = property(m, massIndex());
+            double metallicMass = originalMass * (useMetallicity() ? property(m, metallicityIndex()) : 1.);
             double effectiveMass = metallicMass * multiplier();
 
-            _pv.emplace_back(prop[positionIndex() + 0], prop[positionIndex() + 1], prop[positionIndex() + 2],
-                             prop[sizeIndex()], effectiveMass);
+            _Mv[m] = effectiveMass;
 
             totalOriginalMass += originalMass;
             totalMetallicMass += metallicMass;
@@ -144,8 +96,9 @@ void ParticleSnapshot::readAndClose()
         if (totalOriginalMass < 0 || totalMetallicMass < 0 || totalEffectiveMass < 0)
         {
             log()->warning("  Total imported mass is negative; suppressing the complete mass distribution");
-            _propv.clear();
-            _pv.clear();
+            _numParticles = 0;
+            _colv.clear();
+            _Mv.resize(0);
             totalEffectiveMass = 0;
         }
 
@@ -153,29 +106,20 @@ void ParticleSnapshot::readAndClose()
         _mass = totalEffectiveMass;
 
         // construct a vector with the normalized cumulative particle densities
-        if (!_pv.empty()) NR::cdf(_cumrhov, _pv.size(), [this](int i) { return _pv[i].mass(); });
-    }
-
-    // if needed, build a list of compact particles without masses that we can organize in a search structure
-    if (!hasMassDensityPolicy() && needGetEntities())
-    {
-        int numParticles = _propv.size();
-        _pv.reserve(numParticles);
-        for (int m = 0; m != numParticles; ++m)
-        {
-            const Array& prop = _propv[m];
-            _pv.emplace_back(prop[positionIndex() + 0], prop[positionIndex() + 1], prop[positionIndex() + 2],
-                             prop[sizeIndex()], 0.);
-        }
+        if (_numParticles) NR::cdf(_cumrhov, _Mv);
     }
 
     // if needed, construct a search structure for the particles
     if (hasMassDensityPolicy() || needGetEntities())
     {
-        log()->info("Constructing search grid for " + std::to_string(_pv.size()) + " particles...");
-        auto bounds = [this](int m) { return _pv[m].bounds(); };
-        auto intersects = [this](int m, const Box& box) { return box.intersects(_pv[m].center(), _pv[m].radius()); };
-        _search.loadEntities(_pv.size(), bounds, intersects);
+        log()->info("Constructing search grid for " + std::to_string(_numParticles) + " particles...");
+        auto bounds = [this](int m) {
+            Vec rc = center(m);
+            double h = radius(m);
+            return Box(rc.x() - h, rc.y() - h, rc.z() - h, rc.x() + h, rc.y() + h, rc.z() + h);
+        };
+        auto intersects = [this](int m, const Box& box) { return box.intersects(center(m), radius(m)); };
+        _search.loadEntities(_numParticles, bounds, intersects);
 
         int nb = _search.numBlocks();
         log()->info("  Number of blocks in grid: " + std::to_string(nb * nb * nb) + " (" + std::to_string(nb) + "^3)");
@@ -198,7 +142,7 @@ void ParticleSnapshot::setSmoothingKernel(const SmoothingKernel* kernel)
 Box ParticleSnapshot::extent() const
 {
     // if there are no particles, return an empty box
-    if (_propv.empty()) return Box();
+    if (!_numParticles) return Box();
 
     // if there is a search structure, ask it to return the extent (it is already calculated)
     if (_search.numBlocks()) return _search.extent();
@@ -210,14 +154,18 @@ Box ParticleSnapshot::extent() const
     double ymax = -std::numeric_limits<double>::infinity();
     double zmin = +std::numeric_limits<double>::infinity();
     double zmax = -std::numeric_limits<double>::infinity();
-    for (const Array& prop : _propv)
+    const auto& xv = _colv[positionIndex() + 0];
+    const auto& yv = _colv[positionIndex() + 1];
+    const auto& zv = _colv[positionIndex() + 2];
+    const auto& hv = _colv[sizeIndex()];
+    for (int m = 0; m != _numParticles; ++m)
     {
-        xmin = min(xmin, prop[positionIndex() + 0] - prop[sizeIndex()]);
-        xmax = max(xmax, prop[positionIndex() + 0] + prop[sizeIndex()]);
-        ymin = min(ymin, prop[positionIndex() + 1] - prop[sizeIndex()]);
-        ymax = max(ymax, prop[positionIndex() + 1] + prop[sizeIndex()]);
-        zmin = min(zmin, prop[positionIndex() + 2] - prop[sizeIndex()]);
-        zmax = max(zmax, prop[positionIndex() + 2] + prop[sizeIndex()]);
+        xmin = min(xmin, xv[m] - hv[m]);
+        xmax = max(xmax, xv[m] + hv[m]);
+        ymin = min(ymin, yv[m] - hv[m]);
+        ymax = max(ymax, yv[m] + hv[m]);
+        zmin = min(zmin, zv[m] - hv[m]);
+        zmax = max(zmax, zv[m] + hv[m]);
     }
     return Box(xmin, ymin, zmin, xmax, ymax, zmax);
 }
@@ -226,33 +174,39 @@ Box ParticleSnapshot::extent() const
 
 int ParticleSnapshot::numEntities() const
 {
-    return _propv.size();
+    return _numParticles;
 }
 
 ////////////////////////////////////////////////////////////////////
 
 double ParticleSnapshot::volume(int m) const
 {
-    return _pv[m].volume();
+    double h = radius(m);
+    return h * h * h;
 }
 
 ////////////////////////////////////////////////////////////////////
 
 double ParticleSnapshot::density(int m) const
 {
-    return _pv[m].density();
+    // the effective masses are calculated only if a mass density policy has been set
+    if (_Mv.size() == 0) return 0.;
+
+    double h = radius(m);
+    return _Mv[m] / (h * h * h);
 }
 
 ////////////////////////////////////////////////////////////////////
 
 double ParticleSnapshot::density(Position bfr) const
 {
+    thread_local vector<int> t_mv;     // can be reused for all queries in a given execution thread
+    thread_local vector<double> t_Wv;  // can be reused for all queries in a given execution thread
+    kernelDensities(bfr, t_mv, t_Wv);
+
     double sum = 0.;
-    for (int m : _search.entitiesFor(bfr))
-    {
-        double u = (bfr - _pv[m].center()).norm() / _pv[m].radius();
-        sum += _kernel->density(u) * _pv[m].density();
-    }
+    int n = t_mv.size();
+    for (int i = 0; i != n; ++i) sum += t_Wv[i] * density(t_mv[i]);
     return sum > 0. ? sum : 0.;  // guard against negative densities
 }
 
@@ -267,22 +221,18 @@ double ParticleSnapshot::mass() const
 
 Position ParticleSnapshot::position(int m) const
 {
-    return Position(_propv[m][positionIndex() + 0], _propv[m][positionIndex() + 1], _propv[m][positionIndex() + 2]);
+    return Position(center(m));
 }
 
 ////////////////////////////////////////////////////////////////////
 
 Position ParticleSnapshot::generatePosition(int m) const
 {
-    // get center position and size for this particle
-    Position rc(_propv[m][positionIndex() + 0], _propv[m][positionIndex() + 1], _propv[m][positionIndex() + 2]);
-    double h = _propv[m][sizeIndex()];
-
     // sample random position inside the smoothed unit volume
     double u = _kernel->generateRadius();
     Direction k = random()->direction();
 
-    return Position(rc + k * u * h);
+    return Position(center(m) + k * u * radius(m));
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -290,7 +240,7 @@ Position ParticleSnapshot::generatePosition(int m) const
 Position ParticleSnapshot::generatePosition() const
 {
     // if there are no particles, return the origin
-    if (_propv.empty()) return Position();
+    if (!_numParticles) return Position();
 
     // select a particle according to its mass contribution
     int m = NR::locateClip(_cumrhov, random()->uniform());
@@ -300,21 +250,22 @@ Position ParticleSnapshot::generatePosition() const
 
 ////////////////////////////////////////////////////////////////////
 
-const Array& ParticleSnapshot::properties(int m) const
+double ParticleSnapshot::property(int m, int p) const
 {
-    return _propv[m];
+    return _colv[p][m];
 }
 
 ////////////////////////////////////////////////////////////////////
 
 void ParticleSnapshot::getEntities(EntityCollection& entities, Position bfr) const
 {
+    thread_local vector<int> t_mv;     // can be reused for all queries in a given execution thread
+    thread_local vector<double> t_Wv;  // can be reused for all queries in a given execution thread
+    kernelDensities(bfr, t_mv, t_Wv);
+
     entities.clear();
-    for (int m : _search.entitiesFor(bfr))
-    {
-        double u = (bfr - _pv[m].center()).norm() / _pv[m].radius();
-        entities.add(m, _kernel->density(u));
-    };
+    int n = t_mv.size();
+    for (int i = 0; i != n; ++i) entities.add(t_mv[i], t_Wv[i]);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -324,10 +275,45 @@ void ParticleSnapshot::getEntities(EntityCollection& entities, Position bfr, Dir
     entities.clear();
     for (int m : _search.entitiesFor(bfr, bfk))
     {
-        double h = _pv[m].radius();
-        double q = _pv[m].impact(bfr, bfk) / h;
+        // determine the normalized impact radius of the path relative to the particle center (assuming that k is
+        // normalized); if the starting position is located beyond the impact point, the path misses the particle
+        Vec rc = center(m);
+        double h = radius(m);
+        double s = Vec::dot(bfk, rc - bfr);
+        double q = s < 0. ? std::numeric_limits<double>::infinity() : (rc - (bfr + s * bfk)).norm() / h;
         entities.add(m, _kernel->columnDensity(q) * h);
     };
 }
 
 ////////////////////////////////////////////////////////////////////
+
+Vec ParticleSnapshot::center(int m) const
+{
+    return Vec(_colv[positionIndex() + 0][m], _colv[positionIndex() + 1][m], _colv[positionIndex() + 2][m]);
+}
+
+////////////////////////////////////////////////////////////////////
+
+double ParticleSnapshot::radius(int m) const
+{
+    return _colv[sizeIndex()][m];
+}
+
+////////////////////////////////////////////////////////////////////
+
+void ParticleSnapshot::kernelDensities(Position bfr, vector<int>& mv, vector<double>& Wv) const
+{
+    // gather the particle indices and the corresponding normalized radii
+    mv.clear();
+    Wv.clear();
+    for (int m : _search.entitiesFor(bfr))
+    {
+        mv.push_back(m);
+        Wv.push_back((bfr - center(m)).norm() / radius(m));
+    }
+
+    // replace the normalized radii by the kernel densities in a single batched call
+    _kernel->densities(Wv.data(), Wv.data(), Wv.size());
+}
+
+////////////////////////////////////////////////////////////////////
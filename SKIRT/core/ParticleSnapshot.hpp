@@ -19,23 +19,17 @@ class SmoothingKernel;
     snapshot type, such as, for example, the ability to use an arbitrary smoothing kernel for the
     particles in the snapshot.
 
+    The imported particle properties are stored column by column, i.e. in a single contiguous
+    array for each imported column, rather than as a separate array for each particle. This
+    avoids a heap allocation per particle and allows the compiler to vectorize loops over the
+    particles.
+
     If the snapshot configuration requires the ability to determine the density at a given spatial
     position, an effort is made to accelerate the density interpolation over a potentially
-    large number of smoothed particles. */
+    large number of smoothed particles. Moreover, the smoothing kernel is evaluated for all
+    particles overlapping a given position in a single batched call. */
 class ParticleSnapshot : public Snapshot
 {
-    //================= Construction - Destruction =================
-
-public:
-    /** The default constructor initializes the snapshot in an invalid state0. It is provided and
-        implemented in the .cpp file so that we don't need to expose the declaration of the private
-        Particle class. */
-    ParticleSnapshot();
-
-    /** The destructor is provided and implemented in the .cpp file so that we don't need to expose
-        the declaration of the private Particle class. */
-    ~ParticleSnapshot();
-
     //========== Reading ==========
 
 public:
@@ -73,8 +67,8 @@ public:
     double volume(int m) const override;
 
     /** This function returns the effective mass density associated with the particle with index
-        \em m. If no density policy has been set or no mass information is being imported, or if
-        the index is out of range, the behavior is undefined. */
+        \em m. If no density policy has been set, the function returns zero. If the index is out of
+        range, the behavior is undefined. */
     double density(int m) const override;
 
     /** This function returns the mass density represented by the snapshot at a given point
@@ -105,10 +99,10 @@ public:
     Position generatePosition() const override;
 
 protected:
-    /** This function returns a reference to an array containing the imported properties (in column
-        order) for the particle with index \f$0\le m \le N_\mathrm{ent}-1\f$. If the index is out
-        of range, the behavior is undefined. */
-    const Array& properties(int m) const override;
+    /** This function returns the value of the imported property with column index \em p for the
+        particle with index \f$0\le m \le N_\mathrm{ent}-1\f$. If either index is out of range,
+        the behavior is undefined. */
+    double property(int m, int p) const override;
 
 public:
     /** This function replaces the contents of the specified entity collection by the set of
@@ -127,6 +121,22 @@ public:
         structures were not created, invoking this function causes undefined behavior. */
     void getEntities(EntityCollection& entities, Position bfr, Direction bfk) const override;
 
+    //======================== Private Functions ========================
+
+private:
+    /** This function returns the center position of the particle with index \em m. */
+    Vec center(int m) const;
+
+    /** This function returns the smoothing length of the particle with index \em m. */
+    double radius(int m) const;
+
+    /** This function replaces the contents of the vector \em mv by the indices of the particles
+        that may overlap the given point \f$\bf{r}\f$, and the contents of the vector \em Wv by
+        the corresponding smoothing kernel densities \f$W(u)\f$ with \f$u=|{\bf{r}}-{\bf{r}}_m|
+        /h_m\f$. The kernel is evaluated for all particles in a single batched call so that the
+        calculation can be vectorized. */
+    void kernelDensities(Position bfr, vector<int>& mv, vector<double>& Wv) const;
+
     //======================== Data Members ========================
 
 private:
@@ -134,14 +144,14 @@ private:
     const SmoothingKernel* _kernel{nullptr};
 
     // data members initialized when reading the input file
-    vector<Array> _propv;  // particle properties as imported
+    int _numParticles{0};  // number of retained particles
+    vector<Array> _colv;   // particle properties as imported, one array per column
 
     // data members initialized when reading the input file, but only if a density policy has been set
-    class Particle;
-    vector<Particle> _pv;  // compact particle objects in the same order
-    Array _cumrhov;        // cumulative density distribution for particles
-    double _mass{0.};      // total effective mass
-    BoxSearch _search;     // search structure for locating particles
+    Array _Mv;          // effective mass for each particle
+    Array _cumrhov;     // cumulative density distribution for particles
+    double _mass{0.};   // total effective mass
+    BoxSearch _search;  // search structure for locating particles
 };
 
 ////////////////////////////////////////////////////////////////////
@@ -5,6 +5,7 @@
 
 #include "PerCellForm.hpp"
 #include "ProbeFormBridge.hpp"
+#include "ProbeSystem.hpp"
 #include "SpatialGrid.hpp"
 #include "StringUtils.hpp"
 #include "TextOutFile.hpp"
@@ -13,8 +14,9 @@
 
 void PerCellForm::writeQuantity(const ProbeFormBridge* bridge) const
 {
-    // create a text column file and add the column definitions
-    TextOutFile outfile(bridge->probe(), bridge->prefix(), bridge->description() + " per spatial cell");
+    // create a text or stored column file and add the column definitions
+    bool binary = bridge->probe()->find<ProbeSystem>()->writeStoredColumns();
+    TextOutFile outfile(bridge->probe(), bridge->prefix(), bridge->description() + " per spatial cell", binary);
     outfile.writeLine("# " + StringUtils::toUpperFirst(bridge->description()) + " per spatial cell");
     outfile.addColumn("spatial cell index", "", 'd');
     bridge->addColumnDefinitions(outfile);
@@ -16,7 +16,8 @@
     This particular form outputs a text column file listing the quantity being probed for each cell
     in the spatial grid of the simulation. Specifically, the output file contains a line for each
     cell in the spatial grid of the simulation. The first column always specifies the cell index,
-    and subsequent column(s) list the quantity being probed. */
+    and subsequent column(s) list the quantity being probed. If the \em writeStoredColumns flag of
+    the probe system is enabled, the same columns are written in binary stored columns format. */
 class PerCellForm : public SpatialGridForm
 {
     ITEM_CONCRETE(PerCellForm, SpatialGridForm, "a text column file with values for each spatial cell")
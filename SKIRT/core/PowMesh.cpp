@@ -8,6 +8,22 @@
 
 ////////////////////////////////////////////////////////////////////
 
+void PowMesh::setupSelfBefore()
+{
+    Mesh::setupSelfBefore();
+
+    // use the same criterion as NR::buildPowerLawGrid() for deciding on a linear mesh
+    int n = numBins();
+    if (n > 1 && fabs(_ratio - 1.) >= 1e-3)
+    {
+        double q = pow(_ratio, 1. / (n - 1));
+        _qN = pow(q, n);
+        _logq = log(q);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
 Array PowMesh::mesh() const
 {
     Array tv;
@@ -19,3 +35,11 @@ Array PowMesh::mesh() const
 }
 
 //////////////////////////////////////////////////////////////////////
+
+double PowMesh::inverseMesh(double t) const
+{
+    if (!_qN) return numBins() * t;
+    return log(1. - t * (1. - _qN)) / _logq;
+}
+
+//////////////////////////////////////////////////////////////////////
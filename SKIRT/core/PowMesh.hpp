@@ -28,11 +28,30 @@ class PowMesh : public Mesh
 
     ITEM_END()
 
+    //============= Construction - Setup - Destruction =============
+
+protected:
+    /** This function precalculates some constants used by the inverseMesh() function. */
+    void setupSelfBefore() override;
+
     //======================== Other Functions =======================
 
 public:
     /** This function returns an array containing the mesh points. */
     Array mesh() const override;
+
+    /** This function returns the (generally non-integer) mesh point index \f$s\f$ corresponding to
+        the normalized coordinate \f$0\le t\le 1\f$, obtained by inverting the power-law
+        formula for the mesh points, i.e. \f$s = \ln[1-t\,(1-q^N)] / \ln q\f$ with \f$q\f$ the
+        ratio between consecutive bin widths. */
+    double inverseMesh(double t) const override;
+
+    //======================== Data Members ========================
+
+private:
+    // data members initialized during setup
+    double _qN{0.};    // the bin width ratio q to the power N; zero for a linear mesh
+    double _logq{0.};  // the natural logarithm of the bin width ratio q
 };
 
 //////////////////////////////////////////////////////////////////////
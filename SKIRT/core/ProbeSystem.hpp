@@ -56,11 +56,19 @@
     probePrimary()   | each iteration over primary emission
     probeSecondary() | each iteration over secondary emission (which may include primary emission)
 
+    If the \em writeStoredColumns flag is enabled, probes that output a row for each spatial cell
+    write their files in the binary SKIRT stored columns format rather than as text (see the
+    TextOutFile class). This substantially reduces the time and disk space needed for outputting
+    the information for large spatial grids.
     */
 class ProbeSystem : public SimulationItem
 {
     ITEM_CONCRETE(ProbeSystem, SimulationItem, "a probe system")
 
+        PROPERTY_BOOL(writeStoredColumns, "write per-cell probe output in binary stored columns format")
+        ATTRIBUTE_DEFAULT_VALUE(writeStoredColumns, "false")
+        ATTRIBUTE_DISPLAYED_IF(writeStoredColumns, "Level3")
+
         PROPERTY_ITEM_LIST(probes, Probe, "the probes")
         ATTRIBUTE_DEFAULT_VALUE(probes, "!NoMedium:ConvergenceInfoProbe;LuminosityProbe")
         ATTRIBUTE_REQUIRED_IF(probes, "false")
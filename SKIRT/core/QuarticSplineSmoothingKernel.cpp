@@ -65,6 +65,26 @@ double QuarticSplineSmoothingKernel::density(double u) const
 
 //////////////////////////////////////////////////////////////////////
 
+void QuarticSplineSmoothingKernel::densities(const double* uv, double* Wv, int n) const
+{
+    for (int i = 0; i != n; ++i)
+    {
+        double u = uv[i];
+        double u2 = u * u;
+        double u3 = u2 * u;
+        double u4 = u2 * u2;
+        double inner = 58.284280917442139563 * u4 - 23.313712366976855825 * u2 + 3.5747692296031178931;
+        double middle = -38.856187278294759708 * u4 + 77.712374556589519415 * u3 - 46.627424733953711649 * u2
+                        + 3.1084949822635807767 * u + 3.4193444804899388544;
+        double outer = 9.7140468195736899271 * u4 - 38.856187278294759708 * u3 + 58.284280917442139563 * u2
+                       - 38.856187278294759708 * u + 9.7140468195736899271;
+        double W = u < 0.2 ? inner : (u < 0.6 ? middle : outer);
+        Wv[i] = (u < 0. || u >= 1.) ? 0. : W;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+
 double QuarticSplineSmoothingKernel::columnDensity(double q) const
 {
     if (q < 0. || q >= 1.) return 0.;
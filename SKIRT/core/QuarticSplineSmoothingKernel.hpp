@@ -40,6 +40,13 @@ public:
         floating point coefficients that were precomputed at high precision. */
     double density(double u) const override;
 
+    /** This function calculates the density \f$W(u_i)\f$ of the smoothing kernel for each of the
+        \em n normalized radii \f$u_i\f$ in the array \em uv, and stores the results in the
+        corresponding elements of the array \em Wv. Because the quartic spline consists of three
+        polynomial pieces of low degree, it is cheaper to evaluate all three pieces for each radius
+        and select the appropriate result than to branch on the radius range. */
+    void densities(const double* uv, double* Wv, int n) const override;
+
     /** This function returns the column density \f$\Sigma(q) = 2 \int_{q}^1 \frac{W(u)\,u
         \,{\text{d}}u} {\sqrt{u^2-q^2}}\f$ of the smoothing kernel as a function of the normalized
         impact radius \f$q=r_\text{i}/h\f$. For the quartic spline smoothing kernel, this integral
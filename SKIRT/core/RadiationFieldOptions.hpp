@@ -15,7 +15,14 @@
     related to the radiation field. A simulation always stores the radiation field when it has a
     secondary emission phase or when it has a dynamic medium state (or both). If neither is the
     case, and forced scattering is enabled (see PhotonPacketOptions), the user can still request to
-    store the radiation field so that it can be probed for output. */
+    store the radiation field so that it can be probed for output.
+
+    For simulations with a large number of spatial cells and/or wavelength bins, the memory
+    required for storing the radiation field can be substantial. The user can request to store the
+    radiation field in single precision, halving these memory requirements. Each thread then stages
+    its contributions in a small double precision buffer, and the staged sums are added to the
+    stored values with stochastic rounding, so that small contributions are not lost and the
+    results remain unbiased (see the AccumulationTable class). */
 class RadiationFieldOptions : public SimulationItem
 {
     ITEM_CONCRETE(RadiationFieldOptions, SimulationItem, "a set of options related to the radiation field")
@@ -31,6 +38,12 @@ class RadiationFieldOptions : public SimulationItem
         ATTRIBUTE_DEFAULT_VALUE(radiationFieldWLG, "LogWavelengthGrid")
         ATTRIBUTE_RELEVANT_IF(radiationFieldWLG, "RadiationField&Panchromatic")
 
+        PROPERTY_BOOL(storeRadiationFieldInSinglePrecision,
+                      "store the radiation field in single precision to reduce memory usage")
+        ATTRIBUTE_DEFAULT_VALUE(storeRadiationFieldInSinglePrecision, "false")
+        ATTRIBUTE_RELEVANT_IF(storeRadiationFieldInSinglePrecision, "RadiationField")
+        ATTRIBUTE_DISPLAYED_IF(storeRadiationFieldInSinglePrecision, "Level3")
+
     ITEM_END()
 };
 
@@ -196,6 +196,15 @@ double Random::cdfLinLin(const Array& xv, const Array& Pv)
 
 //////////////////////////////////////////////////////////////////////
 
+double Random::cdfLinLin(const Array& xv, const Array& Pv, const vector<int>& gv)
+{
+    double X = uniform();
+    int i = NR::locateGuided(Pv, gv, X);
+    return NR::interpolateLinLin(X, Pv[i], Pv[i + 1], xv[i], xv[i + 1]);
+}
+
+//////////////////////////////////////////////////////////////////////
+
 double Random::cdfLogLog(const Array& xv, const Array& pv, const Array& Pv)
 {
     double X = uniform();
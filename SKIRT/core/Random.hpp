@@ -145,6 +145,14 @@ public:
         behavior of the cdf (and equivalently, of the underlying pdf). */
     double cdfLinLin(const Array& xv, const Array& Pv);
 
+    /** This function generates a random number drawn from an arbitrary probability distribution,
+        exactly like the cdfLinLin() function described above, using the same number of uniform
+        deviates and producing the same result. However, the bin containing the uniform deviate
+        is located in constant time (on average) using the specified guide table, which must
+        have been constructed from the cumulative distribution \f$P_i\f$ using the NR::guide()
+        function. */
+    double cdfLinLin(const Array& xv, const Array& Pv, const vector<int>& gv);
+
     /** This function generates a random number drawn from an arbitrary probability distribution
         \f$p(x)\,{\text{d}}x\f$ with corresponding cumulative distribution function \f$P(x)\f$. The
         function accepts discretized versions \f$p_i\f$ and \f$P_i\f$ of the pdf and cdf sampled at
@@ -0,0 +1,107 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "RateEquationSolver.hpp"
+
+////////////////////////////////////////////////////////////////////
+
+void RateEquationSolver::solveDirect(double* matrix, int size, double* solution)
+{
+    int stride = size + 1;
+    auto row = [matrix, stride](int i) { return matrix + i * stride; };
+
+    // forwarding elimination
+    for (int i = 0; i < size; i++) solution[i] = row(i)[size];
+
+    // decomposition
+    for (int k = 0; k < size - 1; ++k)
+    {
+        double* rowk = row(k);
+        if (rowk[k] == 0.0)
+        {
+            std::swap_ranges(rowk, rowk + stride, row(k + 1));
+            std::swap(solution[k], solution[k + 1]);
+        }
+        for (int i = k + 1; i < size; ++i)
+        {
+            double* rowi = row(i);
+            double inverse = rowi[k] / rowk[k];
+            for (int j = k + 1; j < size; ++j) rowi[j] -= inverse * rowk[j];
+            rowi[k] = inverse;
+        }
+    }
+
+    // forwarding elimination
+    for (int i = 0; i < size; ++i)
+    {
+        const double* rowi = row(i);
+        for (int j = 0; j < i; ++j) solution[i] -= rowi[j] * solution[j];
+    }
+
+    // backward substitution
+    for (int i = size - 1; i >= 0; --i)
+    {
+        const double* rowi = row(i);
+        for (int j = i + 1; j < size; ++j) solution[i] -= rowi[j] * solution[j];
+        solution[i] /= rowi[i];
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+double RateEquationSolver::maxRelativeResidual(const double* matrix, int size, const double* populations)
+{
+    int stride = size + 1;
+    double maxResidual = 0.;
+    for (int i = 0; i != size; ++i)
+    {
+        if (!(populations[i] > 0.)) return std::numeric_limits<double>::infinity();
+        const double* rowi = matrix + i * stride;
+        double r = 0.;
+        for (int j = 0; j != size; ++j) r += rowi[j] * populations[j];
+        maxResidual = max(maxResidual, abs(r / rowi[i]) / populations[i]);
+    }
+    return maxResidual;
+}
+
+////////////////////////////////////////////////////////////////////
+
+bool RateEquationSolver::solveIterative(const double* matrix, int size, double total, double tolerance,
+                                        int maxSweeps, double* populations)
+{
+    int stride = size + 1;
+
+    // the iteration requires a strictly positive starting point and negative diagonal elements
+    for (int p = 0; p != size; ++p)
+        if (!(populations[p] > 0.) || !(matrix[p * stride + p] < 0.)) return false;
+
+    for (int sweep = 0; sweep != maxSweeps; ++sweep)
+    {
+        // update each population in turn from the current values of the other populations
+        double sum = 0.;
+        for (int i = 0; i != size; ++i)
+        {
+            const double* rowi = matrix + i * stride;
+            double gain = 0.;
+            for (int j = 0; j != size; ++j) gain += rowi[j] * populations[j];
+            populations[i] = (gain - rowi[i] * populations[i]) / -rowi[i];
+            sum += populations[i];
+        }
+
+        // renormalize
+        double factor = total / sum;
+        for (int p = 0; p != size; ++p)
+        {
+            populations[p] *= factor;
+            if (!(populations[p] > 0.)) return false;
+        }
+
+        // test the residual of the rate equations for the renormalized populations
+        if (maxRelativeResidual(matrix, size, populations) <= tolerance) return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////
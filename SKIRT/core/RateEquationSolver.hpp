@@ -0,0 +1,63 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#ifndef RATEEQUATIONSOLVER_HPP
+#define RATEEQUATIONSOLVER_HPP
+
+#include "Basics.hpp"
+
+////////////////////////////////////////////////////////////////////
+
+/** This namespace offers functions for solving the statistical equilibrium equations that determine
+    the level populations of an atom or molecule, as used by the NonLTELineGasMix class.
+
+    The equations are represented by a matrix with \f$N\f$ rows and \f$N+1\f$ columns, stored
+    contiguously in row-major order, where \f$N\f$ is the number of energy levels. The first
+    \f$N\f$ columns hold the rate matrix \f$A\f$, where the element \f$A_{ij}\f$ with \f$i\ne j\f$
+    is the rate of transitions from level \f$j\f$ to level \f$i\f$ and the diagonal element
+    \f$A_{ii}\f$ is minus the total rate of transitions out of level \f$i\f$. The last column holds
+    the right-hand side of the equations. In statistical equilibrium, the populations \f$n\f$
+    satisfy the homogeneous set of equations \f$A\,n=0\f$, which determines the populations up to
+    a normalization factor. This factor is fixed by requiring that the populations sum to the total
+    number density of the species.
+
+    The solveDirect() function solves the equations through LU decomposition at a cost that scales
+    as \f$N^3\f$. The solveIterative() function instead performs Gauss-Seidel sweeps starting from
+    a given estimate of the populations, at a cost per sweep that scales as \f$N^2\f$. It is
+    intended for use when a good estimate is available, e.g. the populations obtained in a previous
+    iteration of the simulation. */
+namespace RateEquationSolver
+{
+    /** This function solves the square set of linear equations represented by the given matrix
+        using LU decomposition. The caller should replace one of the homogeneous equations by the
+        normalization condition before calling this function. The contents of the matrix is
+        overwritten and the solution is stored in the given array, which must have room for \f$N\f$
+        values. */
+    void solveDirect(double* matrix, int size, double* solution);
+
+    /** This function returns the largest relative residual of the homogeneous rate equations
+        represented by the first \f$N\f$ columns of the given matrix for the given populations,
+        \f[ \max_i \frac{|r_i|}{n_i} \quad\mathrm{with}\quad r_i = \frac{1}{A_{ii}} \sum_j A_{ij}
+        n_j. \f] The scaled residual \f$r_i\f$ equals the change in the population of level
+        \f$i\f$ that would restore the balance between the transitions into and out of that level,
+        so that this quantity measures the relative accuracy of the population of each level
+        separately. The function returns infinity if any of the populations is not positive. */
+    double maxRelativeResidual(const double* matrix, int size, const double* populations);
+
+    /** This function iteratively solves the homogeneous set of rate equations represented by the
+        first \f$N\f$ columns of the given matrix using Gauss-Seidel sweeps, starting from the given
+        populations and renormalizing them to the given total after each sweep. The function
+        returns true as soon as the value returned by the maxRelativeResidual() function drops
+        below the given tolerance. It returns false if this does not happen within the given
+        maximum number of sweeps, or if the iteration cannot proceed because a population or a
+        diagonal element has an improper value. In that case the populations are unusable and the
+        caller should solve the equations directly. */
+    bool solveIterative(const double* matrix, int size, double total, double tolerance, int maxSweeps,
+                        double* populations);
+}
+
+////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,17 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "SEDFamily.hpp"
+
+////////////////////////////////////////////////////////////////////
+
+void SEDFamily::specificLuminosities(Array& Lv, const Array& lambdav, const Array& parameters) const
+{
+    size_t n = lambdav.size();
+    Lv.resize(n);
+    for (size_t i = 0; i != n; ++i) Lv[i] = specificLuminosity(lambdav[i], parameters);
+}
+
+////////////////////////////////////////////////////////////////////
@@ -39,6 +39,15 @@ public:
         if not the behavior is undefined. */
     virtual double specificLuminosity(double wavelength, const Array& parameters) const = 0;
 
+    /** This function stores in \em Lv the specific luminosity \f$L_\lambda\f$ for the %SED with
+        the specified parameters at each of the wavelengths in \em lambdav. The resulting values
+        are identical to those returned by the specificLuminosity() function for each of the
+        wavelengths. The implementation in this base class simply calls that function for each
+        wavelength. Subclasses backed by a stored table override this function to use the batch
+        interpolation offered by the table, which is substantially faster for many wavelengths,
+        especially if they are sorted in increasing order. */
+    virtual void specificLuminosities(Array& Lv, const Array& lambdav, const Array& parameters) const;
+
     /** This function constructs both the normalized probability density function (pdf) and the
         corresponding normalized cumulative distribution function (cdf) for the %SED with the
         specified parameters over the specified wavelength range. If the wavelength range or any of
@@ -48,6 +48,18 @@ double ScaledGaussianSmoothingKernel::density(double u) const
 
 //////////////////////////////////////////////////////////////////////
 
+void ScaledGaussianSmoothingKernel::densities(const double* uv, double* Wv, int n) const
+{
+    for (int i = 0; i != n; ++i)
+    {
+        double u = uv[i];
+        double W = N * exp(A * u * u);
+        Wv[i] = (u < 0. || u > 1.) ? 0. : W;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+
 double ScaledGaussianSmoothingKernel::columnDensity(double q) const
 {
     if (q < 0. || q > 1.) return 0.;
@@ -54,6 +54,13 @@ public:
         header. */
     double density(double u) const override;
 
+    /** This function calculates the density \f$W(u_i)\f$ of the smoothing kernel for each of the
+        \em n normalized radii \f$u_i\f$ in the array \em uv, and stores the results in the
+        corresponding elements of the array \em Wv. The exponential is evaluated for every radius
+        and the result is set to zero for radii outside of the kernel's support. The cost of the
+        loop is dominated by the exponential function. */
+    void densities(const double* uv, double* Wv, int n) const override;
+
     /** This function returns the column density \f$\Sigma(q) = 2 \int_{q}^1 \frac{W(u)\,u
         \,{\text{d}}u} {\sqrt{u^2-q^2}}\f$ of the smoothing kernel as a function of the normalized
         impact radius \f$q=r_\text{i}/h\f$. For the scaled Gaussian smoothing kernel, we obtain
@@ -85,8 +85,10 @@ void SecondaryDustLuminosityProbe::probe()
             }
         }
 
-        // determine the total dust luminosity volume density in the cell, adjusted with the normalization factor
-        double front = norm > 0. ? ms->dustLuminosity(m) / ms->grid()->volume(m) / norm : 0.;
+        // determine the total dust luminosity volume density in the cell, adjusted with the normalization factor;
+        // a cell may have zero volume, e.g. an outer cell of a composite grid that is fully covered by inner grids
+        double volume = ms->grid()->volume(m);
+        double front = norm > 0. && volume > 0. ? ms->dustLuminosity(m) / volume / norm : 0.;
 
         // copy and renormalize the values in output order and units, omitting the outer borders
         int numBins = ewlg.size() - 2;
@@ -64,8 +64,14 @@ void SecondaryLineLuminosityProbe::probe()
                 };
 
                 // define the call-back function to retrieve a compound luminosity value in output ordering
+                // a cell may have zero volume, e.g. an outer cell of a composite grid fully covered by inner grids
                 auto valueInCell = [ms, h, units](int m) {
-                    Array Lv = ms->lineEmissionSpectrum(m, h) / ms->grid()->volume(m);
+                    Array Lv = ms->lineEmissionSpectrum(m, h);
+                    double volume = ms->grid()->volume(m);
+                    if (volume > 0.)
+                        Lv /= volume;
+                    else
+                        Lv = 0.;
                     if (units->rwavelength()) std::reverse(begin(Lv), end(Lv));
                     return Lv;
                 };
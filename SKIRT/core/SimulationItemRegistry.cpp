@@ -39,6 +39,7 @@
 #include "ClearDensityRecipe.hpp"
 #include "ClumpyGeometryDecorator.hpp"
 #include "CombineGeometryDecorator.hpp"
+#include "CompositeSpatialGrid.hpp"
 #include "CompositeWavelengthGrid.hpp"
 #include "ConfigurableBandWavelengthGrid.hpp"
 #include "ConfigurableDustMix.hpp"
@@ -241,6 +242,7 @@
 #include "SpatialGridPlotProbe.hpp"
 #include "SpatialGridSourceDensityProbe.hpp"
 #include "SpecificLuminosityNormalization.hpp"
+#include "SpectralClusterCellLibrary.hpp"
 #include "SphePowerLawRedistributeGeometryDecorator.hpp"
 #include "Sphere1DSpatialGrid.hpp"
 #include "Sphere2DSpatialGrid.hpp"
@@ -520,6 +522,7 @@ SimulationItemRegistry::SimulationItemRegistry(string version, string format)
     ItemRegistry::add<AdaptiveMeshSpatialGrid>();
     ItemRegistry::add<VoronoiMeshSpatialGrid>();
     ItemRegistry::add<TetraMeshSpatialGrid>();
+    ItemRegistry::add<CompositeSpatialGrid>();
 
     // spatial grid policies
     ItemRegistry::add<TreePolicy>();
@@ -654,6 +657,7 @@ SimulationItemRegistry::SimulationItemRegistry(string version, string format)
     ItemRegistry::add<AllCellsLibrary>();
     ItemRegistry::add<FieldStrengthCellLibrary>();
     ItemRegistry::add<TemperatureWavelengthCellLibrary>();
+    ItemRegistry::add<SpectralClusterCellLibrary>();
 
     // dynamic medium state recipes
     ItemRegistry::add<DynamicStateRecipe>();
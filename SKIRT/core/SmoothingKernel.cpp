@@ -16,3 +16,10 @@ void SmoothingKernel::setupSelfBefore()
 }
 
 //////////////////////////////////////////////////////////////////////
+
+void SmoothingKernel::densities(const double* uv, double* Wv, int n) const
+{
+    for (int i = 0; i != n; ++i) Wv[i] = density(uv[i]);
+}
+
+//////////////////////////////////////////////////////////////////////
@@ -35,6 +35,15 @@ public:
         normalized radius \f$u\f$. Subclasses must implement this function appropriately. */
     virtual double density(double u) const = 0;
 
+    /** This function calculates the density \f$W(u_i)\f$ of the smoothing kernel for each of the
+        \em n normalized radii \f$u_i\f$ in the array \em uv, and stores the results in the
+        corresponding elements of the array \em Wv. The two arrays may coincide, in which case the
+        radii are replaced by the densities. The default implementation simply calls the
+        density() function for each radius. Subclasses should override this function with a loop
+        that avoids virtual function calls and branches, so that the compiler can vectorize the
+        calculation. */
+    virtual void densities(const double* uv, double* Wv, int n) const;
+
     /** This function returns the projection of the smoothing kernel along a line with given impact
         radius (smallest distance) to the kernel's center. In formula form, this is the column
         density \f$\Sigma(q) = 2 \int_{q}^1 \frac{W(u)\,u \,{\text{d}}u} {\sqrt{u^2-q^2}}\f$ of the
@@ -341,12 +341,10 @@ void Snapshot::calculateDensityAndMass(Array& rhov, Array& cumrhov, double& mass
     int numIgnored = 0;
     for (int m = 0; m != numCells; ++m)
     {
-        const Array& prop = properties(m);
-
         // original mass is zero if temperature is above cutoff or if imported mass/density is not positive
         double originalDensity = 0.;
         double originalMass = 0.;
-        if (maxT && prop[temperatureIndex()] > maxT)
+        if (maxT && property(m, temperatureIndex()) > maxT)
         {
             numIgnored++;
         }
@@ -354,13 +352,15 @@ void Snapshot::calculateDensityAndMass(Array& rhov, Array& cumrhov, double& mass
         {
             // use density or mass or both, depending on availability
             double V = volume(m);
-            originalDensity = max(0., densityIndex() >= 0 ? prop[densityIndex()] : prop[massIndex()] / V);
-            originalMass = max(0., massIndex() >= 0 ? prop[massIndex()] : prop[densityIndex()] * V);
+            originalDensity =
+                max(0., densityIndex() >= 0 ? property(m, densityIndex()) : property(m, massIndex()) / V);
+            originalMass = max(0., massIndex() >= 0 ? property(m, massIndex()) : property(m, densityIndex()) * V);
         }
 
         // determine effective mass
-        double effectiveDensity = originalDensity * (useMetallicity() ? prop[metallicityIndex()] : 1.) * multiplier();
-        double metallicMass = originalMass * (useMetallicity() ? prop[metallicityIndex()] : 1.);
+        double effectiveDensity =
+            originalDensity * (useMetallicity() ? property(m, metallicityIndex()) : 1.) * multiplier();
+        double metallicMass = originalMass * (useMetallicity() ? property(m, metallicityIndex()) : 1.);
         double effectiveMass = metallicMass * multiplier();
 
         // store density and mass for this cell
@@ -394,21 +394,21 @@ double Snapshot::volume() const
 
 double Snapshot::initialMass(int m) const
 {
-    return properties(m)[initialMassIndex()];
+    return property(m, initialMassIndex());
 }
 
 ////////////////////////////////////////////////////////////////////
 
 double Snapshot::currentMass(int m) const
 {
-    return properties(m)[currentMassIndex()];
+    return property(m, currentMassIndex());
 }
 
 ////////////////////////////////////////////////////////////////////
 
 double Snapshot::metallicity(int m) const
 {
-    return properties(m)[metallicityIndex()];
+    return property(m, metallicityIndex());
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -424,14 +424,14 @@ double Snapshot::metallicity(Position bfr) const
 
 double Snapshot::age(int m) const
 {
-    return properties(m)[ageIndex()];
+    return property(m, ageIndex());
 }
 
 ////////////////////////////////////////////////////////////////////
 
 double Snapshot::temperature(int m) const
 {
-    return properties(m)[temperatureIndex()];
+    return property(m, temperatureIndex());
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -447,8 +447,7 @@ double Snapshot::temperature(Position bfr) const
 
 Vec Snapshot::velocity(int m) const
 {
-    const auto& propv = properties(m);
-    return Vec(propv[velocityIndex() + 0], propv[velocityIndex() + 1], propv[velocityIndex() + 2]);
+    return Vec(property(m, velocityIndex() + 0), property(m, velocityIndex() + 1), property(m, velocityIndex() + 2));
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -464,15 +463,15 @@ Vec Snapshot::velocity(Position bfr) const
 
 double Snapshot::velocityDispersion(int m) const
 {
-    return properties(m)[velocityDispersionIndex()];
+    return property(m, velocityDispersionIndex());
 }
 
 ////////////////////////////////////////////////////////////////////
 
 Vec Snapshot::magneticField(int m) const
 {
-    const auto& propv = properties(m);
-    return Vec(propv[magneticFieldIndex() + 0], propv[magneticFieldIndex() + 1], propv[magneticFieldIndex() + 2]);
+    return Vec(property(m, magneticFieldIndex() + 0), property(m, magneticFieldIndex() + 1),
+               property(m, magneticFieldIndex() + 2));
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -488,7 +487,7 @@ Vec Snapshot::magneticField(Position bfr) const
 
 double Snapshot::bias(int m) const
 {
-    return properties(m)[biasIndex()];
+    return property(m, biasIndex());
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -497,8 +496,7 @@ void Snapshot::parameters(int m, Array& params) const
 {
     int n = numParameters();
     params.resize(n);
-    const auto& propv = properties(m);
-    for (int i = 0; i != n; ++i) params[i] = propv[parametersIndex() + i];
+    for (int i = 0; i != n; ++i) params[i] = property(m, parametersIndex() + i);
 }
 
 ////////////////////////////////////////////////////////////////////
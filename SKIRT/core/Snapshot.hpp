@@ -345,7 +345,7 @@ protected:
 
         The function assumes that the snapshot is fully configured, all properties have been read,
         and the following functions implemented in the subclass return the proper values:
-        numEntities(), properties(m), volume(m). */
+        numEntities(), property(m, p), volume(m). */
     void calculateDensityAndMass(Array& rhov, Array& cumrhov, double& mass);
 
     //============== Interrogation (to be implemented in subclass) =============
@@ -398,10 +398,12 @@ public:
     virtual Position generatePosition() const = 0;
 
 protected:
-    /** This function returns a reference to an array containing the imported properties (in column
-        order) for the entity with index \f$0\le m \le N_\mathrm{ent}-1\f$. If the index is out of
-        range, the behavior is undefined. */
-    virtual const Array& properties(int m) const = 0;
+    /** This function returns the value of the imported property with column index \em p for the
+        entity with index \f$0\le m \le N_\mathrm{ent}-1\f$. Using a per-value accessor rather
+        than returning a reference to a per-entity array allows subclasses to store the imported
+        properties in any layout, e.g. column-wise. If either index is out of range, the behavior
+        is undefined. */
+    virtual double property(int m, int p) const = 0;
 
 public:
     /** This function replaces the contents of the specified entity collection by the set of
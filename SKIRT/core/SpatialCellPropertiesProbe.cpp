@@ -5,6 +5,7 @@
 
 #include "SpatialCellPropertiesProbe.hpp"
 #include "MediumSystem.hpp"
+#include "ProbeSystem.hpp"
 #include "StringUtils.hpp"
 #include "TextOutFile.hpp"
 #include "Units.hpp"
@@ -20,8 +21,9 @@ void SpatialCellPropertiesProbe::probe()
         auto grid = ms->grid();
         auto units = find<Units>();
 
-        // create a text file
-        TextOutFile out(this, itemName() + "_cellprops", "spatial cell properties");
+        // create a text or stored column file
+        TextOutFile out(this, itemName() + "_cellprops", "spatial cell properties",
+                        find<ProbeSystem>()->writeStoredColumns());
 
         // write the header
         out.addColumn("spatial cell index", "", 'd');
@@ -18,6 +18,20 @@ void SpatialGrid::setupSelfBefore()
 
 //////////////////////////////////////////////////////////////////////
 
+bool SpatialGrid::hasCuboidalCells() const
+{
+    return false;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Box SpatialGrid::cellBox(int /*m*/) const
+{
+    return Box();
+}
+
+//////////////////////////////////////////////////////////////////////
+
 void SpatialGrid::writeGridPlotFiles(const SimulationItem* probe) const
 {
     // For the xy plane (always)
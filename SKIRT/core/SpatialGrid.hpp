@@ -44,7 +44,9 @@ public:
     /** This function returns the bounding box that encloses the grid. */
     virtual Box boundingBox() const = 0;
 
-    /** This function returns the volume of the cell with index \f$m\f$. */
+    /** This function returns the volume of the cell with index \f$m\f$. The volume may be zero for
+        some grid types (e.g., for an outer cell of a CompositeSpatialGrid that is completely
+        covered by inner grids), so callers must not blindly divide by it. */
     virtual double volume(int m) const = 0;
 
     /** This function returns the actual or approximate diagonal of the cell with index \f$m\f$.
@@ -71,6 +73,16 @@ public:
     //================ Functions that may be implemented in subclasses ===============
 
 public:
+    /** This function returns true if all cells in the grid are cuboids lined up with the coordinate
+        axes, so that the extent of each cell can be obtained through the cellBox() function. The
+        default implementation returns false. */
+    virtual bool hasCuboidalCells() const;
+
+    /** This function returns the extent of the cell with index \f$m\f$ as a Box object. It should
+        be called only for grids for which hasCuboidalCells() returns true. The default
+        implementation returns an empty box. */
+    virtual Box cellBox(int m) const;
+
     /** This function outputs text data files that allow plotting the structure of the spatial
         grid. The number of data files written depends on the dimension of the spatial grid: for
         spherical symmetry only the intersection with the xy plane is written, for axial symmetry
@@ -0,0 +1,283 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "SpectralClusterCellLibrary.hpp"
+#include "Configuration.hpp"
+#include "DisjointWavelengthGrid.hpp"
+#include "LockFree.hpp"
+#include "Log.hpp"
+#include "MediumSystem.hpp"
+#include "Parallel.hpp"
+#include "ParallelFactory.hpp"
+#include "ProcessManager.hpp"
+#include "Random.hpp"
+#include "StringUtils.hpp"
+#include "Table.hpp"
+#include "TextOutFile.hpp"
+
+////////////////////////////////////////////////////////////////////
+
+int SpectralClusterCellLibrary::numEntries() const
+{
+    return _numClusters;
+}
+
+////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    // the local radiation field in the Milky Way (Mathis et al. 1983) integrated over all wavelengths
+    const double JtotMW = 1.7623e-06;
+
+    // the seed for the random generator used for clustering, so that all processes obtain the same mapping
+    const int clusterSeed = 1729;
+
+    // the minimum number of cells in each mini-batch, and the minimum number per cluster
+    const int minBatchSize = 1000;
+    const int minBatchSizePerCluster = 4;
+
+    // stores the feature vector for the cell with index m in x, i.e. the weighted logarithm of the field strength
+    // followed by the normalized spectrum; the caller must ensure that the cell has a nonzero radiation field
+    void calculateFeatures(const MediumSystem* ms, const Array& dlambdav, double weight, int m, double* x)
+    {
+        Array Ev = ms->meanIntensity(m) * dlambdav;
+        double Etot = Ev.sum();
+        x[0] = weight * log10(Etot / JtotMW);
+        int numBins = dlambdav.size();
+        for (int ell = 0; ell != numBins; ++ell) x[ell + 1] = Ev[ell] / Etot;
+    }
+
+    // returns the index of the cluster center in the table cv that is nearest to the feature vector x;
+    // the calculation of the distance to a center is abandoned as soon as it exceeds the best distance so far
+    int nearestCenter(const double* x, const Table<2>& cv)
+    {
+        int numClusters = cv.size(0);
+        int numFeatures = cv.size(1);
+        const double* cdata = &cv.data()[0];
+
+        int best = 0;
+        double bestDist2 = DBL_MAX;
+        for (int k = 0; k != numClusters; ++k)
+        {
+            const double* c = cdata + k * numFeatures;
+            double dist2 = 0.;
+            for (int i = 0; i != numFeatures && dist2 < bestDist2; ++i)
+            {
+                double d = x[i] - c[i];
+                dist2 += d * d;
+            }
+            if (dist2 < bestDist2)
+            {
+                bestDist2 = dist2;
+                best = k;
+            }
+        }
+        return best;
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+vector<int> SpectralClusterCellLibrary::mapping(const Array& bv) const
+{
+    // get the radiation field wavelength grid and the medium system
+    const Array& dlambdav = find<Configuration>()->radiationFieldWLG()->dlambdav();
+    auto ms = find<MediumSystem>();
+    auto parallel = find<ParallelFactory>()->parallelLocal();
+    auto parallelDistributed = find<ParallelFactory>()->parallelDistributed();
+    auto log = find<Log>();
+    int numCells = ms->numCells();
+    int numBins = dlambdav.size();
+    int numFeatures = numBins + 1;
+
+    // calculate the field strength for all spatial cells; distribute the work over processes and combine the results;
+    // to limit memory usage, the feature vectors are not stored but recalculated from the radiation field when needed
+    Array Uv(numCells);
+    parallelDistributed->call(numCells, [&bv, &dlambdav, ms, &Uv](size_t firstIndex, size_t numIndices) {
+        for (size_t m = firstIndex; m != firstIndex + numIndices; ++m)
+        {
+            // ignore cells that won't be used by the caller
+            if (bv[m])
+            {
+                double U = (ms->meanIntensity(m) * dlambdav).sum() / JtotMW;
+
+                // ignore cells with extremely small radiation fields (compared to the average in the Milky Way)
+                // to avoid wasting library entries on fields that won't change simulation results anyway
+                if (U > 1e-6) Uv[m] = U;
+            }
+        }
+    });
+    ProcessManager::sumToAll(Uv);
+
+    // make a list of the cells to be mapped
+    vector<int> usedv;
+    for (int m = 0; m != numCells; ++m)
+        if (Uv[m] > 0.) usedv.push_back(m);
+    int numUsed = usedv.size();
+
+    // if there are no more cells than clusters, simply map each cell to its own library entry
+    vector<int> nv(numCells, -1);
+    if (numUsed <= _numClusters)
+    {
+        log->info("  Mapping each of " + std::to_string(numUsed) + " cells to its own library entry");
+        for (int i = 0; i != numUsed; ++i) nv[usedv[i]] = i;
+        return nv;
+    }
+
+    log->info("  Clustering radiation field spectra for " + std::to_string(numUsed) + " cells into "
+              + std::to_string(_numClusters) + " library entries");
+
+    // use a dedicated random generator so that the clustering is reproducible and identical for all processes
+    auto random = find<Random>();
+    random->push(clusterSeed);
+
+    // initialize the cluster centers to the feature vectors of distinct randomly selected cells,
+    // using a partial Fisher-Yates shuffle of the list of cells
+    Table<2> cv(_numClusters, numFeatures);
+    {
+        vector<int> poolv = usedv;
+        for (int k = 0; k != _numClusters; ++k)
+        {
+            int j = k + min(numUsed - k - 1, static_cast<int>(random->uniform() * (numUsed - k)));
+            std::swap(poolv[k], poolv[j]);
+            calculateFeatures(ms, dlambdav, _strengthWeight, poolv[k], &cv(k, 0));
+        }
+    }
+
+    // perform the mini-batch k-means iterations
+    log->infoSetElapsed(_numIterations);
+    int batchSize = min(numUsed, max(minBatchSize, minBatchSizePerCluster * _numClusters));
+    vector<int> batchv(batchSize);
+    vector<int> assignv(batchSize);
+    Table<2> xv(batchSize, numFeatures);
+    vector<int> countv(_numClusters);
+    for (int iteration = 0; iteration != _numIterations; ++iteration)
+    {
+        // draw a random sample of cells
+        for (int b = 0; b != batchSize; ++b)
+            batchv[b] = usedv[min(numUsed - 1, static_cast<int>(random->uniform() * numUsed))];
+
+        // calculate the feature vectors for the cells in the sample and assign each cell to the nearest
+        // cluster center, in parallel
+        parallel->call(batchSize, [this, &batchv, &assignv, &xv, &cv, &dlambdav, ms](size_t firstIndex,
+                                                                                    size_t numIndices) {
+            for (size_t b = firstIndex; b != firstIndex + numIndices; ++b)
+            {
+                calculateFeatures(ms, dlambdav, _strengthWeight, batchv[b], &xv(b, 0));
+                assignv[b] = nearestCenter(&xv(b, 0), cv);
+            }
+        });
+
+        // move each center towards the assigned cells with a per-center learning rate, in serial
+        for (int b = 0; b != batchSize; ++b)
+        {
+            int k = assignv[b];
+            double eta = 1. / ++countv[k];
+            for (int i = 0; i != numFeatures; ++i) cv(k, i) += eta * (xv(b, i) - cv(k, i));
+        }
+        log->infoIfElapsed("Clustering iterations performed: ", 1);
+    }
+    random->pop();
+
+    // map each cell to the nearest cluster center, and accumulate the radiation field spectrum for each library
+    // entry; because the cells are weighted by their total field, the accumulated spectrum, once normalized,
+    // equals the weighted average feature; distribute the work over processes and combine the results
+    Table<2> sv(_numClusters, numBins);
+    {
+        Array nmv(numCells);
+        parallelDistributed->call(numUsed, [this, &usedv, &nmv, &cv, &sv, &Uv, &dlambdav, ms, numFeatures,
+                                            numBins](size_t firstIndex, size_t numIndices) {
+            vector<double> x(numFeatures);
+            for (size_t i = firstIndex; i != firstIndex + numIndices; ++i)
+            {
+                int m = usedv[i];
+                calculateFeatures(ms, dlambdav, _strengthWeight, m, x.data());
+                int n = nearestCenter(x.data(), cv);
+                nmv[m] = n + 1;
+                for (int ell = 0; ell != numBins; ++ell) LockFree::add(sv(n, ell), Uv[m] * x[ell + 1]);
+            }
+        });
+        ProcessManager::sumToAll(nmv);
+        ProcessManager::sumToAll(sv.data());
+        for (int m : usedv) nv[m] = static_cast<int>(nmv[m]) - 1;
+    }
+    for (int n = 0; n != _numClusters; ++n)
+    {
+        double sum = 0.;
+        for (int ell = 0; ell != numBins; ++ell) sum += sv(n, ell);
+        if (sum > 0.)
+            for (int ell = 0; ell != numBins; ++ell) sv(n, ell) /= sum;
+    }
+
+    // determine the spectral error for each cell; distribute the work over processes and combine the results
+    Array errorv(numCells);
+    parallelDistributed->call(numUsed, [this, &usedv, &nv, &sv, &errorv, &dlambdav, ms, numFeatures,
+                                        numBins](size_t firstIndex, size_t numIndices) {
+        vector<double> x(numFeatures);
+        for (size_t i = firstIndex; i != firstIndex + numIndices; ++i)
+        {
+            int m = usedv[i];
+            calculateFeatures(ms, dlambdav, _strengthWeight, m, x.data());
+            double error = 0.;
+            for (int ell = 0; ell != numBins; ++ell) error += abs(x[ell + 1] - sv(nv[m], ell));
+            errorv[m] = 0.5 * error;
+        }
+    });
+    ProcessManager::sumToAll(errorv);
+
+    // determine the mean and maximum spectral error for each library entry
+    vector<int> numMappedv(_numClusters);
+    Array Uminv(DBL_MAX, _numClusters);
+    Array Umaxv(_numClusters);
+    Array meanErrorv(_numClusters);
+    Array maxErrorv(_numClusters);
+    for (int m : usedv)
+    {
+        int n = nv[m];
+        numMappedv[n]++;
+        Uminv[n] = min(Uminv[n], Uv[m]);
+        Umaxv[n] = max(Umaxv[n], Uv[m]);
+        meanErrorv[n] += errorv[m];
+        maxErrorv[n] = max(maxErrorv[n], errorv[m]);
+    }
+    for (int n = 0; n != _numClusters; ++n)
+        if (numMappedv[n]) meanErrorv[n] /= numMappedv[n];
+
+    // log a summary of the spectral errors
+    int numNonEmpty = 0;
+    double sumMeanError = 0.;
+    for (int n = 0; n != _numClusters; ++n)
+    {
+        if (numMappedv[n])
+        {
+            numNonEmpty++;
+            sumMeanError += meanErrorv[n];
+        }
+    }
+    log->info("  Spectral error per library entry: average "
+              + StringUtils::toString(100. * sumMeanError / numNonEmpty, 'f', 2) + " %, largest average "
+              + StringUtils::toString(100. * meanErrorv.max(), 'f', 2) + " %, largest for a single cell "
+              + StringUtils::toString(100. * maxErrorv.max(), 'f', 2) + " %");
+
+    // if requested, output the spectral error for each library entry
+    if (_recordClusterErrors)
+    {
+        TextOutFile out(this, "celllibrary_clusters", "spectral errors per library entry");
+        out.addColumn("library entry index", "", 'd');
+        out.addColumn("number of mapped cells", "", 'd');
+        out.addColumn("minimum field strength U", "", 'e', 4);
+        out.addColumn("maximum field strength U", "", 'e', 4);
+        out.addColumn("mean spectral error", "", 'e', 4);
+        out.addColumn("maximum spectral error", "", 'e', 4);
+        for (int n = 0; n != _numClusters; ++n)
+        {
+            if (numMappedv[n]) out.writeRow(n, numMappedv[n], Uminv[n], Umaxv[n], meanErrorv[n], maxErrorv[n]);
+        }
+    }
+
+    return nv;
+}
+
+////////////////////////////////////////////////////////////////////
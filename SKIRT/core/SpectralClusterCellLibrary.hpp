@@ -0,0 +1,103 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#ifndef SPECTRALCLUSTERCELLLIBRARY_HPP
+#define SPECTRALCLUSTERCELLLIBRARY_HPP
+
+#include "SpatialCellLibrary.hpp"
+
+//////////////////////////////////////////////////////////////////////
+
+/** The SpectralClusterCellLibrary class provides a library scheme for grouping spatial cells based
+    on both the strength and the spectral shape of the stored radiation field in each cell. Rather
+    than binning cells on a predefined grid of one or two indicative quantities, the library
+    clusters the radiation field spectra themselves, so that the available library entries are
+    distributed according to the actual variety of radiation fields in the simulation. This is
+    especially useful in combination with the calculation of stochastic dust emission, which is
+    very expensive and sensitive to both the strength and the hardness of the radiation field.
+    The user-configured number of clusters provides an upper limit on the number of emission
+    spectra calculated by the simulation.
+
+    Each cell \f$m\f$ is represented by a feature vector composed of the normalized radiation field
+    spectrum, \f[ s_{m,\ell} = \frac{ J_{m,\ell}\, (\Delta\lambda)_\ell }{ \sum_{\ell'}
+    J_{m,\ell'}\, (\Delta\lambda)_{\ell'} }, \f] where \f$\ell\f$ runs over the bins of the
+    radiation field wavelength grid, supplemented with an additional component \f$w\,\log_{10}
+    U_m\f$, where \f$U_m\f$ is the field strength defined as for the FieldStrengthCellLibrary class
+    and \f$w\f$ is a user-configurable weight. Because the components of the normalized spectrum
+    sum to unity, the Euclidean distance between the spectral parts of two feature vectors is at
+    most \f$\sqrt{2}\f$. The weight \f$w\f$ thus specifies the importance of a difference of one
+    decade in field strength relative to a complete change in spectral shape. As for the
+    FieldStrengthCellLibrary class, cells with extremely small radiation fields (\f$U_m<10^{-6}\f$)
+    are not mapped.
+
+    The feature vectors are clustered using the mini-batch \f$k\f$-means algorithm (Sculley 2010,
+    Proc. 19th Int. Conf. on World Wide Web, 1177). The cluster centers are initialized to the
+    feature vectors of randomly selected cells. In each of a user-configurable number of
+    iterations, the algorithm then assigns a random sample of cells to their nearest cluster center
+    and moves each of these centers towards the assigned cells with a learning rate that decreases
+    with the number of cells previously assigned to the center. Finally, each cell is mapped to the
+    library entry corresponding to its nearest cluster center. To limit memory usage for large
+    numbers of cells, the feature vectors are not stored but recalculated from the radiation field
+    whenever they are needed. The nearest-center searches are performed in parallel, and the final
+    mapping is distributed over processes. The random samples are drawn from a dedicated random
+    generator with a fixed seed, so that all processes in a multi-processing environment obtain the
+    same mapping. If the number of cells to be mapped does not exceed the number of clusters, each
+    cell is simply mapped to its own library entry.
+
+    For each library entry, the function determines the spectral error, defined as the fraction
+    of the radiative energy that is assigned to a different wavelength bin when replacing the
+    normalized spectrum of a cell by the normalized spectrum of the average radiation field of all
+    cells mapped to the entry, i.e. \f$\frac{1}{2}\sum_\ell |s_{m,\ell} - \bar{s}_{\ell}|\f$. The
+    mean and maximum spectral error over the cells mapped to each entry are summarized in the log
+    and, if requested, written to a text file for each entry separately. The output file is named
+    <tt>prefix_celllibrary_clusters.dat</tt>. */
+class SpectralClusterCellLibrary : public SpatialCellLibrary
+{
+    ITEM_CONCRETE(SpectralClusterCellLibrary, SpatialCellLibrary,
+                  "a library scheme for grouping spatial cells by clustering radiation field spectra")
+        ATTRIBUTE_TYPE_INSERT(SpectralClusterCellLibrary, "NonIdentitySpatialCellLibrary")
+
+        PROPERTY_INT(numClusters, "the maximum number of library entries (i.e. emission spectrum calculations)")
+        ATTRIBUTE_MIN_VALUE(numClusters, "10")
+        ATTRIBUTE_MAX_VALUE(numClusters, "10000000")
+        ATTRIBUTE_DEFAULT_VALUE(numClusters, "1000")
+
+        PROPERTY_DOUBLE(strengthWeight, "the weight of one decade in field strength relative to the spectral shape")
+        ATTRIBUTE_MIN_VALUE(strengthWeight, "[0")
+        ATTRIBUTE_MAX_VALUE(strengthWeight, "100]")
+        ATTRIBUTE_DEFAULT_VALUE(strengthWeight, "0.3")
+        ATTRIBUTE_DISPLAYED_IF(strengthWeight, "Level3")
+
+        PROPERTY_INT(numIterations, "the number of mini-batch clustering iterations")
+        ATTRIBUTE_MIN_VALUE(numIterations, "1")
+        ATTRIBUTE_MAX_VALUE(numIterations, "10000")
+        ATTRIBUTE_DEFAULT_VALUE(numIterations, "50")
+        ATTRIBUTE_DISPLAYED_IF(numIterations, "Level3")
+
+        PROPERTY_BOOL(recordClusterErrors, "output the spectral error for each library entry to a text file")
+        ATTRIBUTE_DEFAULT_VALUE(recordClusterErrors, "false")
+        ATTRIBUTE_DISPLAYED_IF(recordClusterErrors, "Level3")
+
+    ITEM_END()
+
+    //======================== Other Functions =======================
+
+protected:
+    /** This function returns the number of entries in the library. In this class the function
+        returns the user-configured number of clusters. */
+    int numEntries() const override;
+
+    /** This function returns a vector \em nv with length \f$N_{\text{cells}}\f$ that maps each
+        cell index \f$m\f$ to the corresponding library entry index \f$n_m\f$. In this class the
+        function calculates the feature vector for each spatial cell, clusters these vectors using
+        the mini-batch \f$k\f$-means algorithm, and maps each cell to the entry corresponding to
+        the nearest cluster center, as described in the class header. It also logs (and optionally
+        outputs) the spectral error for the resulting library entries. */
+    vector<int> mapping(const Array& bv) const override;
+};
+
+////////////////////////////////////////////////////////////////////
+
+#endif
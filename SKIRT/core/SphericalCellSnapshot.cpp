@@ -284,9 +284,9 @@ Position SphericalCellSnapshot::generatePosition() const
 
 ////////////////////////////////////////////////////////////////////
 
-const Array& SphericalCellSnapshot::properties(int m) const
+double SphericalCellSnapshot::property(int m, int p) const
 {
-    return _propv[m];
+    return _propv[m][p];
 }
 
 ////////////////////////////////////////////////////////////////////
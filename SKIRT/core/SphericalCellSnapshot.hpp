@@ -169,10 +169,10 @@ public:
     Position generatePosition() const override;
 
 protected:
-    /** This function returns a reference to an array containing the imported properties (in column
-        order) for the cell with index \f$0\le m \le N_\mathrm{ent}-1\f$. If the index is out of
-        range, the behavior is undefined. */
-    const Array& properties(int m) const override;
+    /** This function returns the value of the imported property with column index \em p for the
+        cell with index \f$0\le m \le N_\mathrm{ent}-1\f$. If either index is out of range, the
+        behavior is undefined. */
+    double property(int m, int p) const override;
 
 public:
     /** This function sets the specified entity collection to the cell containing the specified
@@ -107,6 +107,22 @@ public:
         return result;
     }
 
+    /** This function returns a pointer to the column values in the next row, or the null pointer
+        if there are no more rows or if no file is open, and stores the number of remaining rows
+        (including the next row) in \em numRows. The remaining rows are stored consecutively
+        starting at the returned address, with the column values in each row listed in the order
+        corresponding to the list returned by columnNames(). After calling this function, all rows
+        are considered to have been consumed, i.e. subsequent invocations of nextRow() return the
+        null pointer. The returned pointer becomes invalid when the file is closed. */
+    const double* remainingRows(size_t& numRows)
+    {
+        numRows = _numColumns ? (_endRow - _nextRow) / _numColumns : 0;
+        if (!numRows) return nullptr;
+        auto result = _nextRow;
+        _nextRow = _endRow;
+        return result;
+    }
+
     // ================== Data members ==================
 
 private:
@@ -204,99 +204,62 @@ public:
     template<typename... Values, typename = std::enable_if_t<CompileTimeUtils::isFloatArgList<N, Values...>()>>
     double operator()(Values... values) const
     {
-        // storage for each axis
-        std::array<double, N> value = {{static_cast<double>(values)...}};
-        std::array<size_t, N> i2;  // upper grid bin boundary index
-        std::array<double, N> f;   // fraction of axis value in bin
-
-        // precompute for each axis
-        for (size_t k = 0; k != N; ++k)
-        {
-            // get the index of the upper border of the axis grid bin containing the specified axis value
-            double x = value[k];
-            size_t right = std::lower_bound(_axBeg[k], _axBeg[k] + _axLen[k], x) - _axBeg[k];
-
-            // if the value is beyond the grid borders:
-            //    - if we're not clamping, simply return zero
-            //    - if we're clamping, adjust both the bin border and the value
-            if (right == 0)
-            {
-                if (!_clamp && k == 0 && x != _axBeg[k][0]) return 0.;
-                right++;
-                x = _axBeg[k][0];
-            }
-            else if (right == _axLen[k])
-            {
-                if (!_clamp && k == 0) return 0.;
-                right--;
-                x = _axBeg[k][right];
-            }
-            i2[k] = right;
-
-            // get the axis values at the grid borders
-            double x1 = _axBeg[k][right - 1];
-            double x2 = _axBeg[k][right];
-
-            // if requested, compute logarithm of coordinate values
-            if (_axLog[k])
-            {
-                x = log(x);
-                x1 = log(x1);
-                x2 = log(x2);
-            }
+        size_t hint = 0;
+        return valueWithHint(hint, values...);
+    }
 
-            // calculate the fraction of the requested axis value in the bin
-            f[k] = (x - x1) / (x2 - x1);
-        }
+    /** This function returns the same value as the parenthesis operator for the specified axes
+        values. In addition, it uses and updates the \em hint argument, which holds the index of
+        the upper border of the first-axis grid bin located by the previous invocation. The search
+        for the bin containing the specified first-axis value starts from this index, which is
+        faster when consecutive invocations specify first-axis values that are close together. The
+        caller should initialize the hint to zero, and should not otherwise change its value. */
+    template<typename... Values, typename = std::enable_if_t<CompileTimeUtils::isFloatArgList<N, Values...>()>>
+    double valueWithHint(size_t& hint, Values... values) const
+    {
+        std::array<double, N> value = {{static_cast<double>(values)...}};
+        size_t i0;
+        double f0;
+        if (!locate(0, value[0], i0, f0, hint)) return 0.;
+        hint = i0;
+
+        std::array<double, numOuterTerms> ffo;
+        std::array<size_t, numOuterTerms> offo;
+        precomputeOuterTerms(value, ffo, offo);
+        return interpolate(i0, f0, ffo, offo);
+    }
 
-        // storage for each term in the interpolation
-        constexpr size_t numTerms = 1 << N;  // there are 2^N terms
-        std::array<double, numTerms> ff;     // front factor
-        std::array<double, numTerms> yy;     // tabulated value
+    /** This function stores in \em yv the values of the quantity represented by this stored table
+        for each of the first-axis values in \em xv, using the given fixed values for the other
+        axes, if any (the arguments at the end of the list). The values are identical to those
+        returned by the parenthesis operator for the corresponding axes values. However, the
+        interpolation weights for the other axes are calculated just once, and the search for the
+        first-axis grid bin starts from the bin located for the previous value. As a result, this
+        function is substantially faster than repeatedly invoking the parenthesis operator,
+        especially when the values in \em xv are sorted in increasing order. */
+    template<typename... Values, typename = std::enable_if_t<CompileTimeUtils::isFloatArgList<N - 1, Values...>()>>
+    void valueArray(Array& yv, const Array& xv, Values... values) const
+    {
+        std::array<double, N> value = {{0., static_cast<double>(values)...}};
+        std::array<double, numOuterTerms> ffo;
+        std::array<size_t, numOuterTerms> offo;
+        precomputeOuterTerms(value, ffo, offo);
 
-        // determine front factor and tabulated value for each term of the interpolation
-        std::array<size_t, N> indices;  // storage for indices of the current term
-        for (size_t t = 0; t != numTerms; ++t)
+        size_t n = xv.size();
+        yv.resize(n);
+        size_t hint = 0;
+        for (size_t i = 0; i != n; ++i)
         {
-            // use the binary representation of the term index to determine left/right for each axis
-            size_t term = t;  // temporary version of term index that will be bit-shifted
-            double front = 1.;
-            for (size_t k = 0; k != N; ++k)
+            size_t i0;
+            double f0;
+            if (locate(0, xv[i], i0, f0, hint))
             {
-                size_t left = term & 1;  // lowest significant digit = 1 means lower border
-                indices[k] = i2[k] - left;
-                front *= left ? (1 - f[k]) : f[k];
-                term >>= 1;
-            }
-            if (front)
-            {
-                ff[t] = front;
-                yy[t] = valueAtIndices(indices);
-
-                // if logarithmic interpolation of y value is requested and not all bordering values are positive,
-                // we can't comply with the request, so return zero
-                if (_qtyLog && yy[t] <= 0) return 0.;
+                yv[i] = interpolate(i0, f0, ffo, offo);
+                hint = i0;
             }
             else
-            {
-                ff[t] = 0.;
-                yy[t] = 0.;
-            }
+                yv[i] = 0.;
         }
-
-        // calculate sum
-        double y = 0.;
-        if (_qtyLog)
-        {
-            for (size_t t = 0; t != numTerms; ++t)
-                if (ff[t]) y += ff[t] * log(yy[t]);
-            y = exp(y);
-        }
-        else
-        {
-            for (size_t t = 0; t != numTerms; ++t) y += ff[t] * yy[t];
-        }
-        return y;
     }
 
     /** For a one-dimensional table only, this function returns the value of the quantity
@@ -336,52 +299,11 @@ public:
     template<typename... Values, typename = std::enable_if_t<CompileTimeUtils::isFloatArgList<N - 1, Values...>()>>
     double cdf(Array& xv, Array& pv, Array& Pv, Range xrange, Values... values) const
     {
-        // storage for each axis
+        // precompute the interpolation terms for all but the first axis
         std::array<double, N> value = {{0., static_cast<double>(values)...}};
-        std::array<size_t, N> i2;       // upper grid bin boundary index
-        std::array<double, N> f;        // fraction of axis value in bin
-        std::array<size_t, N> indices;  // indices of the current term
-
-        // storage for each term in the interpolation
-        constexpr size_t numTerms = 1 << N;  // there are 2^N terms
-        std::array<double, numTerms> ff;     // front factor
-        std::array<double, numTerms> yy;     // tabulated value
-
-        // precompute grid index and fraction for all but the first axis
-        for (size_t k = 1; k != N; ++k)
-        {
-            // get the index of the upper border of the axis grid bin containing the specified axis value
-            double x = value[k];
-            size_t right = std::lower_bound(_axBeg[k], _axBeg[k] + _axLen[k], x) - _axBeg[k];
-
-            // if the value is beyond the grid borders, adjust both the bin border and the value
-            if (right == 0)
-            {
-                right++;
-                x = _axBeg[k][0];
-            }
-            else if (right == _axLen[k])
-            {
-                right--;
-                x = _axBeg[k][right];
-            }
-            i2[k] = right;
-
-            // get the axis values at the grid borders
-            double x1 = _axBeg[k][right - 1];
-            double x2 = _axBeg[k][right];
-
-            // if requested, compute logarithm of coordinate values
-            if (_axLog[k])
-            {
-                x = log(x);
-                x1 = log(x1);
-                x2 = log(x2);
-            }
-
-            // calculate the fraction of the requested axis value in the bin
-            f[k] = (x - x1) / (x2 - x1);
-        }
+        std::array<double, numOuterTerms> ffo;
+        std::array<size_t, numOuterTerms> offo;
+        precomputeOuterTerms(value, ffo, offo);
 
         // determine the relevant portion of the internal first axis grid
         size_t minRight = std::upper_bound(_axBeg[0], _axBeg[0] + _axLen[0], xrange.min()) - _axBeg[0];
@@ -399,106 +321,19 @@ public:
             double x = (i == 0 ? xrange.min() : (i == n - 1 ? xrange.max() : _axBeg[0][i + minRight - 1]));
             xv[i] = x;
 
-            // compute grid index and fraction for the outermost first axis points
+            // interpolate for the outermost first axis points
             if (i == 0 || i == n - 1)
             {
-                // get the index of the upper border of the axis grid bin containing the specified axis value
-                size_t right = std::lower_bound(_axBeg[0], _axBeg[0] + _axLen[0], x) - _axBeg[0];
-
-                // if the value is beyond the grid borders:
-                //    - if we're not clamping, simply return zero
-                //    - if we're clamping, adjust both the bin border and the value
-                if (right == 0)
-                {
-                    if (!_clamp && x != _axBeg[0][0])
-                    {
-                        pv[i] = 0.;
-                        continue;
-                    };
-                    right++;
-                    x = _axBeg[0][0];
-                }
-                else if (right == _axLen[0])
-                {
-                    if (!_clamp)
-                    {
-                        pv[i] = 0.;
-                        continue;
-                    };
-                    right--;
-                    x = _axBeg[0][right];
-                }
-                i2[0] = right;
-
-                // get the axis values at the grid borders
-                double x1 = _axBeg[0][right - 1];
-                double x2 = _axBeg[0][right];
-
-                // if requested, compute logarithm of coordinate values
-                if (_axLog[0])
-                {
-                    x = log(x);
-                    x1 = log(x1);
-                    x2 = log(x2);
-                }
-
-                // calculate the fraction of the requested axis value in the bin
-                f[0] = (x - x1) / (x2 - x1);
-            }
-
-            // set grid index and fraction for the inner axis points, which don't need interpolation
-            else
-            {
-                i2[0] = i + minRight - 1;
-                f[0] = 1.;
-            }
-
-            // determine front factor and tabulated value for each term of the interpolation
-            for (size_t t = 0; t != numTerms; ++t)
-            {
-                // use the binary representation of the term index to determine left/right for each axis
-                size_t term = t;  // temporary version of term index that will be bit-shifted
-                double front = 1.;
-                for (size_t k = 0; k != N; ++k)
-                {
-                    size_t left = term & 1;  // lowest significant digit = 1 means lower border
-                    indices[k] = i2[k] - left;
-                    front *= left ? (1 - f[k]) : f[k];
-                    term >>= 1;
-                }
-                if (front)
-                {
-                    ff[t] = front;
-                    yy[t] = valueAtIndices(indices);
-
-                    // if logarithmic interpolation of y value is requested and not all bordering values are positive,
-                    // we can't comply with the request, so return zero
-                    if (_qtyLog && yy[t] <= 0)
-                    {
-                        pv[i] = 0.;
-                        continue;
-                    };
-                }
-                else
-                {
-                    ff[t] = 0.;
-                    yy[t] = 0.;
-                }
+                size_t i0;
+                double f0;
+                pv[i] = locate(0, x, i0, f0) ? interpolate(i0, f0, ffo, offo) : 0.;
             }
 
-            // calculate sum
-            double y = 0.;
-            if (_qtyLog)
-            {
-                for (size_t t = 0; t != numTerms; ++t)
-                    if (ff[t]) y += ff[t] * log(yy[t]);
-                y = exp(y);
-            }
+            // the inner axis points don't need interpolation along the first axis
             else
             {
-                for (size_t t = 0; t != numTerms; ++t) y += ff[t] * yy[t];
+                pv[i] = interpolate(i + minRight - 1, 1., ffo, offo);
             }
-            pv[i] = y;
         }
 
         // perform the rest of the operation in a non-templated function
@@ -563,6 +398,151 @@ private:
         checking. Out-of-range index values cause unpredictable behavior. */
     double valueAtIndices(const std::array<size_t, N>& indices) const { return _qtyBeg[flattenedIndex(indices)]; }
 
+    /** This function returns the index of the first grid point on the axis with index \em k that
+        is not less than the specified value, or the number of grid points if there is no such
+        point. If the \em hint argument is nonzero and the specified value lies beyond the grid
+        point preceding the hinted index, the search is limited to the grid points starting at the
+        hinted index. */
+    size_t upperIndex(size_t k, double x, size_t hint) const
+    {
+        const double* beg = _axBeg[k];
+        const double* end = beg + _axLen[k];
+        if (hint && hint < _axLen[k] && beg[hint - 1] < x)
+        {
+            if (x <= beg[hint]) return hint;
+            return std::lower_bound(beg + hint + 1, end, x) - beg;
+        }
+        return std::lower_bound(beg, end, x) - beg;
+    }
+
+    /** This function determines the index \em i2 of the upper border of the grid bin containing
+        the specified value on the axis with index \em k, and the fraction \em f of the value in
+        that bin, taking into account the interpolation type of the axis. Out-of-range values are
+        clamped to the corresponding outer grid point, except that the function returns false for
+        out-of-range first-axis values if the \em clampFirstAxis flag was turned off, indicating
+        that the quantity value should be considered to be zero. In all other cases, the function
+        returns true. The \em hint argument is passed to the upperIndex() function. */
+    bool locate(size_t k, double x, size_t& i2, double& f, size_t hint = 0) const
+    {
+        // get the index of the upper border of the axis grid bin containing the specified axis value
+        size_t right = upperIndex(k, x, hint);
+
+        // if the value is beyond the grid borders:
+        //    - if we're not clamping, simply return false
+        //    - if we're clamping, adjust both the bin border and the value
+        if (right == 0)
+        {
+            if (!_clamp && k == 0 && x != _axBeg[k][0]) return false;
+            right++;
+            x = _axBeg[k][0];
+        }
+        else if (right == _axLen[k])
+        {
+            if (!_clamp && k == 0) return false;
+            right--;
+            x = _axBeg[k][right];
+        }
+        i2 = right;
+
+        // get the axis values at the grid borders
+        double x1 = _axBeg[k][right - 1];
+        double x2 = _axBeg[k][right];
+
+        // if requested, compute logarithm of coordinate values
+        if (_axLog[k])
+        {
+            x = log(x);
+            x1 = log(x1);
+            x2 = log(x2);
+        }
+
+        // calculate the fraction of the requested axis value in the bin
+        f = (x - x1) / (x2 - x1);
+        return true;
+    }
+
+    // the number of terms in the interpolation over all but the first axis
+    static constexpr size_t numOuterTerms = 1 << (N - 1);
+
+    /** This function calculates the front factor \em ffo and the offset \em offo in the
+        underlying data array for each of the terms in the interpolation over all but the first
+        axis, given the values in \em value for these axes. The first element of \em value is
+        ignored. */
+    void precomputeOuterTerms(const std::array<double, N>& value, std::array<double, numOuterTerms>& ffo,
+                              std::array<size_t, numOuterTerms>& offo) const
+    {
+        // precompute grid index and fraction for all but the first axis
+        std::array<size_t, N> i2;  // upper grid bin boundary index
+        std::array<double, N> f;   // fraction of axis value in bin
+        for (size_t k = 1; k != N; ++k) locate(k, value[k], i2[k], f[k]);
+
+        // determine front factor and data offset for each term of the interpolation
+        std::array<size_t, N> indices;  // storage for indices of the current term
+        indices[0] = 0;
+        for (size_t t = 0; t != numOuterTerms; ++t)
+        {
+            // use the binary representation of the term index to determine left/right for each axis
+            size_t term = t;  // temporary version of term index that will be bit-shifted
+            double front = 1.;
+            for (size_t k = 1; k != N; ++k)
+            {
+                size_t left = term & 1;  // lowest significant digit = 1 means lower border
+                indices[k] = i2[k] - left;
+                front *= left ? (1 - f[k]) : f[k];
+                term >>= 1;
+            }
+            ffo[t] = front;
+            offo[t] = flattenedIndex(indices);
+        }
+    }
+
+    /** This function returns the interpolated quantity value given the index \em i0 of the upper
+        border of the first-axis grid bin, the fraction \em f0 of the first-axis value in that bin,
+        and the front factors and data offsets for the other axes as calculated by the
+        precomputeOuterTerms() function. Bordering values with a zero front factor are ignored, so
+        that they do not contribute to the result even if they are infinite or NaN. If logarithmic
+        interpolation of the quantity is requested and not all bordering values with a nonzero
+        front factor are positive, the function returns zero. */
+    double interpolate(size_t i0, double f0, const std::array<double, numOuterTerms>& ffo,
+                       const std::array<size_t, numOuterTerms>& offo) const
+    {
+        const double* right = _qtyBeg + i0 * _qtyStep;
+        const double* left = right - _qtyStep;
+        double y = 0.;
+        if (_qtyLog)
+        {
+            for (size_t t = 0; t != numOuterTerms; ++t)
+            {
+                double frontRight = f0 * ffo[t];
+                double frontLeft = (1 - f0) * ffo[t];
+                if (frontRight)
+                {
+                    double yy = right[offo[t]];
+                    if (yy <= 0) return 0.;
+                    y += frontRight * log(yy);
+                }
+                if (frontLeft)
+                {
+                    double yy = left[offo[t]];
+                    if (yy <= 0) return 0.;
+                    y += frontLeft * log(yy);
+                }
+            }
+            y = exp(y);
+        }
+        else
+        {
+            for (size_t t = 0; t != numOuterTerms; ++t)
+            {
+                double frontRight = f0 * ffo[t];
+                double frontLeft = (1 - f0) * ffo[t];
+                if (frontRight) y += frontRight * right[offo[t]];
+                if (frontLeft) y += frontLeft * left[offo[t]];
+            }
+        }
+        return y;
+    }
+
     /** This function returns the flattened index in the underlying data array for the specified N
         indices. */
     size_t flattenedIndex(const std::array<size_t, N>& indices) const
@@ -169,7 +169,13 @@ void StoredTable_Impl::open(size_t numAxes, const SimulationItem* item, string f
     thread_local string previousFilePath;
     if (item != previousItem || filePath != previousFilePath)
     {
-        item->find<Log>()->info(item->type() + " opened stored table " + filePath);
+        // include statistics on the memory map to help diagnose file system performance issues
+        auto statistics = System::memoryMapStatistics(filePath);
+        string message = item->type() + " opened stored table " + filePath + " ("
+                         + StringUtils::toMemSizeString(statistics.length) + ", "
+                         + StringUtils::toString(100. * statistics.residentLength / statistics.length, 'f', 0)
+                         + "% resident)";
+        item->find<Log>()->info(message);
         previousItem = item;
         previousFilePath = filePath;
     }
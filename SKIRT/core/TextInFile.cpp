@@ -7,9 +7,12 @@
 #include "FatalError.hpp"
 #include "FilePaths.hpp"
 #include "Log.hpp"
+#include "Parallel.hpp"
+#include "ParallelFactory.hpp"
 #include "StringUtils.hpp"
 #include "System.hpp"
 #include "Units.hpp"
+#include <cstring>
 #include <exception>
 #include <regex>
 #include <sstream>
@@ -57,17 +60,125 @@ namespace
     }
 }
 
+namespace
+{
+    // the minimum number of bytes remaining in a text file for reading it in bulk
+    const size_t minBulkSize = 1 << 20;
+
+    // the approximate number of bytes in a block of the text file parsed and buffered in one go
+    const size_t bulkBlockSize = 16 << 20;
+
+    // the approximate number of bytes in a chunk of the text file parsed by a single execution thread
+    const size_t bulkChunkSize = 1 << 20;
+
+    // This function returns true if the specified character is considered to be white space by the standard library
+    inline bool isWhiteSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+    }
+
+    // This function parses a floating point number in decimal notation starting at the specified position, which must
+    // not point to white space. The number ends at the first character that cannot be part of it, as for the stream
+    // extraction operator. If successful, the function stores the number in the value argument, advances the position
+    // beyond the number, and returns true. Otherwise, it returns false without changing the position.
+    // Numbers with at most 15 significant digits and a moderate decimal exponent are converted using a single exact
+    // floating point operation, which yields the correctly rounded result. All other numbers are passed on to the
+    // standard library, which also produces the correctly rounded result.
+    bool parseDouble(const char*& pos, const char* end, double& value)
+    {
+        // the powers of ten that can be represented exactly in double precision
+        static const double exactPowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                  1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+        const char* p = pos;
+        bool negative = false;
+        if (p != end && (*p == '+' || *p == '-')) negative = *p++ == '-';
+
+        // accumulate up to 15 significant digits in the integer and fractional part
+        uint64_t mantissa = 0;
+        int numSignificant = 0;
+        int exponent = 0;
+        bool haveDigits = false;
+        bool exact = true;
+        for (bool fraction = false; p != end; ++p)
+        {
+            if (*p >= '0' && *p <= '9')
+            {
+                haveDigits = true;
+                if (numSignificant < 15)
+                {
+                    mantissa = 10 * mantissa + (*p - '0');
+                    if (mantissa) numSignificant++;
+                    if (fraction) exponent--;
+                }
+                else
+                {
+                    if (*p != '0') exact = false;
+                    if (!fraction) exponent++;
+                }
+            }
+            else if (*p == '.' && !fraction)
+                fraction = true;
+            else
+                break;
+        }
+        if (!haveDigits) return false;
+
+        // parse the optional decimal exponent, which must include at least one digit
+        if (p != end && (*p == 'e' || *p == 'E'))
+        {
+            const char* q = p + 1;
+            bool negativeExponent = false;
+            if (q != end && (*q == '+' || *q == '-')) negativeExponent = *q++ == '-';
+            if (q != end && *q >= '0' && *q <= '9')
+            {
+                int explicitExponent = 0;
+                for (; q != end && *q >= '0' && *q <= '9'; ++q)
+                    if (explicitExponent < 100000) explicitExponent = 10 * explicitExponent + (*q - '0');
+                exponent += negativeExponent ? -explicitExponent : explicitExponent;
+                p = q;
+            }
+        }
+
+        // convert the number
+        if (exact && exponent >= -22 && exponent <= 22)
+        {
+            value = static_cast<double>(mantissa);
+            value = exponent < 0 ? value / exactPowersOfTen[-exponent] : value * exactPowersOfTen[exponent];
+            if (negative) value = -value;
+        }
+        else
+        {
+            value = std::strtod(string(pos, p).c_str(), nullptr);
+        }
+        pos = p;
+        return true;
+    }
+
+    // This function returns the offset just beyond the first newline character at or after the specified offset
+    // in the specified text, or the size of the text if there is no such newline character
+    size_t nextLineBoundary(const char* text, size_t size, size_t offset)
+    {
+        if (offset >= size) return size;
+        const char* eol = static_cast<const char*>(memchr(text + offset, '\n', size - offset));
+        return eol ? eol - text + 1 : size;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////
 
 TextInFile::TextInFile(const SimulationItem* item, string filename, string description, bool resource)
 {
-    // remember the units system and the logger
+    // remember the units system, the logger, and the parallel factory (if available)
     _units = item->find<Units>();
     _log = item->find<Log>();
+    _parallelFactory = item->find<ParallelFactory>(false);
 
     // get the full path for the resource or for the input file
     _isResource = resource;
     string filepath = resource ? FilePaths::resource(filename) : item->find<FilePaths>()->input(filename);
+    _filePath = filepath;
 
     // if the file is in SKIRT stored column format, open a binary file
     if (StringUtils::endsWith(filepath, ".scol"))
@@ -129,6 +240,13 @@ TextInFile::TextInFile(const SimulationItem* item, string filename, string descr
 void TextInFile::close()
 {
     if (_hasTextOpen) _in.close();
+    if (_bulkActive)
+    {
+        System::releaseMemoryMap(_filePath);
+        _bulkActive = false;
+        _bulkValues.clear();
+        _bulkValues.shrink_to_fit();
+    }
     if (_hasBinaryOpen) _scol.close();
 
     if (_hasTextOpen || _hasBinaryOpen)
@@ -394,6 +512,28 @@ bool TextInFile::readRow(Array& values)
     // read next row in text file
     if (_hasTextOpen)
     {
+        // determine whether to read the file in bulk, the first time a row is requested
+        if (!_bulkChecked) startBulkReading();
+
+        // hand out the next buffered row, parsing the next block of the file if needed
+        if (_bulkActive)
+        {
+            while (true)
+            {
+                if (_bulkNextRow != _bulkNumRows)
+                {
+                    if (values.size() != _numLogCols) values.resize(_numLogCols);
+                    const double* row = _bulkValues.data() + _bulkNextRow * _numLogCols;
+                    std::copy(row, row + _numLogCols, begin(values));
+                    _bulkNextRow++;
+                    return true;
+                }
+                if (!_bulkError.empty()) throw FATALERROR(_bulkError);
+                if (_mapPos == _mapSize) return false;
+                parseBulkBlock();
+            }
+        }
+
         // read new line until it is non-empty and non-comment
         string line;
         while (_in.good())
@@ -406,36 +546,8 @@ bool TextInFile::readRow(Array& values)
                 if (values.size() != _numLogCols || _haveZeroCols) values.resize(_numLogCols);
 
                 // convert values from line and store them in result array
-                std::stringstream linestream(line);
-                for (size_t i : _logColIndices)  // i: zero-based logical index
-                {
-                    if (linestream.eof()) throw FATALERROR("One or more required value(s) on text line are missing");
-
-                    // read the value as floating point
-                    double value;
-                    linestream >> value;
-                    if (linestream.fail())
-                    {
-                        // some compilers/libraries do not support reading NaN or Inf values, while others do;
-                        // we here provide backup support for NaN values (infinities are more complex because of
-                        // the need for handling the negative sign which may be already consumed by the stream)
-                        linestream.clear();
-                        string offending;
-                        linestream >> offending;
-                        if (StringUtils::toLower(offending) != "nan")
-                            throw FATALERROR("Input text is not formatted as a floating point number: " + offending);
-                        value = std::numeric_limits<double>::quiet_NaN();
-                    }
-
-                    // if mapped to a logical column, convert from input units to internal units, and store the result
-                    if (i != ERROR_NO_INDEX)
-                    {
-                        const ColumnInfo& col = _colv[i];
-                        if (col.convPower != 1.) value = pow(value, col.convPower);
-                        value *= (col.waveExponent ? pow(values[col.waveIndex], col.waveExponent) : col.convFactor);
-                        values[i] = value;
-                    }
-                }
+                string error = parseLine(line.data(), line.data() + line.size(), values);
+                if (!error.empty()) throw FATALERROR(error);
                 return true;
             }
         }
@@ -480,6 +592,10 @@ bool TextInFile::readNonLeaf(int& nx, int& ny, int& nz)
     // read next non-leaf row in text file
     if (_hasTextOpen)
     {
+        // nonleaf lines cannot be handled in bulk reading mode
+        if (_bulkActive) throw FATALERROR("Cannot read nonleaf lines after reading regular lines in bulk");
+        _bulkChecked = true;
+
         string line;
 
         while (true)
@@ -527,6 +643,138 @@ bool TextInFile::readNonLeaf(int& nx, int& ny, int& nz)
 
 ////////////////////////////////////////////////////////////////////
 
+string TextInFile::parseLine(const char* begin, const char* end, Array& values) const
+{
+    const char* pos = begin;
+    for (size_t i : _logColIndices)  // i: zero-based logical index
+    {
+        // skip white space, verifying that there is a value
+        while (pos != end && isWhiteSpace(*pos)) ++pos;
+        if (pos == end) return "One or more required value(s) on text line are missing";
+
+        // read the value as floating point
+        double value;
+        if (!parseDouble(pos, end, value))
+        {
+            // we provide support for NaN values, with an optional sign
+            const char* tokenEnd = pos;
+            while (tokenEnd != end && !isWhiteSpace(*tokenEnd)) ++tokenEnd;
+            string offending(pos, tokenEnd);
+            string unsignedOffending = offending[0] == '+' || offending[0] == '-' ? offending.substr(1) : offending;
+            if (StringUtils::toLower(unsignedOffending) != "nan")
+                return "Input text is not formatted as a floating point number: " + offending;
+            value = std::numeric_limits<double>::quiet_NaN();
+            pos = tokenEnd;
+        }
+
+        // if mapped to a logical column, convert from input units to internal units, and store the result
+        if (i != ERROR_NO_INDEX)
+        {
+            const ColumnInfo& col = _colv[i];
+            if (col.convPower != 1.) value = pow(value, col.convPower);
+            value *= (col.waveExponent ? pow(values[col.waveIndex], col.waveExponent) : col.convFactor);
+            values[i] = value;
+        }
+    }
+    return string();
+}
+
+////////////////////////////////////////////////////////////////////
+
+void TextInFile::startBulkReading()
+{
+    _bulkChecked = true;
+
+    // determine the number of bytes remaining in the text file
+    if (!_in.good() || !_numLogCols) return;
+    auto current = _in.tellg();
+    if (current < 0) return;
+    _in.seekg(0, std::ios_base::end);
+    auto size = _in.tellg();
+    _in.seekg(current);
+    if (size < 0 || static_cast<size_t>(size - current) < minBulkSize) return;
+
+    // acquire a memory map on the file; if this fails, we simply continue reading the text stream
+    auto map = System::acquireMemoryMap(_filePath);
+    if (!map.first) return;
+    if (map.second != static_cast<size_t>(size))
+    {
+        System::releaseMemoryMap(_filePath);
+        return;
+    }
+
+    _mapBegin = static_cast<const char*>(map.first);
+    _mapSize = map.second;
+    _mapPos = current;
+    _bulkActive = true;
+}
+
+////////////////////////////////////////////////////////////////////
+
+void TextInFile::parseBulkBlock()
+{
+    // split the next block of the file into chunks at line boundaries
+    size_t blockEnd = nextLineBoundary(_mapBegin, _mapSize, _mapPos + bulkBlockSize);
+    vector<size_t> boundaries{_mapPos};
+    while (boundaries.back() != blockEnd)
+        boundaries.push_back(nextLineBoundary(_mapBegin, blockEnd, boundaries.back() + bulkChunkSize));
+    size_t numChunks = boundaries.size() - 1;
+
+    // parse the chunks, each into its own buffer; each chunk stops parsing at its first improperly formatted line
+    vector<vector<double>> chunkValues(numChunks);
+    vector<string> chunkErrors(numChunks);
+    auto parseChunks = [this, &boundaries, &chunkValues, &chunkErrors](size_t firstIndex, size_t numIndices) {
+        Array values(_numLogCols);
+        for (size_t c = firstIndex; c != firstIndex + numIndices; ++c)
+        {
+            const char* pos = _mapBegin + boundaries[c];
+            const char* chunkEnd = _mapBegin + boundaries[c + 1];
+            while (pos != chunkEnd)
+            {
+                const char* eol = static_cast<const char*>(memchr(pos, '\n', chunkEnd - pos));
+                if (!eol) eol = chunkEnd;
+
+                // skip empty and comment lines
+                const char* first = pos;
+                while (first != eol && (*first == ' ' || *first == '\t')) ++first;
+                if (first != eol && *first != '#')
+                {
+                    string error = parseLine(pos, eol, values);
+                    if (!error.empty())
+                    {
+                        chunkErrors[c] = error;
+                        break;
+                    }
+                    chunkValues[c].insert(chunkValues[c].end(), std::begin(values), std::end(values));
+                }
+                pos = eol == chunkEnd ? chunkEnd : eol + 1;
+            }
+        }
+    };
+    if (numChunks > 1 && _parallelFactory && _parallelFactory->isParentThread())
+        _parallelFactory->parallelLocal()->call(numChunks, parseChunks);
+    else
+        parseChunks(0, numChunks);
+
+    // assemble the rows in their original order, up to and including the chunk with the first error, if any
+    _bulkValues.clear();
+    for (size_t c = 0; c != numChunks; ++c)
+    {
+        _bulkValues.insert(_bulkValues.end(), chunkValues[c].begin(), chunkValues[c].end());
+        chunkValues[c] = vector<double>();
+        if (!chunkErrors[c].empty())
+        {
+            _bulkError = chunkErrors[c];
+            break;
+        }
+    }
+    _bulkNumRows = _numLogCols ? _bulkValues.size() / _numLogCols : 0;
+    _bulkNextRow = 0;
+    _mapPos = blockEnd;
+}
+
+////////////////////////////////////////////////////////////////////
+
 vector<Array> TextInFile::readAllRows()
 {
     vector<Array> rows;
@@ -546,16 +794,50 @@ vector<Array> TextInFile::readAllRows()
 
 vector<Array> TextInFile::readAllColumns()
 {
-    // read the remainder of the file into rows
-    const vector<Array>& rows = readAllRows();
-    size_t nrows = rows.size();
+    if (!_hasProgInfo) throw FATALERROR("No columns were declared for column text file");
     size_t ncols = _colv.size();
 
-    // transpose the result into columns
-    vector<Array> columns(ncols, Array(nrows));
-    for (size_t c = 0; c != ncols; ++c)
-        for (size_t r = 0; r != nrows; ++r) columns[c][r] = rows[r][c];
+    // for a binary file, copy the values from the memory map and convert them to internal units column by column
+    if (_hasBinaryOpen)
+    {
+        size_t nrows = 0;
+        const double* rows = _scol.remainingRows(nrows);
+        size_t numPhysCols = _logColIndices.size();
+        vector<Array> columns(ncols, Array(nrows));
+        for (size_t j = 0; j != numPhysCols; ++j)  // j: zero-based physical index
+        {
+            size_t i = _logColIndices[j];  // i: zero-based logical index
+            if (i != ERROR_NO_INDEX)
+            {
+                // a specific quantity is always preceded by its wavelength column, which has thus been converted
+                const ColumnInfo& col = _colv[i];
+                Array& column = columns[i];
+                const double* value = rows + j;
+                for (size_t r = 0; r != nrows; ++r, value += numPhysCols) column[r] = *value;
+                if (col.convPower != 1.) column = pow(column, col.convPower);
+                if (col.waveExponent)
+                    column *= pow(columns[col.waveIndex], col.waveExponent);
+                else
+                    column *= col.convFactor;
+            }
+        }
+        return columns;
+    }
+
+    // for a text file, append the values for each row to the columns
+    vector<vector<double>> values(ncols);
+    Array row;
+    while (readRow(row))
+        for (size_t c = 0; c != ncols; ++c) values[c].push_back(row[c]);
 
+    // move the result into column arrays
+    vector<Array> columns(ncols);
+    for (size_t c = 0; c != ncols; ++c)
+    {
+        columns[c].resize(values[c].size());
+        std::copy(values[c].begin(), values[c].end(), begin(columns[c]));
+        values[c] = vector<double>();
+    }
     return columns;
 }
 
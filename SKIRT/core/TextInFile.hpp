@@ -11,6 +11,7 @@
 #include "StoredColumns.hpp"
 #include <fstream>
 class Log;
+class ParallelFactory;
 class SimulationItem;
 class Units;
 
@@ -83,6 +84,21 @@ class Units;
     If the input file provided to the TextInFile constructor has the \c .scol filename extension,
     the implementation automatically switches to reading the binary file format instead of the
     regular column text format. This is fully transparent to the caller of the TextInFile class.
+
+    Reading large text files
+    ------------------------
+
+    When the remaining portion of a column text file is sufficiently large at the time the first
+    data row is requested, this class switches to reading the file in bulk. It acquires a memory
+    map on the file, splits the next block of the file into chunks at line boundaries, and parses
+    these chunks in parallel using the available execution threads. The resulting rows are then
+    handed out in their original order by subsequent calls to the readRow() function. Floating
+    point values are parsed with a locale-independent function that returns exactly the same
+    values as the standard library. Unit conversions, and the detection and reporting of
+    formatting errors, are performed in exactly the same way in both reading modes. Specifically,
+    a formatting error is reported only when the client requests the offending row. Bulk reading
+    is disabled for files containing nonleaf lines, i.e. files read through the readNonLeaf()
+    function.
 */
 class TextInFile
 {
@@ -264,7 +280,11 @@ public:
     /** This function reads all rows from a column text file (from the current position until the
         end of the file), transposes the data repesentation from rows into columns, and returns the
         resulting values as a vector of column arrays. For each row, this function behaves just
-        like readRow(Array&). */
+        like readRow(Array&).
+
+        The values are stored directly in the column arrays, without first constructing an array
+        for each row. For a file in SKIRT stored columns format, the values are copied from the
+        memory-mapped file and converted to internal units column by column. */
     vector<Array> readAllColumns();
 
     /** This function reads all rows from a column text file (from the current position until the
@@ -312,6 +332,21 @@ private:
     }
     static inline void assignColumns(size_t /*index*/, vector<Array>& /*result*/) {}
 
+    /** This function parses the values on the text line with the specified begin and end pointers,
+        converts them to internal units, and stores them in the \em values array, which must have
+        the appropriate size. If the line does not contain the expected number of values or if a
+        value is improperly formatted, the function returns an error message. Otherwise it returns
+        the empty string. */
+    string parseLine(const char* begin, const char* end, Array& values) const;
+
+    /** This function determines whether the remainder of the text file should be read in bulk and,
+        if so, acquires a memory map on the file and prepares the data members for bulk reading. */
+    void startBulkReading();
+
+    /** This function parses the next block of the memory-mapped text file in parallel and stores
+        the resulting rows in the bulk row buffer. */
+    void parseBulkBlock();
+
     //======================== Data Members ========================
 
 private:
@@ -319,6 +354,19 @@ private:
     Log* _log{nullptr};      // the logger
     std::ifstream _in;       // the text input stream, if any
     StoredColumns _scol;     // the binary input file, if any
+    string _filePath;        // the path of the input file
+
+    // bulk reading of large text files
+    ParallelFactory* _parallelFactory{nullptr};  // the parallel factory used for parsing text in parallel, if any
+    bool _bulkChecked{false};                    // true if the need for bulk reading has been determined
+    bool _bulkActive{false};                     // true if the text file is being read in bulk
+    const char* _mapBegin{nullptr};              // pointer to the first character of the memory-mapped file
+    size_t _mapSize{0};                          // the size of the memory-mapped file in bytes
+    size_t _mapPos{0};                           // the offset of the first character that has not yet been parsed
+    vector<double> _bulkValues;                  // the converted values for the buffered rows, in row order
+    size_t _bulkNumRows{0};                      // the number of buffered rows
+    size_t _bulkNextRow{0};                      // the index of the next buffered row to be handed out
+    string _bulkError;                           // the error message for the line following the buffered rows, if any
 
     // private type to store column info
     class ColumnInfo
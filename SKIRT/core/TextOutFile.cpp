@@ -7,6 +7,8 @@
 #include "FatalError.hpp"
 #include "FilePaths.hpp"
 #include "Log.hpp"
+#include "Parallel.hpp"
+#include "ParallelFactory.hpp"
 #include "ProcessManager.hpp"
 #include "StringUtils.hpp"
 #include "System.hpp"
@@ -15,22 +17,81 @@
 
 ////////////////////////////////////////////////////////////////////
 
-TextOutFile::TextOutFile(const SimulationItem* item, string filename, string description)
+namespace
+{
+    // the alternate interpretations for 8-byte items in the stored columns format
+    union ScolItem
+    {
+        double doubleType;
+        size_t sizeType;
+        char stringType[8];
+    };
+    const size_t itemSize = sizeof(ScolItem);
+
+    static_assert((sizeof(size_t) == 8) & (sizeof(double) == 8) & (itemSize == 8),
+                  "Cannot properly declare union for items in stored columns format");
+
+    // the byte offset of the number of rows in the stored columns file header
+    const size_t numRowsOffset = 3 * itemSize;
+
+    // returns true if the specified string can be stored as a single item in the stored columns format
+    bool fitsStoredColumnItem(string value)
+    {
+        if (value.empty() || value.size() > itemSize) return false;
+        for (char c : value)
+            if (c <= ' ' || c > '~') return false;
+        return true;
+    }
+
+    // writes the specified string to the specified stream as a single item in the stored columns format
+    void writeStoredColumnItem(std::ofstream& out, string value)
+    {
+        value.resize(itemSize, ' ');
+        out.write(value.data(), itemSize);
+    }
+
+    // writes the specified size value to the specified stream as a single item in the stored columns format
+    void writeStoredColumnItem(std::ofstream& out, size_t value)
+    {
+        ScolItem item;
+        item.sizeType = value;
+        out.write(item.stringType, itemSize);
+    }
+
+    // the number of values in the row buffer that triggers writing the buffered rows to the file
+    const size_t rowBufferSize = 1 << 20;
+
+    // the number of rows converted to text in a single chunk by a single execution thread
+    const size_t rowsPerChunk = 1024;
+}
+
+////////////////////////////////////////////////////////////////////
+
+TextOutFile::TextOutFile(const SimulationItem* item, string filename, string description, bool binary)
 {
     // Only open the output file if this is the root process
     if (ProcessManager::isRoot())
     {
-        // open the file
-        string filepath = item->find<FilePaths>()->output(filename + ".dat");
-        _out = System::ofstream(filepath);
-        if (!_out) throw FATALERROR("Could not open the " + description + " output file " + filepath);
-
         // remember some pointers
         _log = item->find<Log>();
         _units = item->find<Units>();
+        _parallelFactory = item->find<ParallelFactory>(false);
+
+        // remember the message to be issued upon closing, except for the file path
+        _message = item->typeAndName() + " wrote " + description + " to ";
 
-        // remember the message to be issued upon closing
-        _message = item->typeAndName() + " wrote " + description + " to " + filepath;
+        // in binary mode, postpone opening the file until we know the column definitions
+        _pathWithoutExt = item->find<FilePaths>()->output(filename);
+        _description = description;
+        _binary = binary;
+        if (!_binary)
+        {
+            // open the file
+            string filepath = _pathWithoutExt + ".dat";
+            _out = System::ofstream(filepath);
+            if (!_out) throw FATALERROR("Could not open the " + description + " output file " + filepath);
+            _message += filepath;
+        }
     }
 }
 
@@ -38,8 +99,19 @@ TextOutFile::TextOutFile(const SimulationItem* item, string filename, string des
 
 void TextOutFile::close()
 {
+    // write any buffered rows; in binary mode, make sure that the file has been opened, even if there are no rows
+    flushRows();
+    if (_binary && !_binaryOpen) openBinary();
+
     if (_out.is_open())
     {
+        // in binary mode, write the end-of-file tag and the final number of rows
+        if (_binary)
+        {
+            _out.write("SCOLEND\n", itemSize);
+            _out.seekp(numRowsOffset);
+            writeStoredColumnItem(_out, _nrows);
+        }
         _out.close();
 
         // log success message, except if an exception has been thrown
@@ -63,6 +135,11 @@ void TextOutFile::addColumn(string quantityDescription, string unitDescription,
     _precisions.push_back(precision);
 
     if (unitDescription.empty()) unitDescription = "1";
+    if (_binary)
+    {
+        _descriptions.push_back(quantityDescription);
+        _unitStrings.push_back(unitDescription);
+    }
     writeLine("# column " + std::to_string(++_ncolumns) + ": " + quantityDescription + " (" + unitDescription + ")");
 }
 
@@ -72,7 +149,12 @@ void TextOutFile::writeLine(string line)
 {
     if (_out.is_open())
     {
-        _out << line << std::endl;
+        flushRows();
+        if (!_binary) _out << line << '\n';
+    }
+    else if (_binary)
+    {
+        _headerLines.push_back(line);
     }
 }
 
@@ -89,12 +171,115 @@ void TextOutFile::writeRowPrivate(size_t n, const double* values)
 {
     if (n != _ncolumns) throw FATALERROR("Number of values in row does not match the number of columns");
 
-    string line;
-    for (size_t i = 0; i < _ncolumns; i++)
+    if (_out.is_open() || _binary)
     {
-        line += (i ? " " : "") + StringUtils::toString(values[i], _formats[i], _precisions[i]);
+        _rowBuffer.insert(_rowBuffer.end(), values, values + n);
+        if (_rowBuffer.size() >= rowBufferSize) flushRows();
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+void TextOutFile::openBinary()
+{
+    // only the root process writes output
+    if (!ProcessManager::isRoot()) return;
+    _binaryOpen = true;
+
+    // determine the column names and verify that the names and units fit in the stored columns format
+    vector<string> names;
+    bool fits = true;
+    for (size_t i = 0; i != _ncolumns; ++i)
+    {
+        string name = StringUtils::squeeze(_descriptions[i]);
+        name.erase(std::remove_if(name.begin(), name.end(), [](char c) { return c <= ' '; }), name.end());
+        if (!fitsStoredColumnItem(name)) name = "col" + std::to_string(i + 1);
+        names.push_back(name);
+        if (!fitsStoredColumnItem(_unitStrings[i]))
+        {
+            _log->warning("Unit string '" + _unitStrings[i] + "' for " + _description
+                          + " does not fit the stored columns format; writing text file instead");
+            fits = false;
+            break;
+        }
+    }
+
+    // if the columns cannot be represented, write a regular text file including the buffered header lines
+    if (!fits)
+    {
+        _binary = false;
+        string filepath = _pathWithoutExt + ".dat";
+        _out = System::ofstream(filepath);
+        if (!_out) throw FATALERROR("Could not open the " + _description + " output file " + filepath);
+        _message += filepath;
+        for (const string& line : _headerLines) _out << line << '\n';
+        _headerLines.clear();
+        return;
     }
-    writeLine(line);
+
+    // open the stored columns file
+    string filepath = _pathWithoutExt + ".scol";
+    _out = System::ofstream(filepath, false, true);
+    if (!_out) throw FATALERROR("Could not open the " + _description + " output file " + filepath);
+    _message += filepath;
+    _headerLines.clear();
+
+    // write the header, with a placeholder for the number of rows
+    writeStoredColumnItem(_out, string("SKIRT X\n"));
+    writeStoredColumnItem(_out, static_cast<size_t>(0x010203040A0BFEFF));
+    writeStoredColumnItem(_out, static_cast<size_t>(0));
+    writeStoredColumnItem(_out, static_cast<size_t>(0));
+    writeStoredColumnItem(_out, _ncolumns);
+    for (const string& name : names) writeStoredColumnItem(_out, name);
+    for (const string& unit : _unitStrings) writeStoredColumnItem(_out, unit);
+}
+
+////////////////////////////////////////////////////////////////////
+
+void TextOutFile::flushRows()
+{
+    if (_rowBuffer.empty()) return;
+    if (_binary && !_binaryOpen) openBinary();
+    const double* values = _rowBuffer.data();
+    size_t numRows = _rowBuffer.size() / _ncolumns;
+
+    // in binary mode, simply copy the values to the file
+    if (_binary)
+    {
+        _out.write(reinterpret_cast<const char*>(values), numRows * _ncolumns * sizeof(double));
+        _nrows += numRows;
+        _rowBuffer.clear();
+        return;
+    }
+
+    // otherwise, convert the values to text in parallel, one chunk of rows at a time
+    size_t numChunks = (numRows + rowsPerChunk - 1) / rowsPerChunk;
+    vector<string> texts(numChunks);
+    auto convertChunks = [this, numRows, values, &texts](size_t firstIndex, size_t numIndices) {
+        for (size_t c = firstIndex; c != firstIndex + numIndices; ++c)
+        {
+            string& text = texts[c];
+            size_t endRow = min(numRows, (c + 1) * rowsPerChunk);
+            for (size_t r = c * rowsPerChunk; r != endRow; ++r)
+            {
+                const double* row = values + r * _ncolumns;
+                for (size_t i = 0; i < _ncolumns; i++)
+                {
+                    if (i) text += ' ';
+                    text += StringUtils::toString(row[i], _formats[i], _precisions[i]);
+                }
+                text += '\n';
+            }
+        }
+    };
+    if (numChunks > 1 && _parallelFactory && _parallelFactory->isParentThread())
+        _parallelFactory->parallelLocal()->call(numChunks, convertChunks);
+    else
+        convertChunks(0, numChunks);
+
+    // write the text in order
+    for (const string& text : texts) _out << text;
+    _rowBuffer.clear();
 }
 
 ////////////////////////////////////////////////////////////////////
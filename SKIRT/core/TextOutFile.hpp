@@ -11,6 +11,7 @@
 #include <array>
 #include <fstream>
 class Log;
+class ParallelFactory;
 class SimulationItem;
 class Units;
 
@@ -20,7 +21,29 @@ class Units;
     for formatting columns of floating point or integer numbers. Text is written per line, by
     calling the writeLine() or writeRow() functions. In a multiprocessing environment, only the
     root process will be allowed to write to the specified file; calls to writeLine() or writeRow()
-    performed by other processes will have no effect. */
+    performed by other processes will have no effect.
+
+    Large files
+    -----------
+
+    The rows passed to the writeRow() functions are buffered and converted to text in blocks,
+    using the available execution threads in parallel. This can substantially speed up the output
+    of large files, such as files with a row for each spatial cell. The buffered rows are written
+    to the file before any subsequent line passed to writeLine(), so that the order of the lines
+    in the file is preserved.
+
+    As an alternative, the client can request that the columns are written in the binary SKIRT
+    stored columns format (see the StoredColumns class) rather than as text, which avoids the
+    conversion to text altogether and produces a considerably smaller file. In this case, the
+    filename extension is ".scol" instead of ".dat". The column names in the stored columns file
+    are taken from the column descriptions with white space removed, or, if the result is longer
+    than eight characters, are set to "col" followed by the column number. The unit strings are
+    copied as is. Header lines other than the column descriptions are not written.
+
+    Because the stored columns format limits unit strings to eight characters, a stored columns
+    file cannot be written if one of the column units is longer (e.g., "W/m2/micron/sr"). In that
+    case, this class issues a warning and writes a regular text column file instead. Selecting a
+    different output unit style for the simulation often resolves the issue. */
 class TextOutFile
 {
     //=============== Construction - Destruction  ==================
@@ -34,8 +57,10 @@ public:
         to retrieve the output file path and an appropriate logger, and to determine whether this
         is the root process; (2) \em filename specifies the name of the file, excluding path,
         simulation prefix and filename extension; (3) \em description describes the contents of the
-        file for use in the log message issued after the file is successfully closed. */
-    TextOutFile(const SimulationItem* item, string filename, string description);
+        file for use in the log message issued after the file is successfully closed; (4) \em
+        binary specifies whether to write the columns in the binary stored columns format rather
+        than as text, as described in the class header. */
+    TextOutFile(const SimulationItem* item, string filename, string description, bool binary = false);
 
     /** In the root process, this function closes the file and logs an informational message, if
         the file was not already closed. It is important to call close() or allow the object to go
@@ -87,6 +112,17 @@ private:
         template writeRow() functions. */
     void writeRowPrivate(size_t n, const double* values);
 
+    /** This function writes the rows in the row buffer to the file and clears the buffer. In text
+        mode, the values are formatted according to the 'format' and 'precision' specified by the
+        addColumn function, converting chunks of rows to text in parallel. */
+    void flushRows();
+
+    /** In binary mode, this function opens the output file and writes the header, if this has not
+        yet been done. If the columns cannot be represented in the stored columns format, the
+        function logs a warning, opens a text file instead, and writes the buffered header lines.
+        */
+    void openBinary();
+
     //======================== Data Members ========================
 
 protected:
@@ -99,6 +135,18 @@ private:
     size_t _ncolumns{0};
     vector<char> _formats;
     vector<int> _precisions;
+    vector<double> _rowBuffer;                   // the values for the rows that have not yet been written
+    ParallelFactory* _parallelFactory{nullptr};  // for converting values to text in parallel
+
+    // used for writing stored columns format
+    bool _binary{false};           // true if writing or about to write stored columns format
+    bool _binaryOpen{false};       // true if the stored columns file has been opened
+    string _pathWithoutExt;        // the output file path without filename extension
+    string _description;           // the description of the file contents
+    vector<string> _headerLines;   // the header lines written so far, in case we need to fall back to text
+    vector<string> _descriptions;  // the column descriptions
+    vector<string> _unitStrings;   // the column unit strings
+    size_t _nrows{0};              // the number of rows written so far
 
     // used when closing
     Log* _log{nullptr};  // the logger
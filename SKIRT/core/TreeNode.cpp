@@ -207,3 +207,136 @@ void TreeNode::sortNeighbors()
 }
 
 ////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    // the wall on the other side of the given wall, i.e. the wall of a neighbor that touches the given wall
+    const TreeNode::Wall complementingWall[] = {TreeNode::FRONT, TreeNode::BACK, TreeNode::RIGHT,
+                                                TreeNode::LEFT,  TreeNode::TOP,  TreeNode::BOTTOM};
+
+    // returns the coordinate of the specified wall of the given box
+    double wallCoordinate(const Box& box, TreeNode::Wall wall)
+    {
+        switch (wall)
+        {
+            case TreeNode::BACK: return box.xmin();
+            case TreeNode::FRONT: return box.xmax();
+            case TreeNode::LEFT: return box.ymin();
+            case TreeNode::RIGHT: return box.ymax();
+            case TreeNode::BOTTOM: return box.zmin();
+            case TreeNode::TOP: return box.zmax();
+        }
+        return 0.;
+    }
+
+    // returns true if the faces of the two boxes parallel to the specified wall overlap when projected on that wall;
+    // if strict is false, faces that touch only along an edge or in a corner are considered to overlap as well
+    bool facesOverlap(const Box& box1, const Box& box2, TreeNode::Wall wall, bool strict)
+    {
+        auto overlap = [strict](double min1, double max1, double min2, double max2) {
+            return strict ? (min1 < max2 && min2 < max1) : (min1 <= max2 && min2 <= max1);
+        };
+        switch (wall)
+        {
+            case TreeNode::BACK:
+            case TreeNode::FRONT:
+                return overlap(box1.ymin(), box1.ymax(), box2.ymin(), box2.ymax())
+                       && overlap(box1.zmin(), box1.zmax(), box2.zmin(), box2.zmax());
+            case TreeNode::LEFT:
+            case TreeNode::RIGHT:
+                return overlap(box1.xmin(), box1.xmax(), box2.xmin(), box2.xmax())
+                       && overlap(box1.zmin(), box1.zmax(), box2.zmin(), box2.zmax());
+            case TreeNode::BOTTOM:
+            case TreeNode::TOP:
+                return overlap(box1.xmin(), box1.xmax(), box2.xmin(), box2.xmax())
+                       && overlap(box1.ymin(), box1.ymax(), box2.ymin(), box2.ymax());
+        }
+        return false;
+    }
+
+    // adds the children of the specified subdivided neighbor that are adjacent to the given box at the specified wall
+    void addAdjacentChildren(vector<TreeNode*>& neighbors, const Box& box, TreeNode::Wall wall,
+                             const TreeNode* neighbor)
+    {
+        // the children touching the given box share the neighbor's complementing wall
+        TreeNode::Wall other = complementingWall[wall];
+        double coord = wallCoordinate(*neighbor, other);
+        for (TreeNode* child : neighbor->children())
+        {
+            if (wallCoordinate(*child, other) == coord && facesOverlap(box, *child, wall, false))
+                neighbors.push_back(child);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+void TreeNode::addChildNeighbors()
+{
+    for (TreeNode* child : _children)
+    {
+        for (int w = 0; w != 6; ++w)
+        {
+            Wall wall = static_cast<Wall>(w);
+            double coord = wallCoordinate(*child, wall);
+            auto& neighbors = child->_neighbors[wall];
+
+            // internal neighbors: siblings sharing part of this wall (touching along an edge is not sufficient)
+            for (TreeNode* sibling : _children)
+            {
+                if (sibling != child && wallCoordinate(*sibling, complementingWall[wall]) == coord
+                    && facesOverlap(*child, *sibling, wall, true))
+                    neighbors.push_back(sibling);
+            }
+
+            // external neighbors: only for children with a wall that lies on the corresponding wall of this node;
+            // the neighbors of this node at that wall, or their children if they have been subdivided as well
+            if (coord == wallCoordinate(*this, wall))
+            {
+                for (TreeNode* neighbor : _neighbors[wall])
+                {
+                    if (neighbor->isChildless())
+                    {
+                        if (facesOverlap(*child, *neighbor, wall, false)) neighbors.push_back(neighbor);
+                    }
+                    else
+                    {
+                        addAdjacentChildren(neighbors, *child, wall, neighbor);
+                    }
+                }
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+const TreeNode* TreeNode::firstSubdividedNeighbor() const
+{
+    for (const auto& neighbors : _neighbors)
+        for (const TreeNode* neighbor : neighbors)
+            if (!neighbor->isChildless()) return neighbor;
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////
+
+void TreeNode::replaceSubdividedNeighbors()
+{
+    for (int w = 0; w != 6; ++w)
+    {
+        Wall wall = static_cast<Wall>(w);
+        vector<TreeNode*> neighbors;
+        neighbors.reserve(_neighbors[wall].size());
+        for (TreeNode* neighbor : _neighbors[wall])
+        {
+            if (neighbor->isChildless())
+                neighbors.push_back(neighbor);
+            else
+                addAdjacentChildren(neighbors, *this, wall, neighbor);
+        }
+        _neighbors[wall].swap(neighbors);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
@@ -91,6 +91,10 @@ public:
         */
     virtual void createChildren(int id) = 0;
 
+    /** This function returns the number of children created by the createChildren() function.
+        This number is fixed for each subclass (e.g. 2 for binary tree, 8 for octtree). */
+    virtual int numChildren() const = 0;
+
 protected:
     /** This function adds the specified child to the end of the child list. */
     void addChild(TreeNode* child);
@@ -138,6 +142,37 @@ public:
         have been added for all nodes in the tree. */
     void sortNeighbors();
 
+    //============= Managing neighbors for parallel subdivision =============
+
+public:
+    /** This function initializes the neighbor lists of the children of this node, which must
+        just have been created by calling createChildren(). It serves the same purpose as the
+        addNeighbors() function, but it is intended for a level-synchronous subdivision procedure
+        where all nodes at a given level in the tree are subdivided simultaneously. In contrast to
+        addNeighbors(), this function modifies only the children of this node. It reads the
+        neighbor lists of this node and, for neighbors that have been subdivided as well, the
+        children of those neighbors. As a result, the function can be safely invoked in parallel
+        for all nodes that have been subdivided at a given level, after all of these nodes have
+        received their children.
+
+        Rather than relying on a fixed subdivision scheme, the function determines the neighbors
+        geometrically, using the same (inclusive) adjacency criteria as addNeighbors(). */
+    void addChildNeighbors();
+
+    /** This function returns a pointer to the first neighbor of this node that has children, or
+        null if there is no such neighbor. During a level-synchronous subdivision, the neighbor
+        lists of a childless node contain only childless nodes, except for neighbors that have
+        just been subdivided. The returned node can thus be used to uniquely assign the task of
+        updating the neighbor lists of this node to one of the nodes being subdivided. */
+    const TreeNode* firstSubdividedNeighbor() const;
+
+    /** This function replaces each neighbor of this node that has just been subdivided by those
+        of its children that are adjacent to this node. It is intended to be called for childless
+        nodes as the last step of a level-synchronous subdivision, after addChildNeighbors() has
+        been called for all subdivided nodes. The function modifies only the neighbor lists of this
+        node, so that it can be safely invoked in parallel for different nodes. */
+    void replaceSubdividedNeighbors();
+
     //============= Data members =============
 
 private:
@@ -4,7 +4,12 @@
 ///////////////////////////////////////////////////////////////// */
 
 #include "TreeSpatialGrid.hpp"
+#include "BinTreeNode.hpp"
+#include "BinaryCache.hpp"
+#include "FatalError.hpp"
 #include "Log.hpp"
+#include "MediumSystem.hpp"
+#include "OctTreeNode.hpp"
 #include "PathSegmentGenerator.hpp"
 #include "Random.hpp"
 #include "SpatialGridPlotFile.hpp"
@@ -27,10 +32,31 @@ void TreeSpatialGrid::setupSelfAfter()
     // determine a small fraction relative to the spatial extent of the grid; used during path traversal
     _eps = 1e-12 * extent().diagonal();
 
-    // make subclass construct the tree
+    // make subclass construct the tree, or load the tree from a cache file if requested and available
     Log* log = find<Log>();
-    log->info("Constructing the spatial tree grid...");
-    _nodev = constructTree();
+    if (cacheGrid())
+    {
+        // the tree depends on the medium system (including this grid) and, for some policies, on the random seed;
+        // the medium system is not necessarily our parent, e.g. when this grid is part of a composite grid
+        BinaryCache cache(this, "tree");
+        cache.addKey(find<MediumSystem>());
+        cache.addKey(find<Random>());
+        if (cache.load())
+        {
+            _nodev = deserializeTree(cache.data(), cache.size());
+        }
+        else
+        {
+            log->info("Constructing the spatial tree grid...");
+            _nodev = constructTree();
+            cache.store(serializeTree());
+        }
+    }
+    else
+    {
+        log->info("Constructing the spatial tree grid...");
+        _nodev = constructTree();
+    }
 
     // construct the vectors to help translating between node indices (leaf and nonleaf) and cell indices (leaf only)
     //  _cellindexv : cell index m corresponding to each node in nodev; -1 for nonleaf nodes
@@ -215,6 +241,20 @@ std::unique_ptr<PathSegmentGenerator> TreeSpatialGrid::createPathSegmentGenerato
 
 ////////////////////////////////////////////////////////////////////
 
+bool TreeSpatialGrid::hasCuboidalCells() const
+{
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////
+
+Box TreeSpatialGrid::cellBox(int m) const
+{
+    return nodeForCellIndex(m)->extent();
+}
+
+////////////////////////////////////////////////////////////////////
+
 namespace
 {
     // this function writes a "0" for a leaf node or a "1" for a nonleaf node
@@ -351,3 +391,103 @@ int TreeSpatialGrid::cellIndexForNode(const TreeNode* node) const
 }
 
 ////////////////////////////////////////////////////////////////////
+
+vector<double> TreeSpatialGrid::serializeTree() const
+{
+    vector<double> data;
+    data.push_back(root()->numChildren());
+    data.push_back(_nodev.size());
+    for (auto node : _nodev)
+    {
+        data.push_back(node->isChildless() ? 0 : node->children()[0]->id());
+        for (int wall = 0; wall != 6; ++wall)
+        {
+            const vector<TreeNode*>& neighbors = node->neighbors(static_cast<TreeNode::Wall>(wall));
+            data.push_back(neighbors.size());
+            for (auto neighbor : neighbors) data.push_back(neighbor->id());
+        }
+    }
+    return data;
+}
+
+////////////////////////////////////////////////////////////////////
+
+vector<TreeNode*> TreeSpatialGrid::deserializeTree(const double* data, size_t size) const
+{
+    const double* end = data + size;
+    if (size < 2) throw FATALERROR("Tree grid cache file has improper format");
+
+    // create the root node using the appropriate type
+    TreeNode* root = nullptr;
+    int numChildren = static_cast<int>(*data++);
+    switch (numChildren)
+    {
+        case 8: root = new OctTreeNode(extent()); break;
+        case 2: root = new BinTreeNode(extent()); break;
+        default: throw FATALERROR("Tree grid cache file specifies unsupported number of children");
+    }
+    double numNodesValue = *data++;
+    if (!(numNodesValue >= 1. && numNodesValue <= static_cast<double>(size)))
+    {
+        delete root;
+        throw FATALERROR("Tree grid cache file has improper format");
+    }
+    size_t numNodes = static_cast<size_t>(numNodesValue);
+    vector<TreeNode*> nodev(numNodes, nullptr);
+    nodev[0] = root;
+
+    // delete the nodes created so far and report an error; the file contents can't be trusted beyond
+    // its format, so every index read from the file is verified before it is used
+    auto fail = [&nodev]() {
+        for (auto node : nodev) delete node;
+        return FATALERROR("Tree grid cache file has improper format");
+    };
+    auto validIndex = [numNodes](double value) { return value >= 0. && value < static_cast<double>(numNodes); };
+
+    // recreate the nodes; because children always have a larger ID than their parent,
+    // each node already exists by the time we encounter the information on its children
+    const double* cursor = data;
+    for (size_t l = 0; l != numNodes; ++l)
+    {
+        if (cursor >= end || !nodev[l]) throw fail();
+        double firstChild = *cursor++;
+        if (firstChild)
+        {
+            if (!(firstChild > l && validIndex(firstChild + numChildren - 1))) throw fail();
+            size_t first = static_cast<size_t>(firstChild);
+            for (int c = 0; c != numChildren; ++c)
+                if (nodev[first + c]) throw fail();
+
+            TreeNode* node = nodev[l];
+            node->createChildren(static_cast<int>(first));
+            for (auto child : node->children()) nodev[child->id()] = child;
+        }
+        for (int wall = 0; wall != 6; ++wall)
+        {
+            if (cursor >= end || !(*cursor >= 0. && *cursor < end - cursor)) throw fail();
+            cursor += 1 + static_cast<size_t>(*cursor);
+        }
+    }
+
+    // copy the neighbor lists, which have been sorted before they were stored;
+    // the first pass verified the list sizes, so we only need to verify the neighbor IDs
+    cursor = data;
+    for (size_t l = 0; l != numNodes; ++l)
+    {
+        TreeNode* node = nodev[l];
+        cursor++;  // skip the first child ID
+        for (int wall = 0; wall != 6; ++wall)
+        {
+            size_t numNeighbors = *cursor++;
+            for (size_t i = 0; i != numNeighbors; ++i)
+            {
+                double neighbor = *cursor++;
+                if (!validIndex(neighbor) || static_cast<size_t>(neighbor) == l) throw fail();
+                node->addNeighbor(static_cast<TreeNode::Wall>(wall), nodev[static_cast<size_t>(neighbor)]);
+            }
+        }
+    }
+    return nodev;
+}
+
+////////////////////////////////////////////////////////////////////
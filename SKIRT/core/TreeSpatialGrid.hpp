@@ -23,10 +23,25 @@ class TreeNode;
     using the grid, such as calculating paths traversing the grid. Depending on the type of
     TreeNode, the tree can become an octtree (8 children per node) or a binary tree (2 children per
     node). Other node types could be implemented, as long as they are cuboids lined up with the
-    coordinate axes. */
+    coordinate axes.
+
+    Constructing a large tree can take a substantial amount of time. If the \em cacheGrid flag is
+    enabled, this class stores the constructed tree, including the neighbor lists for all nodes, in
+    a binary cache file in the output directory (see the BinaryCache class). A subsequent
+    simulation with the same configuration loads the tree from this file instead of constructing
+    it again. The cache file is identified by a fingerprint calculated from the configuration of
+    the medium system (including the configuration of this grid and the contents of any input
+    files) and of the random generator. Because loading the tree from the cache file does not
+    consume any random numbers, the results of such a simulation may differ from those of the
+    original simulation within the statistical noise. */
 class TreeSpatialGrid : public BoxSpatialGrid
 {
     ITEM_ABSTRACT(TreeSpatialGrid, BoxSpatialGrid, "a hierarchical tree spatial grid")
+
+        PROPERTY_BOOL(cacheGrid, "cache the constructed tree for use by subsequent simulations")
+        ATTRIBUTE_DEFAULT_VALUE(cacheGrid, "false")
+        ATTRIBUTE_DISPLAYED_IF(cacheGrid, "Level3")
+
     ITEM_END()
 
     //============= Construction - Setup - Destruction =============
@@ -47,7 +62,12 @@ protected:
         cells. Conversely, the function also creates a vector with the cell indices of all the
         nodes, i.e. the rank \f$m\f$ of the node in the ID vector if the node is a leaf, and the
         number -1 if the node is not a leaf (and hence not a spatial cell). Finally, the function
-        logs some details on the number of cells in the tree. */
+        logs some details on the number of cells in the tree.
+
+        If the \em cacheGrid flag is enabled and a cache file with the appropriate fingerprint
+        exists, the function reconstructs the tree from the information in the cache file rather
+        than invoking the constructTree() function. If no such cache file exists, the function
+        invokes constructTree() as usual and stores the resulting tree in a new cache file. */
     void setupSelfAfter() override;
 
     /** This function must be implemented in a subclass. It constructs the hierarchical tree and
@@ -124,6 +144,14 @@ public:
         neighbor lists constructed for each tree node during setup. */
     std::unique_ptr<PathSegmentGenerator> createPathSegmentGenerator() const override;
 
+    /** This function returns true because all cells in a tree grid are cuboids lined up with the
+        coordinate axes. */
+    bool hasCuboidalCells() const override;
+
+    /** This function returns the extent of the cell with index \f$m\f$ as a Box object. For a
+        tree grid, this is the extent of the leaf node corresponding to the cell. */
+    Box cellBox(int m) const override;
+
     /** This function writes the topology of the tree to the specified text file in a simple,
         proprietary format. After a brief descriptive header, it writes lines that each contain
         just a single integer number. The first line specifies the number of children for each
@@ -165,6 +193,21 @@ private:
         cell index vector. */
     int cellIndexForNode(const TreeNode* node) const;
 
+    /** This function serializes the tree into a list of values suitable for storing in a binary
+        cache file. The list contains the number of children for each nonleaf node and the number
+        of nodes in the tree, followed by the following information for each node in order of node
+        ID: the ID of the node's first child (or zero if the node is a leaf) and, for each of the
+        six walls, the number of neighbors followed by their IDs. */
+    vector<double> serializeTree() const;
+
+    /** This function reconstructs the tree from the specified list of serialized values, as
+        produced by the serializeTree() function, and returns a list of pointers to all created
+        nodes in order of node ID. Because the neighbor lists are copied from the serialized
+        information, the relatively expensive neighbor calculations are avoided. All node IDs and
+        list sizes are verified before they are used, so that a damaged cache file causes a fatal
+        error rather than undefined behavior. */
+    vector<TreeNode*> deserializeTree(const double* data, size_t size) const;
+
     //======================== Data Members ========================
 
 private:
@@ -16,6 +16,17 @@ double UniformSmoothingKernel::density(double u) const
 
 //////////////////////////////////////////////////////////////////////
 
+void UniformSmoothingKernel::densities(const double* uv, double* Wv, int n) const
+{
+    for (int i = 0; i != n; ++i)
+    {
+        double u = uv[i];
+        Wv[i] = (u < 0.0 || u > 1.0) ? 0.0 : 0.75 / M_PI;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+
 double UniformSmoothingKernel::columnDensity(double q) const
 {
     if (q < 0.0 || q >= 1.0) return 0.0;
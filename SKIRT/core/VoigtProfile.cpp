@@ -9,7 +9,7 @@
 
 ////////////////////////////////////////////////////////////////////
 
-double VoigtProfile::value(double a, double x)
+namespace
 {
     // coefficients for the approximation function (Table A1, Smith+15)
     constexpr double A0 = 15.75328153963877;
@@ -29,11 +29,86 @@ double VoigtProfile::value(double a, double x)
     constexpr double B7 = 23.7489999060;
     constexpr double B8 = 1.82106170570;
 
+    // the terms of the approximation that depend on z = x^2 in the core (z <= 3), in the intermediate range
+    // (3 < z < 25), and in the wings (z >= 25) of the profile (Appendix A1, Smith+15)
+    inline double coreTerm(double z)
+    {
+        return A0 + A1 / (z - A2 + A3 / (z - A4 + A5 / (z - A6)));
+    }
+    inline double intermediateTerm(double z)
+    {
+        return B0 + B1 / (z - B2 + B3 / (z + B4 + B5 / (z - B6 + B7 / (z - B8))));
+    }
+    inline double wingValue(double a, double z)
+    {
+        return 0.5 * M_2_SQRTPI * a / (z - 1.5 - 1.5 / (z - 3.5 - 5.0 / (z - 5.5)));
+    }
+
+    // the number of table bins per unit of z = x^2, and the upper limit of the tabulated range in z
+    constexpr int numBinsPerUnit = 256;
+    constexpr int zmaxTable = 25;
+
+    // an instance of this class holds a table of the coefficients c0(z) and c1(z) for which H(a,x) = c0(z) + a c1(z)
+    // according to the Smith+15 approximation, with z = x^2; for each bin, the table lists the value at the left
+    // border and the difference between the right and left borders for both coefficients, evaluating the
+    // approximation for the range that contains the bin, so that the bin borders align with the range borders
+    class VoigtTable
+    {
+    public:
+        VoigtTable() : _coeffv(4 * numBinsPerUnit * zmaxTable)
+        {
+            for (int i = 0; i != numBinsPerUnit * zmaxTable; ++i)
+            {
+                double zl = static_cast<double>(i) / numBinsPerUnit;
+                double zr = static_cast<double>(i + 1) / numBinsPerUnit;
+                bool core = zr <= 3.0;
+                double c0l = exp(-zl);
+                double c0r = exp(-zr);
+                double c1l = core ? -c0l * coreTerm(zl) : intermediateTerm(zl);
+                double c1r = core ? -c0r * coreTerm(zr) : intermediateTerm(zr);
+                double* c = &_coeffv[4 * i];
+                c[0] = c0l;
+                c[1] = c0r - c0l;
+                c[2] = c1l;
+                c[3] = c1r - c1l;
+            }
+        }
+
+        // returns the interpolated value of the Voigt function for the given a and z = x^2 < zmaxTable
+        double value(double a, double z) const
+        {
+            double t = z * numBinsPerUnit;
+            size_t i = static_cast<size_t>(t);
+            double f = t - i;
+            const double* c = &_coeffv[4 * i];
+            return c[0] + f * c[1] + a * (c[2] + f * c[3]);
+        }
+
+    private:
+        vector<double> _coeffv;
+    };
+}
+
+////////////////////////////////////////////////////////////////////
+
+double VoigtProfile::value(double a, double x)
+{
     // calculation of the approximation (Appendix A1, Smith+15)
     double z = x * x;
-    if (z <= 3.0) return exp(-z) * (1.0 - a * (A0 + A1 / (z - A2 + A3 / (z - A4 + A5 / (z - A6)))));
-    if (z < 25.0) return exp(-z) + a * (B0 + B1 / (z - B2 + B3 / (z + B4 + B5 / (z - B6 + B7 / (z - B8)))));
-    return 0.5 * M_2_SQRTPI * a / (z - 1.5 - 1.5 / (z - 3.5 - 5.0 / (z - 5.5)));
+    if (z <= 3.0) return exp(-z) * (1.0 - a * coreTerm(z));
+    if (z < 25.0) return exp(-z) + a * intermediateTerm(z);
+    return wingValue(a, z);
+}
+
+////////////////////////////////////////////////////////////////////
+
+double VoigtProfile::tabulatedValue(double a, double x)
+{
+    static const VoigtTable table;
+
+    double z = x * x;
+    if (z < zmaxTable) return table.value(a, z);
+    return wingValue(a, z);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -39,6 +39,24 @@ namespace VoigtProfile
         values of \f$a\f$, i.e. for higher gas temperatures. */
     double value(double a, double x);
 
+    /** This function returns an approximation to the value of the Voigt function \f$H(a,x)\f$
+        obtained through interpolation in a precalculated table. It reproduces the approximation
+        offered by the value() function to within a relative error of \f$2\times10^{-6}\f$ for
+        \f$a\le 0.03\f$, which is negligible compared to the accuracy of the approximation itself.
+
+        For a given value of \f$z=x^2\f$, the approximation used by the value() function can be
+        written as \f$H(a,x) = c_0(z) + a\,c_1(z)\f$, with \f$c_0(z) = \mathrm{e}^{-z}\f$ in
+        the core and intermediate ranges, and \f$c_0(z) = 0\f$ in the wings. Because the
+        dependency on \f$a\f$ is linear, there is no need for a two-dimensional table in
+        \f$a\f$ and \f$x\f$. Instead, the coefficients \f$c_0\f$ and \f$c_1\f$ are tabulated
+        on a uniform grid in \f$z\f$ with 256 bins per unit, up to the start of the wings at
+        \f$z=25\f$, and the function interpolates linearly in each of these coefficients. The
+        table borders between the core and the intermediate range coincide with a bin border,
+        so that the discontinuity of the approximation at that point is preserved. In the wings,
+        the function evaluates the approximation directly, because it does not involve an
+        exponential. The table is constructed when the function is first called. */
+    double tabulatedValue(double a, double x);
+
     /** This function samples a random value from the probability distribution \f$P(u)\f$ defined
         by \f[ P(u) \propto \frac{\mathrm{e}^{-u^2}}{(u-x)^2+a^2} \f] where \f$a\f$ and \f$x\f$ are
         parameters given as arguments and the proportionality factor is determined by
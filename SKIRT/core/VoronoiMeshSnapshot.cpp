@@ -4,6 +4,7 @@
 ///////////////////////////////////////////////////////////////// */
 
 #include "VoronoiMeshSnapshot.hpp"
+#include "BinaryCache.hpp"
 #include "EntityCollection.hpp"
 #include "FatalError.hpp"
 #include "Log.hpp"
@@ -27,7 +28,8 @@
 namespace
 {
     // classes used for serializing/deserializing Voronoi cell geometry when communicating the results of
-    // grid construction between multiple processes with the ProcessManager::broadcastAllToAll() function
+    // grid construction between multiple processes with the ProcessManager::broadcastAllToAll() function,
+    // and when storing these results in a binary cache file
 
     // decorates a std::vector with functions to write serialized versions of various data types
     class SerializedWrite
@@ -56,6 +58,7 @@ namespace
 
     public:
         SerializedRead(const vector<double>& data) : _data(data.data()), _end(data.data() + data.size()) {}
+        SerializedRead(const double* data, size_t size) : _data(data), _end(data + size) {}
         bool empty() { return _data == _end; }
         int readInt() { return *_data++; }
         void read(double& v) { v = *_data++; }
@@ -89,15 +92,15 @@ private:
     Vec _c;                  // centroid position
     double _volume{0.};      // volume
     vector<int> _neighbors;  // list of neighbor indices in _cells vector
-    Array _properties;       // user-defined properties, if any
+    int _index{-1};          // index of the imported site in the property columns, if any
 
 public:
     // constructor stores the specified site position; the other data members are set to zero or empty
     Cell(Vec r) : _r(r) {}
 
-    // constructor derives the site position from the first three property values and stores the user properties;
+    // constructor stores the specified site position and the index of the imported site in the property columns;
     // the other data members are set to zero or empty
-    Cell(const Array& prop) : _r(prop[0], prop[1], prop[2]), _properties{prop} {}
+    Cell(Vec r, int index) : _r(r), _index(index) {}
 
     // adjusts the site position with the specified offset
     void relax(double cx, double cy, double cz) { _r += Vec(cx, cy, cz); }
@@ -166,8 +169,8 @@ public:
     // returns a list of neighboring cell/site ids
     const vector<int>& neighbors() { return _neighbors; }
 
-    // returns the cell/site user properties, if any
-    const Array& properties() { return _properties; }
+    // returns the index of the imported site in the property columns, or -1 if the site was not imported
+    int index() const { return _index; }
 
     // writes the Voronoi cell geometry to the serialized data buffer, preceded by the specified cell index,
     // if the cell geometry has been calculated for this cell; otherwise does nothing
@@ -361,9 +364,12 @@ VoronoiMeshSnapshot::~VoronoiMeshSnapshot()
 
 void VoronoiMeshSnapshot::readAndClose()
 {
-    // read the site info into memory
-    Array prop;
-    while (infile()->readRow(prop)) _cells.push_back(new Cell(prop));
+    // read the site info into memory, storing the properties column by column; the cells refer to the imported
+    // properties by index so that removing sites does not require copying the properties
+    _colv = infile()->readAllColumns();
+    int numSites = _colv.empty() ? 0 : _colv[0].size();
+    _cells.reserve(numSites);
+    for (int m = 0; m != numSites; ++m) _cells.push_back(new Cell(Vec(_colv[0][m], _colv[1][m], _colv[2][m]), m));
 
     // close the file
     close();
@@ -405,7 +411,8 @@ void VoronoiMeshSnapshot::foregoVoronoiMesh()
 
 ////////////////////////////////////////////////////////////////////
 
-VoronoiMeshSnapshot::VoronoiMeshSnapshot(const SimulationItem* item, const Box& extent, string filename, bool relax)
+VoronoiMeshSnapshot::VoronoiMeshSnapshot(const SimulationItem* item, const Box& extent, string filename, bool relax,
+                                         bool cache)
 {
     // read the input file
     TextInFile in(item, filename, "Voronoi sites");
@@ -419,14 +426,17 @@ VoronoiMeshSnapshot::VoronoiMeshSnapshot(const SimulationItem* item, const Box&
     // calculate the Voronoi cells
     setContext(item);
     setExtent(extent);
-    buildMesh(relax);
+    if (cache)
+        buildMeshCached(item, relax);
+    else
+        buildMesh(relax);
     buildSearchPerBlock();
 }
 
 ////////////////////////////////////////////////////////////////////
 
 VoronoiMeshSnapshot::VoronoiMeshSnapshot(const SimulationItem* item, const Box& extent, SiteListInterface* sli,
-                                         bool relax)
+                                         bool relax, bool cache)
 {
     // prepare the data
     int n = sli->numSites();
@@ -436,14 +446,17 @@ VoronoiMeshSnapshot::VoronoiMeshSnapshot(const SimulationItem* item, const Box&
     // calculate the Voronoi cells
     setContext(item);
     setExtent(extent);
-    buildMesh(relax);
+    if (cache)
+        buildMeshCached(item, relax);
+    else
+        buildMesh(relax);
     buildSearchPerBlock();
 }
 
 ////////////////////////////////////////////////////////////////////
 
 VoronoiMeshSnapshot::VoronoiMeshSnapshot(const SimulationItem* item, const Box& extent, const vector<Vec>& sites,
-                                         bool relax)
+                                         bool relax, bool cache)
 {
     // prepare the data
     int n = sites.size();
@@ -453,7 +466,10 @@ VoronoiMeshSnapshot::VoronoiMeshSnapshot(const SimulationItem* item, const Box&
     // calculate the Voronoi cells
     setContext(item);
     setExtent(extent);
-    buildMesh(relax);
+    if (cache)
+        buildMeshCached(item, relax);
+    else
+        buildMesh(relax);
     buildSearchPerBlock();
 }
 
@@ -731,13 +747,71 @@ void VoronoiMeshSnapshot::buildMesh(bool relax)
 
 ////////////////////////////////////////////////////////////////////
 
+void VoronoiMeshSnapshot::buildMeshCached(const SimulationItem* item, bool relax)
+{
+    // the tessellation depends only on the domain, the relaxation flag, and the original site positions;
+    // the cached data holds the number of retained sites, the retained site positions, and the geometry for each
+    // cell for which it has been calculated, preceded by the cell index (as communicated between processes)
+    BinaryCache cache(item, "voronoi", 2);
+    for (double v : {_extent.xmin(), _extent.ymin(), _extent.zmin(), _extent.xmax(), _extent.ymax(), _extent.zmax()})
+        cache.addKey(v);
+    cache.addKey(relax);
+    cache.addKey(_cells.size());
+    for (auto cell : _cells)
+    {
+        Vec r = cell->position();
+        cache.addKey(r.x());
+        cache.addKey(r.y());
+        cache.addKey(r.z());
+    }
+
+    // if the cache file is available, replace the original sites by the retained sites and their cell geometry
+    if (cache.load())
+    {
+        for (auto cell : _cells) delete cell;
+        _cells.clear();
+
+        SerializedRead rdata(cache.data(), cache.size());
+        int numCells = rdata.readInt();
+        for (int m = 0; m != numCells; ++m)
+        {
+            Vec r;
+            rdata.read(r);
+            _cells.push_back(new Cell(r));
+        }
+        while (!rdata.empty()) _cells[rdata.readInt()]->readGeometry(rdata);
+
+        // calculate the number of search blocks in each direction as in buildMesh()
+        _nb = max(3, min(250, static_cast<int>(cbrt(numCells))));
+        _nb2 = _nb * _nb;
+        _nb3 = _nb * _nb * _nb;
+        log()->info("  Number of Voronoi cells: " + std::to_string(numCells));
+    }
+
+    // otherwise, build the tessellation and store it in the cache
+    else
+    {
+        buildMesh(relax);
+
+        vector<double> data;
+        SerializedWrite wdata(data);
+        int numCells = _cells.size();
+        wdata.write(numCells);
+        for (int m = 0; m != numCells; ++m) wdata.write(_cells[m]->position());
+        for (int m = 0; m != numCells; ++m) _cells[m]->writeGeometryIfPresent(wdata, m);
+        cache.store(data);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
 void VoronoiMeshSnapshot::calculateVolume()
 {
     int numCells = _cells.size();
     for (int m = 0; m != numCells; ++m)
     {
-        const Array& prop = _cells[m]->properties();
-        double volume = prop[densityIndex()] > 0. ? prop[massIndex()] / prop[densityIndex()] : 0.;
+        double density = property(m, densityIndex());
+        double volume = density > 0. ? property(m, massIndex()) / density : 0.;
         _cells[m]->init(volume);
     }
 }
@@ -1041,9 +1115,9 @@ int VoronoiMeshSnapshot::cellIndex(Position bfr) const
 
 ////////////////////////////////////////////////////////////////////
 
-const Array& VoronoiMeshSnapshot::properties(int m) const
+double VoronoiMeshSnapshot::property(int m, int p) const
 {
-    return _cells[m]->properties();
+    return _colv[p][_cells[m]->index()];
 }
 
 ////////////////////////////////////////////////////////////////////
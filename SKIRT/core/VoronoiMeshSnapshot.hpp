@@ -151,8 +151,11 @@ public:
         Sites located outside of the domain and sites that are too close to another site are
         discarded. The \em filename argument specifies the name of the input file, including
         filename extension but excluding path and simulation prefix. If the \em relax argument is
-        true, the function performs a single relaxation step on the site positions. */
-    VoronoiMeshSnapshot(const SimulationItem* item, const Box& extent, string filename, bool relax);
+        true, the function performs a single relaxation step on the site positions. If the \em
+        cache argument is true, the tessellation is loaded from or stored in a binary cache file;
+        see the buildMeshCached() function. */
+    VoronoiMeshSnapshot(const SimulationItem* item, const Box& extent, string filename, bool relax,
+                        bool cache = false);
 
     /** This constructor obtains the site positions from a SiteListInterface instance. The
         constructor completes the configuration for the object (but without importing mass density
@@ -165,8 +168,11 @@ public:
         Sites located outside of the domain and sites that are too close to another site are
         discarded. The \em sli argument specifies an object that provides the SiteListInterface
         interface from which to obtain the site positions. If the \em relax argument is true, the
-        function performs a single relaxation step on the site positions. */
-    VoronoiMeshSnapshot(const SimulationItem* item, const Box& extent, SiteListInterface* sli, bool relax);
+        function performs a single relaxation step on the site positions. If the \em cache
+        argument is true, the tessellation is loaded from or stored in a binary cache file; see the
+        buildMeshCached() function. */
+    VoronoiMeshSnapshot(const SimulationItem* item, const Box& extent, SiteListInterface* sli, bool relax,
+                        bool cache = false);
 
     /** This constructor obtains the site positions from a programmatically prepared list. The
         constructor completes the configuration for the object (but without importing mass density
@@ -178,8 +184,11 @@ public:
         argument specifies the extent of the domain as a box lined up with the coordinate axes.
         Sites located outside of the domain and sites that are too close to another site are
         discarded. The \em sites argument specifies the list of site positions. If the \em relax
-        argument is true, the function performs a single relaxation step on the site positions. */
-    VoronoiMeshSnapshot(const SimulationItem* item, const Box& extent, const vector<Vec>& sites, bool relax);
+        argument is true, the function performs a single relaxation step on the site positions. If
+        the \em cache argument is true, the tessellation is loaded from or stored in a binary cache
+        file; see the buildMeshCached() function. */
+    VoronoiMeshSnapshot(const SimulationItem* item, const Box& extent, const vector<Vec>& sites, bool relax,
+                        bool cache = false);
 
     //=========== Private construction ==========
 
@@ -211,6 +220,17 @@ private:
         quite time-consuming because the Voronoi tessellation must be constructed twice. */
     void buildMesh(bool relax);
 
+    /** This private function has the same effect as the buildMesh() function, but it attempts to
+        load the resulting tessellation from a binary cache file in the output directory (see the
+        BinaryCache class) rather than constructing it. The cache file is identified by a
+        fingerprint calculated from the domain extent, the \em relax argument, and the original
+        generating site positions, so that it can be reused by any subsequent simulation that
+        employs the same sites. If no such cache file exists, the function calls buildMesh() and
+        stores the site positions and cell information of the resulting tessellation in a new
+        cache file. The function can be used only for sites without user-defined properties. The
+        \em item argument specifies the simulation item used to retrieve context for the cache. */
+    void buildMeshCached(const SimulationItem* item, bool relax);
+
     /** This private function calculates the volumes for all cells without using the Voronoi mesh.
         It assumes that both mass and mass density columns are being imported. */
     void calculateVolume();
@@ -335,10 +355,10 @@ public:
     int cellIndex(Position bfr) const;
 
 protected:
-    /** This function returns a reference to an array containing the imported properties (in column
-        order) for the cell with index \f$0\le m \le N_\mathrm{ent}-1\f$. If the index is out of
-        range, the behavior is undefined. */
-    const Array& properties(int m) const override;
+    /** This function returns the value of the imported property with column index \em p for the
+        cell with index \f$0\le m \le N_\mathrm{ent}-1\f$. If either index is out of range, the
+        behavior is undefined. */
+    double property(int m, int p) const override;
 
 public:
     /** This function sets the specified entity collection to the cell containing the specified
@@ -446,6 +466,7 @@ private:
 
     // data members initialized when processing snapshot input and further completed by BuildMesh()
     vector<Cell*> _cells;  // cell objects, indexed on m
+    vector<Array> _colv;   // imported site properties, one array per column, indexed on the cell's import index
 
     // data members initialized when processing snapshot input, but only if a density policy has been set
     Array _rhov;       // density for each cell (not normalized)
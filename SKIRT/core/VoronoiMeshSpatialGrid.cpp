@@ -61,7 +61,7 @@ void VoronoiMeshSpatialGrid::setupSelfBefore()
             auto random = find<Random>();
             vector<Vec> rv(_numSites);
             for (int m = 0; m != _numSites; ++m) rv[m] = random->position(extent());
-            _mesh = new VoronoiMeshSnapshot(this, extent(), rv, _relaxSites);
+            _mesh = new VoronoiMeshSnapshot(this, extent(), rv, _relaxSites, _cacheGrid);
             break;
         }
         case Policy::CentralPeak:
@@ -77,7 +77,7 @@ void VoronoiMeshSpatialGrid::setupSelfBefore()
                 Position p = Position(r, k);
                 if (extent().contains(p)) rv[m++] = p;  // discard any points outside of the domain
             }
-            _mesh = new VoronoiMeshSnapshot(this, extent(), rv, _relaxSites);
+            _mesh = new VoronoiMeshSnapshot(this, extent(), rv, _relaxSites, _cacheGrid);
             break;
         }
         case Policy::DustDensity:
@@ -89,8 +89,8 @@ void VoronoiMeshSpatialGrid::setupSelfBefore()
             for (auto medium : ms->media())
                 if (medium->mix()->isDust()) media.push_back(medium);
             for (auto medium : media) weights.push_back(medium->mass());
-            _mesh =
-                new VoronoiMeshSnapshot(this, extent(), sampleMedia(media, weights, extent(), _numSites), _relaxSites);
+            _mesh = new VoronoiMeshSnapshot(this, extent(), sampleMedia(media, weights, extent(), _numSites),
+                                            _relaxSites, _cacheGrid);
             break;
         }
         case Policy::ElectronDensity:
@@ -102,8 +102,8 @@ void VoronoiMeshSpatialGrid::setupSelfBefore()
             for (auto medium : ms->media())
                 if (medium->mix()->isElectrons()) media.push_back(medium);
             for (auto medium : media) weights.push_back(medium->number());
-            _mesh =
-                new VoronoiMeshSnapshot(this, extent(), sampleMedia(media, weights, extent(), _numSites), _relaxSites);
+            _mesh = new VoronoiMeshSnapshot(this, extent(), sampleMedia(media, weights, extent(), _numSites),
+                                            _relaxSites, _cacheGrid);
             break;
         }
         case Policy::GasDensity:
@@ -115,19 +115,19 @@ void VoronoiMeshSpatialGrid::setupSelfBefore()
             for (auto medium : ms->media())
                 if (medium->mix()->isGas()) media.push_back(medium);
             for (auto medium : media) weights.push_back(medium->number());
-            _mesh =
-                new VoronoiMeshSnapshot(this, extent(), sampleMedia(media, weights, extent(), _numSites), _relaxSites);
+            _mesh = new VoronoiMeshSnapshot(this, extent(), sampleMedia(media, weights, extent(), _numSites),
+                                            _relaxSites, _cacheGrid);
             break;
         }
         case Policy::File:
         {
-            _mesh = new VoronoiMeshSnapshot(this, extent(), _filename, _relaxSites);
+            _mesh = new VoronoiMeshSnapshot(this, extent(), _filename, _relaxSites, _cacheGrid);
             break;
         }
         case Policy::ImportedSites:
         {
             auto sli = find<MediumSystem>()->interface<SiteListInterface>(2);
-            _mesh = new VoronoiMeshSnapshot(this, extent(), sli, _relaxSites);
+            _mesh = new VoronoiMeshSnapshot(this, extent(), sli, _relaxSites, _cacheGrid);
             break;
         }
         case Policy::ImportedMesh:
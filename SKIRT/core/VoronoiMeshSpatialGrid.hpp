@@ -22,7 +22,14 @@ class VoronoiMeshSnapshot;
     the positions can be copied from the sites in the imported distribution(s).
 
     Furthermore, the user can opt to perform a relaxation step on the site positions to avoid
-    overly elongated cells. */
+    overly elongated cells.
+
+    Finally, the user can opt to store the constructed Voronoi tessellation in a binary cache file
+    in the output directory, so that a subsequent simulation with the same site positions can load
+    the tessellation instead of constructing it again. Because the cache file is identified by a
+    fingerprint of the site positions, this is useful only if the site positions are reproducible,
+    for example when they are read from a file or when they are sampled using the same random
+    seed. */
 class VoronoiMeshSpatialGrid : public BoxSpatialGrid, public DensityInCellInterface
 {
     /** The enumeration type indicating the policy for determining the positions of the sites. */
@@ -56,6 +63,11 @@ class VoronoiMeshSpatialGrid : public BoxSpatialGrid, public DensityInCellInterf
         ATTRIBUTE_DEFAULT_VALUE(relaxSites, "false")
         ATTRIBUTE_RELEVANT_IF(relaxSites, "!policyImportedMesh")
 
+        PROPERTY_BOOL(cacheGrid, "cache the constructed tessellation for use by subsequent simulations")
+        ATTRIBUTE_DEFAULT_VALUE(cacheGrid, "false")
+        ATTRIBUTE_RELEVANT_IF(cacheGrid, "!policyImportedMesh")
+        ATTRIBUTE_DISPLAYED_IF(cacheGrid, "Level3")
+
     ITEM_END()
 
     //============= Construction - Setup - Destruction =============
@@ -11,6 +11,9 @@
 #include "FatalError.hpp"
 #include "MaterialState.hpp"
 #include "NR.hpp"
+#include "Parallel.hpp"
+#include "ParallelFactory.hpp"
+#include "ProcessManager.hpp"
 #include "Random.hpp"
 #include "Range.hpp"
 #include "TextInFile.hpp"
@@ -806,6 +809,59 @@ namespace
 
 ////////////////////////////////////////////////////////////////////
 
+// ---- precalculated per-wavelength tables ----
+
+namespace
+{
+    // builds the alias table for the discrete distribution with the specified non-normalized probabilities
+    // using the algorithm by Vose (1991); for each index i, the target receives the probability threshold for
+    // selecting index i itself and the alias index selected otherwise, so that the target must have room for
+    // twice the number of probabilities; the two vectors serve as scratch storage to avoid memory allocations;
+    // returns the sum of the non-normalized probabilities
+    double buildAliasTable(double* aliasv, const Array& pv, vector<int>& smallv, vector<int>& largev)
+    {
+        int n = pv.size();
+        double norm = 0.;
+        for (int i = 0; i != n; ++i) norm += pv[i];
+
+        // initialize the thresholds to the probabilities scaled to an average of unity (or to unity for an
+        // all-zero distribution) and divide the indices into those below and above average
+        smallv.clear();
+        largev.clear();
+        for (int i = 0; i != n; ++i)
+        {
+            aliasv[2 * i] = norm > 0. ? n * pv[i] / norm : 1.;
+            aliasv[2 * i + 1] = i;
+            if (aliasv[2 * i] < 1.)
+                smallv.push_back(i);
+            else
+                largev.push_back(i);
+        }
+
+        // fill the remaining probability of each small entry from a large entry, which may become small
+        while (!smallv.empty() && !largev.empty())
+        {
+            int s = smallv.back();
+            int l = largev.back();
+            smallv.pop_back();
+            aliasv[2 * s + 1] = l;
+            aliasv[2 * l] = (aliasv[2 * l] + aliasv[2 * s]) - 1.;
+            if (aliasv[2 * l] < 1.)
+            {
+                largev.pop_back();
+                smallv.push_back(l);
+            }
+        }
+
+        // the remaining entries have a threshold of unity except for rounding errors
+        for (int i : smallv) aliasv[2 * i] = 1.;
+        for (int i : largev) aliasv[2 * i] = 1.;
+        return norm;
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
 void XRayAtomicGasMix::setupSelfBefore()
 {
     MaterialMix::setupSelfBefore();
@@ -945,34 +1001,9 @@ void XRayAtomicGasMix::setupSelfBefore()
     {
         _lambdav[ell] = sqrt(lambdav[ell] * lambdav[ell - 1]);
     }
+    _lambdaIndexCache.initialize(_lambdav);
 
-    // ---- extinction ----
-
-    // calculate the extinction cross section at every wavelength; to guarantee that the cross section is zero
-    // for wavelengths outside our range, leave the values for the three outer wavelength points at zero
-    _sigmaextv.resize(numLambda);
-    for (int ell = 1; ell < numLambda - 2; ++ell)
-    {
-        double lambda = lambdav[ell];
-        double sigma = 0.;
-
-        // bound electron scattering
-        for (size_t Z = 1; Z <= numAtoms; ++Z)
-        {
-            sigma += (_ray->sectionSca(lambda, Z) + _com->sectionSca(lambda, Z)) * atomv[Z - 1].abund;
-        }
-
-        // photo-absorption and fluorescence
-        int index = 0;
-        for (const auto& params : crossSectionParams)
-        {
-            double E = wavelengthToFromEnergy(lambda);
-            sigma += crossSection(E, sigmoidv[index++], params) * atomv[params.Z - 1].abund;
-        }
-        _sigmaextv[ell] = sigma;
-    }
-
-    // ---- scattering ----
+    // ---- fluorescence emission ----
 
     // calculate and store the fluorescence emission parameters
     int numFluos = fluorescenceParams.size();
@@ -996,45 +1027,86 @@ void XRayAtomicGasMix::setupSelfBefore()
         }
     }
 
-    // make room for the scattering cross section and the cumulative fluorescence/scattering probabilities
-    _sigmascav.resize(numLambda);
-    _cumprobscavv.resize(numLambda, 0);
+    // ---- per-wavelength tables ----
 
-    // provide temporary array for the non-normalized fluorescence/scattering contributions (at the current wavelength)
-    Array contribv(2 * numAtoms + fluorescenceParams.size());
+    // each row holds the extinction and scattering cross sections followed by the alias table for the channels
+    _numChannels = 2 * numAtoms + numFluos;
+    _rowSize = 2 + 2 * _numChannels;
+    size_t numValues = numLambda * _rowSize;
 
-    // calculate the above for every wavelength; as before, leave the values for the outer wavelength points at zero
-    for (int ell = 1; ell < numLambda - 2; ++ell)
+    // if requested, attempt to load the tables from a cache file; the tables depend only on the configuration
+    // of this material mix (including the bound-electron implementation) and on the wavelength grid
+    if (cacheCrossSections())
     {
-        double lambda = lambdav[ell];
-        double E = wavelengthToFromEnergy(lambda);
-
-        // bound electron scattering
-        for (size_t Z = 1; Z <= numAtoms; ++Z)
+        _cache = std::make_unique<BinaryCache>(this, "xraygas");
+        _cache->addKey(this);
+        _cache->addKey(static_cast<double>(lambdav.size()));
+        _cache->addKey(lambdav.data(), lambdav.size() * sizeof(double));
+        if (_cache->load(numValues))
         {
-            contribv[Z - 1] = _ray->sectionSca(lambda, Z) * atomv[Z - 1].abund;
-            contribv[numAtoms + Z - 1] = _com->sectionSca(lambda, Z) * atomv[Z - 1].abund;
+            _tablev = _cache->data();
+            return;
         }
+    }
 
-        // fluorescence: iterate over both cross section and fluorescence parameter sets in sync
-        auto flp = fluorescenceParams.begin();
-        int index = 0;
-        for (const auto& csp : crossSectionParams)
-        {
-            auto sigmoid = sigmoidv[index++];
-
-            // process all fluorescence parameter sets matching this cross section set
-            while (flp != fluorescenceParams.end() && flp->Z == csp.Z && flp->n == csp.n && flp->l == csp.l)
+    // calculate the tables for every wavelength; to guarantee that the cross sections are zero for wavelengths
+    // outside our range, leave the values for the three outer wavelength points at zero;
+    // the wavelengths are distributed over processes and threads, and the results are combined afterwards
+    _tableStore.resize(numValues);
+    find<ParallelFactory>()->parallelDistributed()->call(
+        numLambda - 3, [this, &lambdav, &atomv, &crossSectionParams, &fluorescenceParams, &sigmoidv](
+                           size_t firstIndex, size_t numIndices) {
+            // provide temporary arrays for the non-normalized channel contributions (at the current wavelength)
+            // and for building the alias table
+            Array contribv(_numChannels);
+            vector<int> smallv, largev;
+            smallv.reserve(_numChannels);
+            largev.reserve(_numChannels);
+
+            for (size_t ell = firstIndex + 1; ell != firstIndex + 1 + numIndices; ++ell)
             {
-                double contribution = crossSection(E, sigmoid, csp) * atomv[csp.Z - 1].abund * flp->omega;
-                contribv[2 * numAtoms + flp - fluorescenceParams.begin()] = contribution;
-                flp++;
+                double lambda = lambdav[ell];
+                double E = wavelengthToFromEnergy(lambda);
+                double* row = &_tableStore[ell * _rowSize];
+
+                // bound electron scattering
+                double sigmaext = 0.;
+                for (size_t Z = 1; Z <= numAtoms; ++Z)
+                {
+                    double sigmaray = _ray->sectionSca(lambda, Z);
+                    double sigmacom = _com->sectionSca(lambda, Z);
+                    sigmaext += (sigmaray + sigmacom) * atomv[Z - 1].abund;
+                    contribv[Z - 1] = sigmaray * atomv[Z - 1].abund;
+                    contribv[numAtoms + Z - 1] = sigmacom * atomv[Z - 1].abund;
+                }
+
+                // photo-absorption and fluorescence:
+                // iterate over both cross section and fluorescence parameter sets in sync
+                auto flp = fluorescenceParams.begin();
+                int index = 0;
+                for (const auto& csp : crossSectionParams)
+                {
+                    double sigma = crossSection(E, sigmoidv[index++], csp) * atomv[csp.Z - 1].abund;
+                    sigmaext += sigma;
+
+                    // process all fluorescence parameter sets matching this cross section set
+                    while (flp != fluorescenceParams.end() && flp->Z == csp.Z && flp->n == csp.n && flp->l == csp.l)
+                    {
+                        contribv[2 * numAtoms + flp - fluorescenceParams.begin()] = sigma * flp->omega;
+                        flp++;
+                    }
+                }
+
+                // store the cross sections and build the alias table
+                row[0] = sigmaext;
+                row[1] = buildAliasTable(row + 2, contribv, smallv, largev);
             }
-        }
+        });
+    ProcessManager::sumToAll(_tableStore);
+    _tablev = &_tableStore[0];
 
-        // determine the normalized cumulative probability distribution and the cross section
-        _sigmascav[ell] = NR::cdf(_cumprobscavv[ell], contribv);
-    }
+    // if requested, store the tables in a cache file
+    if (_cache) _cache->store(_tablev, numValues);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -1049,7 +1121,7 @@ XRayAtomicGasMix::~XRayAtomicGasMix()
 
 int XRayAtomicGasMix::indexForLambda(double lambda) const
 {
-    return NR::locateClip(_lambdav, lambda);
+    return _lambdaIndexCache.index(lambda);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -1091,22 +1163,22 @@ double XRayAtomicGasMix::mass() const
 
 double XRayAtomicGasMix::sectionAbs(double lambda) const
 {
-    int index = indexForLambda(lambda);
-    return _sigmaextv[index] - _sigmascav[index];
+    const double* row = _tablev + indexForLambda(lambda) * _rowSize;
+    return row[0] - row[1];
 }
 
 ////////////////////////////////////////////////////////////////////
 
 double XRayAtomicGasMix::sectionSca(double lambda) const
 {
-    return _sigmascav[indexForLambda(lambda)];
+    return _tablev[indexForLambda(lambda) * _rowSize + 1];
 }
 
 ////////////////////////////////////////////////////////////////////
 
 double XRayAtomicGasMix::sectionExt(double lambda) const
 {
-    return _sigmaextv[indexForLambda(lambda)];
+    return _tablev[indexForLambda(lambda) * _rowSize];
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -1140,7 +1212,14 @@ void XRayAtomicGasMix::setScatteringInfoIfNeeded(PhotonPacket::ScatteringInfo* s
     if (!scatinfo->valid)
     {
         scatinfo->valid = true;
-        scatinfo->species = NR::locateClip(_cumprobscavv[indexForLambda(lambda)], random()->uniform());
+
+        // select a scattering channel from the alias table for this wavelength
+        const double* aliasv = _tablev + indexForLambda(lambda) * _rowSize + 2;
+        double x = random()->uniform() * _numChannels;
+        int m = min(static_cast<int>(x), static_cast<int>(_numChannels) - 1);
+        scatinfo->species = x - m < aliasv[2 * m] ? m : static_cast<int>(aliasv[2 * m + 1]);
+
+        // draw the thermal velocity of the interacting atom
         if (temperature() > 0.) scatinfo->velocity = _vthermscav[scatinfo->species] * random()->maxwell();
 
         // for a fluorescence transition, determine the outgoing wavelength from the corresponding parameters
@@ -6,9 +6,10 @@
 #ifndef XRAYATOMICGASMIX_HPP
 #define XRAYATOMICGASMIX_HPP
 
-#include "ArrayTable.hpp"
+#include "BinaryCache.hpp"
 #include "MaterialMix.hpp"
 #include "PhotonPacket.hpp"
+#include "WavelengthIndexCache.hpp"
 
 ////////////////////////////////////////////////////////////////////
 
@@ -243,11 +244,30 @@
     scattering channels (i.e. scattering by an electron bound to one of the supported elements or
     one of the 20 fluorescent line transition for one of the supported elements). The relative
     probabilities for these transitions as a function of incoming photon packet wavelength are also
-    calculated during setup. The selected transition determines the scattering mechanism. For bound
-    electrons, Rayleigh or Compton scattering is used. For fluorescence, the emission direction is
-    isotropic, and the outgoing wavelength is the fluorescence wavelength. In both cases, a random
-    Gaussian dispersion reflecting the interacting element's thermal velocity is applied to the
-    outgoing wavelength.
+    calculated during setup and converted to an alias table for each wavelength (Walker 1977, ACM
+    Trans. Math. Softw. 3, 253; Vose 1991, IEEE Trans. Softw. Eng. 17, 972). As a result, selecting
+    a channel takes constant time regardless of the number of channels, consuming a single uniform
+    deviate and requiring a single table look-up. The selected transition determines the
+    scattering mechanism. For bound electrons, Rayleigh or Compton scattering is used. For
+    fluorescence, the emission direction is isotropic, and the outgoing wavelength is the
+    fluorescence wavelength. In both cases, a random Gaussian dispersion reflecting the interacting
+    element's thermal velocity is applied to the outgoing wavelength.
+
+    <b>Caching the precalculated tables</b>
+
+    The extinction and scattering cross sections and the alias tables for selecting a scattering
+    channel are tabulated on a high-resolution wavelength grid with 2500 points per dex. For each
+    of these wavelengths, the setup procedure evaluates the photo-absorption cross sections for all
+    electron shells and the bound-electron cross sections for all elements, which may take a
+    substantial amount of time. If the \em cacheCrossSections flag is enabled, this class stores
+    these per-wavelength tables in a binary cache file in the output directory (see the BinaryCache
+    class). A subsequent simulation with the same material mix configuration and the same
+    wavelength grid, which depends on the wavelengths mentioned in the simulation configuration,
+    loads the tables from the cache file through a memory map instead of recalculating them. In a
+    multi-processing environment, all processes on a given host thus share the same physical
+    memory for these tables. The resources needed to perform the actual scattering events are
+    still loaded during setup. Changes to the built-in resource files are not detected, so the
+    cache files should be removed after updating the resources.
 
     <b>Thermal dispersion</b>
 
@@ -310,13 +330,18 @@ class XRayAtomicGasMix : public MaterialMix
         ATTRIBUTE_DEFAULT_VALUE(scatterBoundElectrons, "Good")
         ATTRIBUTE_DISPLAYED_IF(scatterBoundElectrons, "Level3")
 
+        PROPERTY_BOOL(cacheCrossSections, "cache the cross section tables for use by subsequent simulations")
+        ATTRIBUTE_DEFAULT_VALUE(cacheCrossSections, "false")
+        ATTRIBUTE_DISPLAYED_IF(cacheCrossSections, "Level3")
+
     ITEM_END()
 
     //============= Construction - Setup - Destruction =============
 
 protected:
     /** This function precalculates relevant cross sections and relative contributions over a
-        high-resolution wavelength grid. */
+        high-resolution wavelength grid, or loads them from a cache file if so requested and
+        available. */
     void setupSelfBefore() override;
 
     /** The destructor destructs the phase function helpers that were created during setup. */
@@ -327,7 +352,8 @@ protected:
 private:
     /** This function returns the index in the private wavelength grid corresponding to the
         specified wavelength. The parameters for converting a wavelength to the appropriate index
-        are stored in data members during setup. */
+        are stored in data members during setup, and the most recent result is remembered for each
+        execution thread. */
     int indexForLambda(double lambda) const;
 
     //======== Capabilities =======
@@ -451,9 +477,17 @@ private:
     // wavelength grid (shifted to the left of the actually sampled points to approximate rounding)
     Array _lambdav;  // indexed on ell
 
-    // total extinction and scattering cross sections
-    Array _sigmaextv;  // indexed on ell
-    Array _sigmascav;  // indexed on ell
+    // per-thread memory of the most recent conversion from wavelength to index in the above grid
+    WavelengthIndexCache _lambdaIndexCache;
+
+    // per-wavelength tables, loaded from a cache file or calculated during setup; the row for each wavelength
+    // holds the total extinction and scattering cross sections followed by the alias table for the scattering
+    // channels, i.e. the probability threshold and the alias channel index for each channel
+    std::unique_ptr<BinaryCache> _cache;  // the cache providing the tables loaded from file, if any
+    Array _tableStore;                    // the tables calculated during setup, if not loaded from file
+    const double* _tablev{nullptr};       // pointer to the first value of the tables; indexed on ell, column
+    size_t _numChannels{0};               // the number of scattering channels
+    size_t _rowSize{0};                   // the number of values in the row for each wavelength
 
     // emission parameters for each of the fluorescence transitions:
     // if wavelength is nonzero, all photons are emitted at this wavelength;
@@ -462,12 +496,11 @@ private:
     vector<double> _centralfluov;  // indexed on k
     vector<double> _widthfluov;    // indexed on k
 
-    // thermal velocities and normalized cumulative probability distributions for the scattering channnels:
+    // thermal velocities for the scattering channnels (the order of the channels is also used for the alias tables):
     //   - Rayleigh scattering by bound electrons for each atom
     //   - Compton scattering by bound electrons for each atom
     //   - fluorescence transitions
-    vector<double> _vthermscav;   // indexed on m
-    ArrayTable<2> _cumprobscavv;  // indexed on ell, m
+    vector<double> _vthermscav;  // indexed on m
 
     // bound-electron scattering helpers depending on the configured implementation
     ScatteringHelper* _ray{nullptr};  // Rayleigh scattering helper
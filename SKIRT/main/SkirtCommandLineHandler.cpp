@@ -28,7 +28,7 @@
 namespace
 {
     // the allowed options list, in the format consumed by the CommandLineArguments constructor
-    static const char* allowedOptions = "-t* -s* -d -b -v -m -e -k -i* -o* -r -x";
+    static const char* allowedOptions = "-t* -s* -d -b -v -m -e -p* -k -i* -o* -r -x";
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -177,6 +177,23 @@ int SkirtCommandLineHandler::doBatch()
         return EXIT_FAILURE;
     }
 
+    // configure the features used for memory-mapping resource and input files
+    if (_args.isPresent("-p"))
+    {
+        auto features = StringUtils::split(_args.value("-p"), ",");
+        for (const string& feature : features)
+        {
+            if (feature != "prefetch" && feature != "populate" && feature != "hugepages")
+            {
+                _console.error("Invalid memory map feature: " + feature, false);
+                if (!_args.isPresent("-b")) printHelp();
+                return EXIT_FAILURE;
+            }
+        }
+        auto has = [&features](string feature) { return std::count(features.begin(), features.end(), feature) > 0; };
+        System::setMemoryMapOptions(has("prefetch"), has("populate"), has("hugepages"));
+    }
+
     // if there is only one ski file, simply perform the single simulation
     size_t numSkiFiles = _skifiles.size();
     if (numSkiFiles == 1)
@@ -433,7 +450,7 @@ void SkirtCommandLineHandler::printHelp()
     _console.warning("To run a simulation with default options:  skirt <ski-filename>");
     _console.warning("");
     _console.warning("  skirt [-t <threads>] [-s <simulations>] [-d]");
-    _console.warning("        [-b] [-v] [-m] [-e]");
+    _console.warning("        [-b] [-v] [-m] [-e] [-p <features>]");
     _console.warning("        [-k] [-i <dirpath>] [-o <dirpath>]");
     _console.warning("        [-r] {<filepath>}*");
     _console.warning("");
@@ -444,6 +461,7 @@ void SkirtCommandLineHandler::printHelp()
     _console.warning("  -v : force verbose logging for multiple processes");
     _console.warning("  -m : state the amount of used memory at the start of each log message");
     _console.warning("  -e : run the simulation in emulation mode to get an estimate of the memory consumption");
+    _console.warning("  -p <features> : comma-separated memory map features (prefetch, populate, hugepages)");
     _console.warning("  -k : make the input/output paths relative to the ski file being processed");
     _console.warning("  -i <dirpath> : the relative or absolute path for simulation input files");
     _console.warning("  -o <dirpath> : the relative or absolute path for simulation output files");
@@ -21,7 +21,7 @@ simulations in the ski files specified on the command line according to the foll
 
 \verbatim
  skirt [-t <threads>] [-s <simulations>] [-d]
-       [-b] [-v] [-m] [-e]
+       [-b] [-v] [-m] [-e] [-p <features>]
        [-k] [-i <dirpath>] [-o <dirpath>]
        [-r] {<filepath>}*
 \endverbatim
@@ -49,6 +49,12 @@ simulations in the ski files specified on the command line according to the foll
 - The -e option activates emulation mode, which can be used to estimate the amount of memory used by
   a given simulation without actually performing the simulation.
 
+- The -p option specifies a comma-separated list of features used for memory-mapping resource and input files such as
+  stored tables: "prefetch" asks the operating system to start reading the complete file asynchronously as soon as it
+  is opened; "populate" reads the complete file while it is opened; and "hugepages" requests transparent huge pages
+  for large files. These features may reduce the time spent waiting for page faults when large resources reside on a
+  slow (e.g., parallel or networked) file system. See System::setMemoryMapOptions() for more information.
+
 - The -k option causes the simulation input/output paths to be relative to the ski file being processed, rather than
   to the current directory. This is useful, for example, when processing multiple ski files organized in a nested
   directory hierarchy (see the -r option).
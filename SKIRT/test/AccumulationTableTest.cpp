@@ -0,0 +1,53 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "AccumulationTable.hpp"
+#include "LockFree.hpp"
+#include "UnitTest.hpp"
+
+////////////////////////////////////////////////////////////////////
+
+void testAccumulationTable()
+{
+    // adding values far below the unit of least precision of a single precision target does not stagnate
+    {
+        float target = 16777216.f;  // 2^24, so that adding 1 lies exactly halfway between representable values
+        uint64_t state = 1;
+        for (int i = 0; i != 1000000; ++i)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            LockFree::add(target, 1., (state >> 11) * 0x1.0p-53);
+        }
+        UnitTest::checkClose("stochastic rounding of 1e6 unit contributions to 2^24", target, 17777216., 1e-4);
+    }
+
+    // staged contributions are flushed correctly, including when the staging buffer overflows
+    {
+        const int numColumns = 5000;
+        AccumulationTable single, dual;
+        single.resize(1, numColumns, true, 1e-3);
+        dual.resize(1, numColumns, false);
+        for (int i = 0; i != 2000000; ++i)
+        {
+            single.add(0, 0, 1.);
+            single.add(0, 1 + i % (numColumns - 1), 0.5);
+            dual.add(0, 0, 1.);
+            dual.add(0, 1 + i % (numColumns - 1), 0.5);
+        }
+        single.sumToAll();
+        dual.sumToAll();
+        UnitTest::checkClose("single precision sum in first column", single(0, 0), dual(0, 0), 1e-6);
+        UnitTest::checkClose("single precision sum in last column", single(0, numColumns - 1),
+                             dual(0, numColumns - 1), 1e-6);
+
+        // the values survive copying, and zeroing discards them
+        AccumulationTable copy = single;
+        UnitTest::checkClose("copied single precision sum", copy(0, 0), dual(0, 0), 1e-6);
+        single.setToZero();
+        UnitTest::checkClose("zeroed single precision sum", single(0, 0), 0., 0.);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
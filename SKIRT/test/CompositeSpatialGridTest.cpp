@@ -0,0 +1,165 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "Constants.hpp"
+#include "FatalError.hpp"
+#include "FilePaths.hpp"
+#include "Log.hpp"
+#include "MediumSystem.hpp"
+#include "MonteCarloSimulation.hpp"
+#include "SimulationItemRegistry.hpp"
+#include "System.hpp"
+#include "UnitTest.hpp"
+#include "XmlHierarchyCreator.hpp"
+#include <fstream>
+#include <sstream>
+
+////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    // a gas emission simulation on a composite grid with a 2x2x2 outer grid, one cell of which is completely covered
+    // by the inner grid; the spin-flip gas mix does not require any resource files
+    const char* skiContents = R"(<?xml version="1.0" encoding="UTF-8"?>
+<skirt-simulation-hierarchy type="MonteCarloSimulation" format="9">
+  <MonteCarloSimulation userLevel="Expert" simulationMode="GasEmission" numPackets="1000">
+    <random type="Random"><Random seed="0"/></random>
+    <units type="Units"><SIUnits wavelengthOutputStyle="Wavelength"/></units>
+    <sourceSystem type="SourceSystem">
+      <SourceSystem minWavelength="0.09 micron" maxWavelength="1 micron" wavelengths="0.55 micron">
+        <sources type="Source">
+          <PointSource>
+            <sed type="SED"><BlackBodySED temperature="20000 K"/></sed>
+            <normalization type="LuminosityNormalization">
+              <IntegratedLuminosityNormalization wavelengthRange="Source" integratedLuminosity="1e6 Lsun"/>
+            </normalization>
+          </PointSource>
+        </sources>
+      </SourceSystem>
+    </sourceSystem>
+    <mediumSystem type="MediumSystem">
+      <MediumSystem>
+        <radiationFieldOptions type="RadiationFieldOptions">
+          <RadiationFieldOptions storeRadiationField="true">
+            <radiationFieldWLG type="DisjointWavelengthGrid">
+              <LogWavelengthGrid minWavelength="0.09 micron" maxWavelength="1 micron" numWavelengths="10"/>
+            </radiationFieldWLG>
+          </RadiationFieldOptions>
+        </radiationFieldOptions>
+        <media type="Medium">
+          <GeometricMedium>
+            <geometry type="Geometry"><PlummerGeometry scaleLength="300 pc"/></geometry>
+            <materialMix type="MaterialMix"><SpinFlipHydrogenGasMix/></materialMix>
+            <normalization type="MaterialNormalization"><MassMaterialNormalization mass="1e7 Msun"/></normalization>
+          </GeometricMedium>
+        </media>
+        <grid type="SpatialGrid">
+          <CompositeSpatialGrid>
+            <outerGrid type="BoxSpatialGrid">
+              <CartesianSpatialGrid minX="-1 kpc" maxX="1 kpc" minY="-1 kpc" maxY="1 kpc" minZ="-1 kpc" maxZ="1 kpc">
+                <meshX type="Mesh"><LinMesh numBins="2"/></meshX>
+                <meshY type="Mesh"><LinMesh numBins="2"/></meshY>
+                <meshZ type="Mesh"><LinMesh numBins="2"/></meshZ>
+              </CartesianSpatialGrid>
+            </outerGrid>
+            <innerGrids type="BoxSpatialGrid">
+              <CartesianSpatialGrid minX="0 kpc" maxX="1 kpc" minY="0 kpc" maxY="1 kpc" minZ="0 kpc" maxZ="1 kpc">
+                <meshX type="Mesh"><LinMesh numBins="2"/></meshX>
+                <meshY type="Mesh"><LinMesh numBins="2"/></meshY>
+                <meshZ type="Mesh"><LinMesh numBins="2"/></meshZ>
+              </CartesianSpatialGrid>
+            </innerGrids>
+          </CompositeSpatialGrid>
+        </grid>
+      </MediumSystem>
+    </mediumSystem>
+    <instrumentSystem type="InstrumentSystem"><InstrumentSystem/></instrumentSystem>
+    <probeSystem type="ProbeSystem">
+      <ProbeSystem>
+        <probes type="Probe">
+          <SecondaryLineLuminosityProbe probeName="lum">
+            <form type="Form"><PerCellForm/></form>
+          </SecondaryLineLuminosityProbe>
+        </probes>
+      </ProbeSystem>
+    </probeSystem>
+  </MonteCarloSimulation>
+</skirt-simulation-hierarchy>
+)";
+
+    // the index of the outer cell that is completely covered by the inner grid
+    constexpr int coveredCell = 7;
+}
+
+////////////////////////////////////////////////////////////////////
+
+void testCompositeSpatialGrid()
+{
+    auto topItem = XmlHierarchyCreator::readString(SimulationItemRegistry::getSchemaDef(), skiContents,
+                                                   "composite spatial grid test");
+    auto simulation = dynamic_cast<MonteCarloSimulation*>(topItem.get());
+    simulation->filePaths()->setOutputPrefix("CompositeSpatialGridTest");
+    simulation->log()->setLowestLevel(Log::Level::Error);
+
+    // the covered outer cell has zero volume, and the cell volumes add up to the volume of the outer domain
+    auto grid = simulation->mediumSystem()->grid();
+    grid->setup();
+    UnitTest::checkClose("number of cells", grid->numCells(), 16., 0.);
+    UnitTest::checkClose("volume of covered outer cell", grid->volume(coveredCell), 0., 0.);
+    double totalVolume = 0.;
+    for (int m = 0; m != grid->numCells(); ++m) totalVolume += grid->volume(m);
+    double kpc = 1e3 * Constants::pc();
+    UnitTest::checkClose("total volume of all cells", totalVolume, 8. * kpc * kpc * kpc, 1e-12);
+
+    // running a simulation requires the built-in resources, which are located relative to the executable;
+    // skip the remainder of the test if the build tree is not placed next to the source tree as usual
+    try
+    {
+        FilePaths::resource("ExpectedResources.txt");
+    }
+    catch (FatalError&)
+    {
+        std::cerr << "SKIPPED: composite spatial grid simulation: built-in resources not found" << std::endl;
+        return;
+    }
+
+    // run the simulation, writing its output files in the current directory
+    try
+    {
+        simulation->setupAndRun();
+    }
+    catch (FatalError& error)
+    {
+        for (string line : error.message()) std::cerr << line << std::endl;
+        UnitTest::numFailures()++;
+        return;
+    }
+
+    // the line luminosity volume density written by the probe is finite in all cells and zero in the covered cell
+    string path = simulation->filePaths()->output("lum_0_L.dat");
+    std::ifstream in = System::ifstream(path);
+    int numCells = 0;
+    int numInvalid = 0;
+    string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        // parse the value with std::stod, which unlike stream extraction accepts "nan" and "inf"
+        std::istringstream columns(line);
+        int m = -1;
+        string token;
+        columns >> m >> token;
+        double value = std::stod(token);
+        if (!std::isfinite(value) || value < 0. || (m == coveredCell && value != 0.)) numInvalid++;
+        numCells++;
+    }
+    in.close();
+    UnitTest::checkClose("number of cells in line luminosity probe", numCells, grid->numCells(), 0.);
+    UnitTest::checkClose("invalid values in line luminosity probe", numInvalid, 0., 0.);
+
+    System::removeFile(path);
+}
+
+////////////////////////////////////////////////////////////////////
@@ -0,0 +1,29 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "LyaUtils.hpp"
+#include "UnitTest.hpp"
+
+////////////////////////////////////////////////////////////////////
+
+void testLyaUtils()
+{
+    // the dynamic critical frequency vanishes for optically thin cells
+    UnitTest::checkClose("dynamic x_crit for a tau0 = 0.5", LyaUtils::dynamicCriticalFrequency(0.5), 0., 0.);
+    UnitTest::checkClose("dynamic x_crit for a tau0 = 1", LyaUtils::dynamicCriticalFrequency(1.), 0., 0.);
+
+    // reference values for the fitting formula of Laursen et al. 2009, ApJ 696, 853:
+    // x_crit = 0.02 exp(0.6 (ln a tau0)^1.2) for 1 < a tau0 <= 60 and 0.02 exp(1.4 (ln a tau0)^0.6) above
+    UnitTest::checkClose("dynamic x_crit for a tau0 = 1e1", LyaUtils::dynamicCriticalFrequency(1e1), 0.102316, 1e-5);
+    UnitTest::checkClose("dynamic x_crit for a tau0 = 1e2", LyaUtils::dynamicCriticalFrequency(1e2), 0.662349, 1e-5);
+    UnitTest::checkClose("dynamic x_crit for a tau0 = 1e4", LyaUtils::dynamicCriticalFrequency(1e4), 4.02722, 1e-5);
+    UnitTest::checkClose("dynamic x_crit for a tau0 = 1e6", LyaUtils::dynamicCriticalFrequency(1e6), 17.3611, 1e-5);
+
+    // the two branches of the fitting formula join almost continuously at a tau0 = 60
+    UnitTest::checkClose("dynamic x_crit continuity at a tau0 = 60", LyaUtils::dynamicCriticalFrequency(60.),
+                         LyaUtils::dynamicCriticalFrequency(60. * (1. + 1e-9)), 1e-2);
+}
+
+////////////////////////////////////////////////////////////////////
@@ -0,0 +1,86 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "RateEquationSolver.hpp"
+#include "UnitTest.hpp"
+
+////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    // the number of levels in the test system
+    constexpr int numLevels = 60;
+
+    // return a rate matrix with N rows and N+1 columns for a ladder of levels with decreasing statistical weight,
+    // combining radiative decay from each level to all lower levels with collisional transitions between all levels
+    // obeying detailed balance, so that the population of the upper levels drops by many orders of magnitude
+    vector<double> rateMatrix(int size)
+    {
+        int stride = size + 1;
+        vector<double> matrix(size * stride, 0.);
+        auto element = [&matrix, stride](int i, int j) -> double& { return matrix[i * stride + j]; };
+        for (int up = 1; up != size; ++up)
+        {
+            for (int low = 0; low != up; ++low)
+            {
+                double Aul = 1e-3 * up * up / (up - low);
+                double Cul = 1e-4 * (1. + 0.1 * ((up * 7 + low * 3) % 5));
+                double Clu = Cul * exp(-0.4 * (up - low));
+                element(up, up) -= Aul + Cul;
+                element(low, up) += Aul + Cul;
+                element(low, low) -= Clu;
+                element(up, low) += Clu;
+            }
+        }
+        return matrix;
+    }
+
+    // solve the equations for the given matrix directly, after replacing the last equation by the normalization
+    vector<double> directSolution(vector<double> matrix, int size, double total)
+    {
+        int stride = size + 1;
+        for (int p = 0; p != size; ++p) matrix[(size - 1) * stride + p] = 1.;
+        matrix[(size - 1) * stride + size] = total;
+        vector<double> solution(size);
+        RateEquationSolver::solveDirect(matrix.data(), size, solution.data());
+        return solution;
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+void testRateEquationSolver()
+{
+    const double total = 1e3;
+    const double tolerance = 1e-5;
+    auto matrix = rateMatrix(numLevels);
+    auto direct = directSolution(matrix, numLevels, total);
+
+    // the direct solution satisfies the rate equations and covers a large dynamic range; because of round-off
+    // errors in the decomposition, the relative accuracy of the least populated levels is limited
+    double residual = RateEquationSolver::maxRelativeResidual(matrix.data(), numLevels, direct.data());
+    UnitTest::checkClose("direct solution satisfies the rate equations", residual < 1e-5, 1., 0.);
+    UnitTest::checkClose("direct solution has a large dynamic range", direct[numLevels - 1] / direct[0] < 1e-6, 1., 0.);
+
+    // starting from a perturbed direct solution, the iteration converges to the direct solution for each level;
+    // the least populated levels start off by a large factor, which hardly affects the residual relative to the
+    // total density, so that a criterion on that residual would accept an inaccurate solution for these levels
+    vector<double> populations(numLevels);
+    for (int p = 0; p != numLevels; ++p)
+        populations[p] = direct[p] * (p < numLevels / 2 ? 1. + 0.01 * ((p * 13) % 7 - 3) : 3.);
+    bool solved = RateEquationSolver::solveIterative(matrix.data(), numLevels, total, tolerance, 1000,
+                                                     populations.data());
+    UnitTest::checkClose("iteration from a perturbed solution converges", solved, 1., 0.);
+    double maxError = 0.;
+    for (int p = 0; p != numLevels; ++p) maxError = max(maxError, abs(populations[p] / direct[p] - 1.));
+    UnitTest::checkClose("iterative solution matches direct solution", maxError < 10. * tolerance, 1., 0.);
+
+    // a small number of sweeps from a poor starting point is not accepted
+    for (int p = 0; p != numLevels; ++p) populations[p] = total / numLevels;
+    solved = RateEquationSolver::solveIterative(matrix.data(), numLevels, total, tolerance, 10, populations.data());
+    UnitTest::checkClose("iteration from a poor starting point is rejected", solved, 0., 0.);
+}
+
+////////////////////////////////////////////////////////////////////
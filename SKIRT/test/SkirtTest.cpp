@@ -0,0 +1,39 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "SimulationItemRegistry.hpp"
+#include "System.hpp"
+#include "UnitTest.hpp"
+
+////////////////////////////////////////////////////////////////////
+
+// test functions defined in the other source files of this executable
+void testAccumulationTable();
+void testCompositeSpatialGrid();
+void testLyaUtils();
+void testRateEquationSolver();
+void testSmoothingKernels();
+
+////////////////////////////////////////////////////////////////////
+
+// the main function runs all unit tests and returns a nonzero exit code if any check failed
+int main(int argc, char** argv)
+{
+    // initialize the system and the item registry, as required for running simulations
+    System system(argc, argv);
+    SimulationItemRegistry registry("test", "9");
+
+    testAccumulationTable();
+    testCompositeSpatialGrid();
+    testLyaUtils();
+    testRateEquationSolver();
+    testSmoothingKernels();
+
+    int numFailures = UnitTest::numFailures();
+    if (numFailures) std::cerr << numFailures << " check(s) failed" << std::endl;
+    return numFailures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////
@@ -0,0 +1,62 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#include "CubicSplineSmoothingKernel.hpp"
+#include "QuarticSplineSmoothingKernel.hpp"
+#include "ScaledGaussianSmoothingKernel.hpp"
+#include "UniformSmoothingKernel.hpp"
+#include "UnitTest.hpp"
+
+////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    // exposes the protected default constructor of a simulation item so that it can be tested stand-alone
+    template<class ItemType> class StandAlone : public ItemType
+    {
+    public:
+        StandAlone() {}
+    };
+
+    // checks that the batched densities agree with the scalar densities for radii inside and outside of the support,
+    // and that the kernel satisfies the normalization 4 pi int_0^1 W(u) u^2 du = 1
+    void testKernel(string name, const SmoothingKernel& kernel)
+    {
+        // the batched and scalar densities should be identical, including at the boundaries between the pieces
+        vector<double> uv{-0.5, 0., 0.2, 0.5, 0.6, 1., 1.5};
+        for (int i = 0; i <= 1000; ++i) uv.push_back(-0.1 + 0.0012 * i);
+        int numRadii = uv.size();
+        vector<double> Wv(numRadii);
+        kernel.densities(uv.data(), Wv.data(), numRadii);
+        int numMismatches = 0;
+        for (int i = 0; i != numRadii; ++i)
+            if (Wv[i] != kernel.density(uv[i])) numMismatches++;
+        UnitTest::checkClose(name + " batched density mismatches", numMismatches, 0., 0.);
+
+        // integrate with Simpson's rule on a grid that includes the boundaries between the pieces of the spline kernels
+        const int numIntervals = 10000;
+        double du = 1. / numIntervals;
+        double sum = 0.;
+        for (int k = 0; k <= numIntervals; ++k)
+        {
+            double u = k * du;
+            double weight = (k == 0 || k == numIntervals) ? 1. : (k % 2 ? 4. : 2.);
+            sum += weight * kernel.density(u) * u * u;
+        }
+        UnitTest::checkClose(name + " normalization", 4. * M_PI * sum * du / 3., 1., 1e-6);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+void testSmoothingKernels()
+{
+    testKernel("cubic spline kernel", StandAlone<CubicSplineSmoothingKernel>());
+    testKernel("quartic spline kernel", StandAlone<QuarticSplineSmoothingKernel>());
+    testKernel("scaled Gaussian kernel", StandAlone<ScaledGaussianSmoothingKernel>());
+    testKernel("uniform kernel", StandAlone<UniformSmoothingKernel>());
+}
+
+////////////////////////////////////////////////////////////////////
@@ -0,0 +1,43 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#ifndef UNITTEST_HPP
+#define UNITTEST_HPP
+
+#include "Basics.hpp"
+#include <iostream>
+
+////////////////////////////////////////////////////////////////////
+
+/** The UnitTest namespace offers a minimal facility for checking the results of functions or of
+    small simulations that can be run without any resource files. Each test function in the test
+    executable performs a number of checks; failed checks are reported on the standard error
+    stream and counted, so that the executable can return a nonzero exit code if any check
+    failed. */
+namespace UnitTest
+{
+    /** This function returns a reference to the number of failed checks so far. */
+    inline int& numFailures()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    /** This function checks that the specified actual value equals the expected value within the
+        specified relative tolerance. If not, it reports the failure including the given
+        description and increments the failure count. */
+    inline void checkClose(string description, double actual, double expected, double tolerance)
+    {
+        if (!(abs(actual - expected) <= tolerance * abs(expected)))
+        {
+            std::cerr << "FAILED: " << description << ": " << actual << " != " << expected << std::endl;
+            numFailures()++;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+
+#endif
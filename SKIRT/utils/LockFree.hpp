@@ -35,6 +35,33 @@ namespace LockFree
         {
         }
     }
+
+    /** This function adds the specified double value (which can be an expression) to the
+        specified single precision target variable in a thread-safe manner, using the same compare
+        and swap (CAS) loop as the function above. The addition is performed in double precision
+        and the result is rounded stochastically to one of the two nearest single precision
+        values, with probabilities inversely proportional to the distance to these values. The
+        caller provides a uniform deviate \f$0\le u<1\f$ to make this selection. As a result, the
+        expected value of the stored sum equals the exact sum, even for values that are much
+        smaller than the unit of least precision of the target. */
+    inline void add(float& target, double value, double u)
+    {
+        // reinterpret the target location as an atom (this produces no assembly code)
+        auto atom = reinterpret_cast<std::atomic<float>*>(&target);
+
+        // make a local copy of the target location's value
+        float old = *atom;
+
+        // perform the compare and swap (CAS) loop, rounding the exact sum to the lower or upper neighbor
+        while (true)
+        {
+            double sum = old + value;
+            float nearest = static_cast<float>(sum);
+            float other = std::nextafter(nearest, sum > nearest ? HUGE_VALF : -HUGE_VALF);
+            float rounded = (u * abs(other - static_cast<double>(nearest)) < abs(sum - nearest)) ? other : nearest;
+            if (atom->compare_exchange_weak(old, rounded)) break;
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -190,6 +190,40 @@ public:
         return locateBasicImpl(xv, x, n - 1);
     }
 
+    /** This function builds a guide table for performing the locateClip() operation on the
+        specified normalized cumulative distribution \f$P_i\f$ (with \f$P_0=0\f$ and
+        \f$P_N=1\f$) in constant time on average, as implemented by the locateGuided() function.
+        The guide table has \f$M\f$ entries, where \f$M\f$ is specified by the \em numGuides
+        argument. The guide table entry \f$g_k\f$ with \f$k=0,\dots,M-1\f$ is set to the result
+        of locateClip() for the query value \f$k/M\f$. The guide table vector is resized
+        appropriately.
+
+        The guide table technique was introduced by Chen & Asau (1974, J. Chin. Inst. Eng. 17,
+        297). Using \f$M=N\f$ entries, the average number of additional comparisons required for
+        each look-up is smaller than two regardless of the shape of the distribution. */
+    static inline void guide(vector<int>& gv, const Array& Pv, int numGuides)
+    {
+        gv.resize(numGuides);
+        for (int k = 0; k != numGuides; ++k) gv[k] = locateClip(Pv, static_cast<double>(k) / numGuides);
+    }
+
+    /** This function returns the same result as the locateClip() function for the specified
+        normalized cumulative distribution \f$P_i\f$ and query value \f$0\le x\le 1\f$, using the
+        specified guide table constructed by the guide() function to avoid the binary search. The
+        guide table entry corresponding to the query value provides a lower limit for the result,
+        which is then incremented until the query value falls inside the bin. The function
+        protects against round-off errors in the calculation of the guide table index, so that
+        the result is always identical to that of the locateClip() function. */
+    static inline int locateGuided(const Array& Pv, const vector<int>& gv, double x)
+    {
+        int n = Pv.size();
+        int m = gv.size();
+        int i = gv[max(0, min(static_cast<int>(x * m), m - 1))];
+        while (i > 0 && x < Pv[i]) --i;
+        while (i < n - 2 && Pv[i + 1] <= x) ++i;
+        return i;
+    }
+
     //======================== Constructing grids =======================
 
 public:
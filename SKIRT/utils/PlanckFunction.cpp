@@ -28,6 +28,22 @@ double PlanckFunction::value(double lambda) const
 
 ////////////////////////////////////////////////////////////////////
 
+double PlanckFunction::front(double lambda)
+{
+    double h = Constants::h();
+    double c = Constants::c();
+    return 2.0 * h * c * c / pow(lambda, 5);
+}
+
+////////////////////////////////////////////////////////////////////
+
+double PlanckFunction::value(double lambda, double front) const
+{
+    return front / (exp(_f1 / lambda) - 1.0);
+}
+
+////////////////////////////////////////////////////////////////////
+
 double PlanckFunction::cdf(Array& lambdav, Array& pv, Array& Pv, Range lambdaRange) const
 {
     // build an appropriate grid
@@ -31,6 +31,20 @@ public:
         \f$T\f$ specified in the constructor. It is equivalent to the value() function. */
     double operator()(double lambda) const { return value(lambda); }
 
+    /** This function returns the temperature-independent front factor \f$2hc^2/\lambda^5\f$ of
+        the Planck function for a given wavelength \f$\lambda\f$. A client that evaluates the
+        Planck function for many temperatures on the same wavelength grid can precalculate these
+        front factors and pass them to the value() function with two arguments, avoiding the
+        relatively expensive power function evaluation. */
+    static double front(double lambda);
+
+    /** This function returns the value of the Planck function \f$B_\lambda(\lambda,T)\f$ for a
+        given wavelength \f$\lambda\f$ and for the temperature \f$T\f$ specified in the
+        constructor, given the front factor for this wavelength as returned by the front()
+        function. The result is identical to the value returned by the value() function with a
+        single argument. */
+    double value(double lambda, double front) const;
+
     /** This function constructs a tabulated normalized probability density function (pdf) and the
         corresponding normalized cumulative distribution function (cdf) for the Planck function
         with temperature \f$T\f$ (specified in the constructor) within the given wavelength range.
@@ -0,0 +1,80 @@
+/*//////////////////////////////////////////////////////////////////
+////     The SKIRT project -- advanced radiative transfer       ////
+////       © Astronomical Observatory, Ghent University         ////
+///////////////////////////////////////////////////////////////// */
+
+#ifndef WAVELENGTHINDEXCACHE_HPP
+#define WAVELENGTHINDEXCACHE_HPP
+
+#include "NR.hpp"
+#include <atomic>
+
+////////////////////////////////////////////////////////////////////
+
+/** An instance of the WavelengthIndexCache class converts a wavelength to the index of the
+    corresponding bin in a wavelength grid, remembering the most recent result for each execution
+    thread. It is intended for use by material mixes that tabulate their properties on a private
+    wavelength grid, because these mixes are queried many times in a row for the same wavelength.
+    For example, the wavelength of a photon packet does not change while it traverses the various
+    media along its path, nor between consecutive scattering events if there is no kinematics, and
+    each peel-off towards an instrument queries the same properties again. As long as the
+    wavelength remains the same, the binary search on the wavelength grid can thus be omitted.
+
+    The results are stored in a small thread-local table shared by all cache instances. Each cache
+    instance receives a unique identifier when it is initialized, which serves as the key into
+    this table, so that results cannot be confused between different grids even if these grids
+    happen to occupy the same memory location at different times. Caches with consecutive
+    identifiers occupy different slots in the table, so that a photon packet traversing up to 16
+    different material mixes in turn does not cause any cache conflicts.
+
+    The client must call the initialize() function, specifying the wavelength grid, before calling
+    the index() function. The grid must remain alive and unchanged as long as the cache is used. */
+class WavelengthIndexCache
+{
+public:
+    /** This function initializes the cache for the specified wavelength grid, which is passed to
+        the NR::locateClip() function to perform the actual look-up. Any previously cached results
+        for this cache instance are invalidated. */
+    void initialize(const Array& lambdav)
+    {
+        static std::atomic<size_t> lastId{0};
+        _lambdav = &lambdav;
+        _id = ++lastId;
+    }
+
+    /** This function returns the index of the bin in the wavelength grid that contains the
+        specified wavelength, as determined by the NR::locateClip() function. The result is
+        retrieved from a thread-local table if the previous call for this cache instance in the
+        current thread specified the same wavelength. */
+    int index(double lambda) const
+    {
+        thread_local Entry entries[numEntries];
+        Entry& entry = entries[_id & (numEntries - 1)];
+        if (entry.id != _id || entry.lambda != lambda)
+        {
+            entry.id = _id;
+            entry.lambda = lambda;
+            entry.index = NR::locateClip(*_lambdav, lambda);
+        }
+        return entry.index;
+    }
+
+private:
+    // an entry in the thread-local table of cached results
+    struct Entry
+    {
+        size_t id{0};       // the identifier of the cache instance that produced the result, or zero if empty
+        double lambda{0.};  // the wavelength
+        int index{0};       // the corresponding index
+    };
+
+    // the number of entries in the thread-local table; must be a power of two
+    static constexpr size_t numEntries = 16;
+
+    const Array* _lambdav{nullptr};  // the wavelength grid
+    size_t _id{0};                   // the unique identifier for this cache instance, or zero if uninitialized
+};
+
+////////////////////////////////////////////////////////////////////
+
+#endif
@@ -98,6 +98,14 @@ namespace
 
     // Dictionary keeping track of all currently acquired file memory maps: <canonical_path, map_record>
     std::unordered_map<string, MapRecord> _maps;
+
+    // Options for creating new memory maps, configured through setMemoryMapOptions()
+    bool _mapPrefetch = false;
+    bool _mapPopulate = false;
+    bool _mapHugePages = false;
+
+    // Minimum length of a memory map for requesting transparent huge pages
+    constexpr size_t hugePageThreshold = 64 << 20;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -436,12 +444,26 @@ std::ifstream System::ifstream(string path)
 
 ////////////////////////////////////////////////////////////////////
 
-std::ofstream System::ofstream(string path, bool append)
+std::ofstream System::ofstream(string path, bool append, bool binary)
+{
+    auto mode = append ? std::ios_base::app : std::ios_base::out;
+    if (binary) mode |= std::ios_base::binary;
+#ifdef _WIN64
+    return std::ofstream(toUTF16(path).get(), mode);
+#else
+    return std::ofstream(path, mode);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////
+
+std::fstream System::fstream(string path)
 {
+    auto mode = std::ios_base::in | std::ios_base::out | std::ios_base::binary;
 #ifdef _WIN64
-    return std::ofstream(toUTF16(path).get(), append ? std::ios_base::app : std::ios_base::out);
+    return std::fstream(toUTF16(path).get(), mode);
 #else
-    return std::ofstream(path, append ? std::ios_base::app : std::ios_base::out);
+    return std::fstream(path, mode);
 #endif
 }
 
@@ -505,6 +527,17 @@ void System::removeFile(string path)
 
 ////////////////////////////////////////////////////////////////////
 
+bool System::renameFile(string from, string to)
+{
+#ifdef _WIN64
+    return MoveFileExW(toUTF16(from).get(), toUTF16(to).get(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////
+
 namespace
 {
     // This function returns the names for all regular files or directories residing in the given directory
@@ -664,9 +697,23 @@ std::pair<void*, size_t> System::acquireMemoryMap(string path)
 
             if (record.length)
             {
-                // create the mapping
-                auto start = mmap(0, record.length, PROT_READ, MAP_PRIVATE, record.filehandle, 0);
-                if (start != MAP_FAILED) record.start = start;
+                // create the mapping, reading the complete file contents if so requested
+                int flags = MAP_PRIVATE;
+#    ifdef MAP_POPULATE
+                if (_mapPopulate) flags |= MAP_POPULATE;
+#    endif
+                auto start = mmap(0, record.length, PROT_READ, flags, record.filehandle, 0);
+                if (start != MAP_FAILED)
+                {
+                    record.start = start;
+
+                    // pass any requested hints to the operating system; failures are harmless and thus ignored
+#    ifdef MADV_HUGEPAGE
+                    if (_mapHugePages && record.length >= hugePageThreshold)
+                        madvise(start, record.length, MADV_HUGEPAGE);
+#    endif
+                    if (_mapPrefetch) posix_madvise(start, record.length, POSIX_MADV_WILLNEED);
+                }
             }
 
             // if map acquisition failed, close the file
@@ -724,6 +771,52 @@ void System::releaseMemoryMap(string path)
 
 ////////////////////////////////////////////////////////////////////
 
+void System::setMemoryMapOptions(bool prefetch, bool populate, bool hugePages)
+{
+    std::unique_lock<std::mutex> lock(_mapMutex);
+    _mapPrefetch = prefetch;
+    _mapPopulate = populate;
+    _mapHugePages = hugePages;
+}
+
+////////////////////////////////////////////////////////////////////
+
+System::MemoryMapStatistics System::memoryMapStatistics(string path)
+{
+    MemoryMapStatistics statistics;
+
+    // use the canonical path as a unique identifier for the file
+    path = canonicalPath(path);
+
+    std::unique_lock<std::mutex> lock(_mapMutex);
+    if (_maps.count(path))
+    {
+        const MapRecord& record = _maps.at(path);
+        statistics.length = record.length;
+
+#ifndef _WIN64
+        // determine which pages of the map are resident in memory
+        size_t pageSize = sysconf(_SC_PAGESIZE);
+        size_t numPages = (record.length + pageSize - 1) / pageSize;
+#    if defined(__APPLE__) && defined(__MACH__)
+        vector<char> residency(numPages);
+#    else
+        vector<unsigned char> residency(numPages);
+#    endif
+        if (mincore(record.start, record.length, residency.data()) == 0)
+        {
+            size_t numResident = 0;
+            for (auto flags : residency)
+                if (flags & 1) numResident++;
+            statistics.residentLength = min(numResident * pageSize, record.length);
+        }
+#endif
+    }
+    return statistics;
+}
+
+////////////////////////////////////////////////////////////////////
+
 vector<string> System::stacktrace()
 {
     vector<string> result;
@@ -979,6 +1072,20 @@ namespace
 #endif
     }
 
+    /**
+     * Returns the number of major (requiring I/O) and minor (not requiring I/O) page faults
+     * incurred so far by the current process, or zeros if these numbers can't be determined.
+     */
+    std::pair<size_t, size_t> getPageFaults()
+    {
+#if defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
+        struct rusage rusage;
+        if (getrusage(RUSAGE_SELF, &rusage) == 0)
+            return std::make_pair(static_cast<size_t>(rusage.ru_majflt), static_cast<size_t>(rusage.ru_minflt));
+#endif
+        return std::make_pair(static_cast<size_t>(0), static_cast<size_t>(0));
+    }
+
 }  // end anonymous namespace
 
 ////////////////////////////////////////////////////////////////////
@@ -1003,3 +1110,10 @@ size_t System::currentMemoryUsage()
 }
 
 ////////////////////////////////////////////////////////////////////
+
+std::pair<size_t, size_t> System::pageFaults()
+{
+    return getPageFaults();
+}
+
+////////////////////////////////////////////////////////////////////
@@ -108,9 +108,17 @@ public:
 
     /** This function returns an output file stream opened on the specified file path. If a file
         already exists at the specified path, by default it is overwritten. However, if the \em
-        append flag is specified and is true, new output will be appended to the existing file. On
-        Windows the function replaces forward slashes in the file path by backward slashes. */
-    static std::ofstream ofstream(string path, bool append = false);
+        append flag is specified and is true, new output will be appended to the existing file. If
+        the \em binary flag is specified and is true, the file is opened in binary mode, i.e.
+        without any end-of-line translation. On Windows the function replaces forward slashes in the
+        file path by backward slashes. */
+    static std::ofstream ofstream(string path, bool append = false, bool binary = false);
+
+    /** This function returns a binary file stream opened for both input and output on the
+        existing file at the specified path, without truncating the file. This allows the caller to
+        overwrite parts of the file at arbitrary positions. On Windows the function replaces forward
+        slashes in the file path by backward slashes. */
+    static std::fstream fstream(string path);
 
     /** This function returns true if the specified path refers to an existing regular file. On
         Windows the function replaces forward slashes in the path by backward slashes. */
@@ -133,6 +141,13 @@ public:
         by backward slashes. */
     static void removeFile(string path);
 
+    /** This function renames the file with the specified path \em from to the specified path \em
+        to, replacing any existing file with the latter path. The paths should be on the same file
+        system so that the operation is atomic. The function returns true if successful, and false
+        otherwise. On Windows the function replaces forward slashes in the paths by backward
+        slashes. */
+    static bool renameFile(string from, string to);
+
     /** This function returns the names for all regular files residing in the given directory,
         specified as an absolute or relative path without trailing slash, or the empty string for
         the current directory. On Windows the function replaces forward slashes in the path by
@@ -179,6 +194,47 @@ public:
         operations is needed to actually release the memory map. */
     static void releaseMemoryMap(string path);
 
+    /** This function configures the way in which memory maps are created by subsequent calls to
+        the acquireMemoryMap() function. Each of the flags enables a feature that may reduce the
+        time threads spend waiting for page faults when accessing large files that reside on a slow
+        (e.g., parallel or networked) file system:
+
+        - \em prefetch: immediately after creating a memory map, advise the operating system that
+          the complete file will be needed soon. The operating system starts reading the file
+          contents asynchronously, so that the caller can continue its setup in the meantime.
+
+        - \em populate: read the complete file contents into memory while creating the memory
+          map, so that subsequent accesses never cause a page fault requiring file system access.
+          This obviously delays the acquireMemoryMap() function.
+
+        - \em hugePages: for memory maps larger than 64 MiB, request the operating system to use
+          transparent huge pages, reducing the number of page faults and the pressure on the
+          translation lookaside buffer.
+
+        By default, all features are disabled. The features are supported only on Linux and
+        (partially) on other Unix systems; elsewhere the flags are silently ignored. In any case,
+        the memory maps remain read-only and the behavior of client code is not affected. */
+    static void setMemoryMapOptions(bool prefetch, bool populate, bool hugePages);
+
+    /** This structure holds statistics for a memory map, as returned by the memoryMapStatistics()
+        function. */
+    struct MemoryMapStatistics
+    {
+        size_t length{0};          // the length of the memory map in bytes
+        size_t residentLength{0};  // the number of bytes currently resident in physical memory
+    };
+
+    /** This function returns statistics for the currently acquired memory map on the specified
+        file. These statistics include the length of the memory map and the portion of the memory
+        map currently resident in physical memory. Statistics that cannot be determined on the
+        current platform are set to zero. If there is no memory map for the specified file, all
+        statistics are set to zero.
+
+        Most page faults for a memory map occur when its contents are first accessed rather than
+        while it is being created, so the cost of accessing mapped files is best measured over a
+        complete processing phase using the pageFaults() function. */
+    static MemoryMapStatistics memoryMapStatistics(string path);
+
     // ================== Debugging ==================
 
     /** This function returns a list of lines representing a stack trace to the current execution
@@ -198,6 +254,13 @@ public:
     /** Returns the current physical memory use for the current process in bytes, or zero if the
         value cannot be determined. */
     static size_t currentMemoryUsage();
+
+    /** Returns the number of major page faults (requiring I/O) and minor page faults (not
+        requiring I/O) incurred so far by all threads of the current process, in that order, or
+        zeros if these numbers cannot be determined. The difference between two calls measures the
+        page faults incurred in between, including those caused by first accesses to memory-mapped
+        files. */
+    static std::pair<size_t, size_t> pageFaults();
 };
 
 ////////////////////////////////////////////////////////////////////